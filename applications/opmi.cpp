@@ -17,46 +17,197 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/MessageContainer.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/ParseProfile.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/Utility/ThreadPool.hpp>
 
 
-inline void dumpMessages( const Opm::MessageContainer& messageContainer) {
+/*
+ * Count the allocations for --profile. The count is a thread local increment,
+ * which is nothing next to the allocation itself.
+ */
+void* operator new( std::size_t size ) {
+    Opm::ParseProfile::countAllocation();
+    if( void* ptr = std::malloc( size ? size : 1 ) ) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete( void* ptr ) noexcept {
+    std::free( ptr );
+}
+
+
+inline void dumpMessages( const Opm::MessageContainer& messageContainer, std::ostream& out ) {
     auto extractMessage = [](const Opm::Message& msg) {
         const auto& location = msg.location;
         if (location)
-            return location.filename + ":" + std::to_string( location.lineno ) + " " + msg.message;
+            return location.filename.string() + ":" + std::to_string( location.lineno ) + " " + msg.message;
         else
             return msg.message;
     };
 
 
     for(const auto& msg : messageContainer)
-        std::cout << extractMessage(msg) << std::endl;
+        out << extractMessage(msg) << std::endl;
+}
+
+
+inline void dumpProfile( const Opm::ParseProfile& profile, std::ostream& out ) {
+    const size_t top = 10;
+
+    out << std::fixed << std::setprecision( 3 )
+        << "Parsed in " << profile.getTotalSeconds() << "s, of which "
+        << profile.getReadSeconds() << "s reading input and "
+        << profile.getUnitSeconds() << "s applying units" << std::endl;
+
+    auto dumpEntries = [&out]( const std::string& title,
+                               const std::vector< Opm::ParseProfile::Entry >& entries ) {
+        out << std::endl << title << std::endl
+            << std::setw( 9 ) << "total"
+            << std::setw( 9 ) << "parse"
+            << std::setw( 9 ) << "records"
+            << std::setw( 9 ) << "units"
+            << std::setw( 9 ) << "read"
+            << std::setw( 10 ) << "keywords"
+            << std::setw( 10 ) << "records"
+            << std::setw( 12 ) << "items"
+            << std::setw( 12 ) << "bytes"
+            << std::setw( 12 ) << "allocs"
+            << "  name" << std::endl;
+
+        for( const auto& entry : entries )
+            out << std::setw( 9 ) << entry.totalSeconds()
+                << std::setw( 9 ) << entry.seconds
+                << std::setw( 9 ) << entry.recordSeconds
+                << std::setw( 9 ) << entry.unitSeconds
+                << std::setw( 9 ) << entry.readSeconds
+                << std::setw( 10 ) << entry.keywords
+                << std::setw( 10 ) << entry.records
+                << std::setw( 12 ) << entry.items
+                << std::setw( 12 ) << entry.bytes
+                << std::setw( 12 ) << entry.allocations
+                << "  " << entry.name << std::endl;
+    };
+
+    dumpEntries( "Slowest keywords (seconds):", profile.topKeywords( top ) );
+    dumpEntries( "Slowest files (seconds):", profile.topFiles( top ) );
 }
 
 
-inline void loadDeck( const char * deck_file) {
+inline void loadDeck( const Opm::Parser& parser, const char * deck_file, std::ostream& out ) {
     Opm::ParseContext parseContext;
-    Opm::Parser parser;
 
-    std::cout << "Loading deck: " << deck_file << " ..... "; std::cout.flush();
+    out << "Loading deck: " << deck_file << " ..... "; out.flush();
     auto deck = parser.parseFile(deck_file, parseContext);
-    std::cout << "parse complete - creating EclipseState .... ";  std::cout.flush();
+    out << "parse complete - creating EclipseState .... ";  out.flush();
     Opm::EclipseState state( deck, parseContext );
-    std::cout << "complete." << std::endl;
+    out << "complete." << std::endl;
+
+    dumpMessages( deck.getMessageContainer(), out );
 
-    dumpMessages( deck.getMessageContainer() );
+    if (deck.getParseProfile())
+        dumpProfile( *deck.getParseProfile(), out );
 }
 
 
-int main(int argc, char** argv) {
-    for (int iarg = 1; iarg < argc; iarg++)
-        loadDeck( argv[iarg] );
+/*
+ * Load the decks on jobs threads, all with the same parser. The output of a
+ * deck is buffered, and written in the order of the decks.
+ */
+inline int loadDecks( const Opm::Parser& parser, const std::vector< const char* >& deck_files, size_t jobs ) {
+    /* the calling thread loads decks too while it waits for the output */
+    Opm::ThreadPool pool( jobs - 1 );
+    std::vector< std::future< std::string > > outputs;
+
+    for (const auto* deck_file : deck_files) {
+        outputs.push_back( pool.submit( [&parser, deck_file] {
+            std::ostringstream out;
+            try {
+                loadDeck( parser, deck_file, out );
+            } catch (const std::exception& e) {
+                out << "failed: " << e.what() << std::endl;
+                throw std::runtime_error( out.str() );
+            }
+            return out.str();
+        } ) );
+    }
+
+    int status = EXIT_SUCCESS;
+    for (auto& output : outputs) {
+        pool.wait( output );
+        try {
+            std::cout << output.get();
+        } catch (const std::exception& e) {
+            std::cout << e.what();
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
+
+
+inline int usage( const char* prog ) {
+    std::cerr << "usage: " << prog << " [--profile] [-j jobs] deck_file..." << std::endl
+              << "  -j jobs     load the decks on this many threads (a positive number)" << std::endl;
+    return EXIT_FAILURE;
+}
+
+/* the job count of -j, or 0 if it is not a positive number */
+inline size_t parseJobs( const char* arg ) {
+    char* end = nullptr;
+    const auto jobs = std::strtoul( arg, &end, 10 );
+    if (end == arg || *end != '\0' || arg[0] == '-')
+        return 0;
+
+    return jobs;
 }
 
+int main(int argc, char** argv) {
+    bool profile = false;
+    size_t jobs = 0;
+    std::vector< const char* > deck_files;
+
+    for (int iarg = 1; iarg < argc; iarg++) {
+        if (std::strcmp( argv[iarg], "--profile" ) == 0)
+            profile = true;
+        else if (std::strcmp( argv[iarg], "-j" ) == 0) {
+            if (iarg + 1 == argc) {
+                std::cerr << "-j needs a job count" << std::endl;
+                return usage( argv[0] );
+            }
+
+            jobs = parseJobs( argv[++iarg] );
+            if (jobs == 0) {
+                std::cerr << "Invalid job count for -j: '" << argv[iarg] << "'" << std::endl;
+                return usage( argv[0] );
+            }
+        }
+        else
+            deck_files.push_back( argv[iarg] );
+    }
+
+    /* the parser is expensive to build, and is shared by all the decks */
+    Opm::Parser parser;
+    parser.setProfiling( profile );
+
+    if (jobs > 1)
+        return loadDecks( parser, deck_files, jobs );
+
+    for (const auto* deck_file : deck_files)
+        loadDeck( parser, deck_file, std::cout );
+}
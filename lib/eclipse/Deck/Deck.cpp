@@ -27,33 +27,49 @@
 
 namespace Opm {
 
-    bool DeckView::hasKeyword( const DeckKeyword& keyword ) const {
-        auto key = this->keywordMap.find( keyword.name() );
+namespace {
+
+    bool isSectionDelimiter( const std::string& name ) {
+        for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
+                               "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } )
+            if( name == x ) return true;
+
+        return false;
+    }
 
-        if( key == this->keywordMap.end() ) return false;
+}
+
+    bool DeckView::hasKeyword( const DeckKeyword& keyword ) const {
+        const auto range = this->offsets( keyword.name() );
 
-        for( auto index : key->second )
-            if( &this->getKeyword( index ) == &keyword ) return true;
+        for( auto itr = range.first; itr != range.second; ++itr )
+            if( &this->getKeyword( *itr - this->offset ) == &keyword ) return true;
 
         return false;
     }
 
     bool DeckView::hasKeyword( const std::string& keyword ) const {
-        return this->keywordMap.find( keyword ) != this->keywordMap.end();
+        const auto range = this->offsets( keyword );
+        return range.first != range.second;
     }
 
     const DeckKeyword& DeckView::getKeyword( const std::string& keyword, size_t index ) const {
-        if( !this->hasKeyword( keyword ) )
+        const auto range = this->offsets( keyword );
+        if( range.first == range.second )
             throw std::invalid_argument("Keyword " + keyword + " not in deck.");
 
-        return this->getKeyword( this->offsets( keyword ).at( index ) );
+        if( index >= size_t( range.second - range.first ) )
+            throw std::out_of_range("Keyword " + keyword + " index " + std::to_string( index ) + " is out of range.");
+
+        return this->getKeyword( range.first[ index ] - this->offset );
     }
 
     const DeckKeyword& DeckView::getKeyword( const std::string& keyword ) const {
-        if( !this->hasKeyword( keyword ) )
+        const auto range = this->offsets( keyword );
+        if( range.first == range.second )
             throw std::invalid_argument("Keyword " + keyword + " not in deck.");
 
-        return this->getKeyword( this->offsets( keyword ).back() );
+        return this->getKeyword( *( range.second - 1 ) - this->offset );
     }
 
     const DeckKeyword& DeckView::getKeyword( size_t index ) const {
@@ -64,21 +80,18 @@ namespace Opm {
     }
 
     size_t DeckView::count( const std::string& keyword ) const {
-        if( !this->hasKeyword( keyword ) ) return 0;
-
-        return this->offsets( keyword ).size();
+        const auto range = this->offsets( keyword );
+        return range.second - range.first;
    }
 
     const std::vector< const DeckKeyword* > DeckView::getKeywordList( const std::string& keyword ) const {
-        if( !hasKeyword( keyword ) ) return {};
-
-        const auto& indices = this->offsets( keyword );
+        const auto range = this->offsets( keyword );
 
         std::vector< const DeckKeyword* > ret;
-        ret.reserve( indices.size() );
+        ret.reserve( range.second - range.first );
 
-        for( size_t i : indices )
-            ret.push_back( &this->getKeyword( i ) );
+        for( auto itr = range.first; itr != range.second; ++itr )
+            ret.push_back( &this->getKeyword( *itr - this->offset ) );
 
         return ret;
     }
@@ -95,30 +108,89 @@ namespace Opm {
         return this->last;
     }
 
+    /*
+     * Keywords are only added to a whole deck, so the position of the
+     * keyword in the view is its position in the deck.
+     */
     void DeckView::add( const DeckKeyword* kw, const_iterator f, const_iterator l ) {
-        this->keywordMap[ kw->name() ].push_back( std::distance( f, l ) - 1 );
+        const size_t position = std::distance( f, l ) - 1;
+
+        /* a deck that was moved from starts over */
+        if( !this->keywords ) this->keywords = std::make_shared< keyword_index >();
+
+        this->keywords->positions[ kw->name() ].push_back( position );
+        if( isSectionDelimiter( kw->name() ) )
+            this->keywords->sections.push_back( position );
+
         this->first = f;
         this->last = l;
     }
 
-    static const std::vector< size_t > empty_indices = {};
-    const std::vector< size_t >& DeckView::offsets( const std::string& keyword ) const {
-        if( !hasKeyword( keyword ) ) return empty_indices;
+    void DeckView::reset( const_iterator first_arg, const_iterator last_arg ) {
+        this->first = first_arg;
+        this->last = first_arg;
+        this->keywords = std::make_shared< keyword_index >();
+        this->offset = 0;
 
-        return this->keywordMap.find( keyword )->second;
+        for( auto itr = first_arg; itr != last_arg; ++itr )
+            this->add( &*itr, first_arg, itr + 1 );
     }
 
-    DeckView::DeckView( const_iterator first_arg, const_iterator last_arg ) :
-        first( first_arg ), last( last_arg )
-    {
-        size_t index = 0;
-        for( const auto& kw : *this )
-            this->keywordMap[ kw.name() ].push_back( index++ );
+    /*
+     * The positions of a keyword are sorted, so the ones in this view are the
+     * ones in [offset, offset + size).
+     */
+    DeckView::index_range DeckView::offsets( const std::string& keyword ) const {
+        if( !this->keywords ) return { nullptr, nullptr };
+
+        const auto& positions = this->keywords->positions;
+        const auto key = positions.find( keyword );
+
+        if( key == positions.end() ) return { nullptr, nullptr };
+
+        const auto* fst = key->second.data();
+        const auto* lst = fst + key->second.size();
+
+        if( this->offset == 0 && key->second.back() < this->size() )
+            return { fst, lst };
+
+        return { std::lower_bound( fst, lst, this->offset ),
+                 std::lower_bound( fst, lst, this->offset + this->size() ) };
     }
 
-    DeckView::DeckView( std::pair< const_iterator, const_iterator > limits ) :
-        DeckView( limits.first, limits.second )
-    {}
+    DeckView::DeckView( const_iterator first_arg, const_iterator last_arg ) {
+        this->reset( first_arg, last_arg );
+    }
+
+    /*
+     * The section runs to the next section keyword, which is looked up in the
+     * index rather than searched for.
+     */
+    DeckView::DeckView( const DeckView& parent, const std::string& section ) :
+        first( parent.last ),
+        last( parent.last ),
+        keywords( parent.keywords ),
+        offset( parent.offset + parent.size() )
+    {
+        const auto starts = parent.offsets( section );
+        if( starts.first == starts.second ) return;
+
+        const auto& sections = this->keywords->sections;
+        const size_t start = *starts.first;
+        size_t stop = parent.offset + parent.size();
+
+        const auto next = std::upper_bound( sections.begin(), sections.end(), start );
+        if( next != sections.end() && *next < stop ) {
+            stop = *next;
+
+            if( parent.getKeyword( stop - parent.offset ).name() == section )
+                throw std::invalid_argument( std::string( "Deck contains the '" ) + section + "' section multiple times" );
+        }
+
+        this->first = parent.first + ( start - parent.offset );
+        this->last = parent.first + ( stop - parent.offset );
+        this->offset = start;
+    }
 
     Deck::Deck() : Deck( std::vector< DeckKeyword >() ) {}
 
@@ -150,6 +222,27 @@ namespace Opm {
         Deck( std::vector< DeckKeyword >( ilist.begin(), ilist.end() ) )
     {}
 
+    /*
+     * The copy gets an index of its own, as keywords added to it must not show
+     * up in the original.
+     */
+    Deck::Deck( const Deck& other ) :
+        DeckView( other ),
+        keywordList( other.keywordList ),
+        m_messageContainer( other.m_messageContainer ),
+        defaultUnits( other.defaultUnits ),
+        activeUnits( other.activeUnits ),
+        m_dataFile( other.m_dataFile ),
+        profile( other.profile )
+    {
+        this->reset( this->keywordList.begin(), this->keywordList.end() );
+    }
+
+    Deck& Deck::operator=( const Deck& other ) {
+        Deck copy( other );
+        return *this = std::move( copy );
+    }
+
     void Deck::addKeyword( DeckKeyword&& keyword ) {
         this->keywordList.push_back( std::move( keyword ) );
 
@@ -197,6 +290,14 @@ namespace Opm {
         m_dataFile = dataFile;
     }
 
+    const ParseProfile* Deck::getParseProfile() const {
+        return this->profile.get();
+    }
+
+    void Deck::setParseProfile( std::shared_ptr< const ParseProfile > p ) {
+        this->profile = std::move( p );
+    }
+
     Deck::iterator Deck::begin() {
         return this->keywordList.begin();
     }
@@ -22,19 +22,195 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <set>
 #include <stdexcept>
+#include <tuple>
 
 namespace Opm {
 
+namespace {
+
+/*
+ * Computing the lazy values of an item is rare and quick, so a small pool of
+ * locks, picked by the address of the item, is shared by all items rather
+ * than giving every item a mutex of its own.
+ */
+std::mutex& lock_of( const void* item ) {
+    static std::mutex locks[ 32 ];
+    return locks[ ( reinterpret_cast< std::uintptr_t >( item ) / 64 ) % 32 ];
+}
+
+/*
+ * The dimensions are few and shared by many items, so the items refer to
+ * interned copies, which live for as long as the process. The scaling of a
+ * context dependent dimension is NaN, which is not compared.
+ */
+const Dimension* intern( const Dimension& dim ) {
+    struct less {
+        static std::tuple< const std::string&, bool, double, double > key( const Dimension& d ) {
+            const bool context = d.isContextDependent();
+            return std::tuple< const std::string&, bool, double, double >(
+                    d.getName(), context, context ? 0.0 : d.getSIScaling(), d.getSIOffset() );
+        }
+
+        bool operator()( const Dimension& lhs, const Dimension& rhs ) const {
+            return key( lhs ) < key( rhs );
+        }
+    };
+
+    static std::mutex mutex;
+    static std::set< Dimension, less > dimensions;
+
+    std::lock_guard< std::mutex > lock( mutex );
+    return &*dimensions.insert( dim ).first;
+}
+
+}
+
+DeckItem::DeckItem() {
+    this->construct_values( type_tag::unknown );
+}
+
+DeckItem::DeckItem( const DeckItem& other ) :
+    type( other.type ),
+    dummy_default( other.dummy_default ),
+    si_stored( other.si_stored ),
+    item_name( other.item_name ),
+    runs( other.runs ),
+    dimensions( other.dimensions )
+{
+    switch( this->type ) {
+        case type_tag::fdouble:
+            new (&this->dval) value_list< double >( other.dval );
+            break;
+        case type_tag::string:
+            new (&this->sval) value_list< std::string >( other.sval );
+            break;
+        default:
+            new (&this->ival) value_list< int >( other.ival );
+            break;
+    }
+}
+
+DeckItem::DeckItem( DeckItem&& other ) noexcept :
+    type( other.type ),
+    dummy_default( other.dummy_default ),
+    si_stored( other.si_stored ),
+    item_name( other.item_name ),
+    runs( std::move( other.runs ) ),
+    dimensions( std::move( other.dimensions ) ),
+    lazy( other.lazy.exchange( nullptr ) )
+{
+    switch( this->type ) {
+        case type_tag::fdouble:
+            new (&this->dval) value_list< double >( std::move( other.dval ) );
+            break;
+        case type_tag::string:
+            new (&this->sval) value_list< std::string >( std::move( other.sval ) );
+            break;
+        default:
+            new (&this->ival) value_list< int >( std::move( other.ival ) );
+            break;
+    }
+}
+
+DeckItem& DeckItem::operator=( const DeckItem& other ) {
+    if( this == &other ) return *this;
+
+    DeckItem copy( other );
+    return *this = std::move( copy );
+}
+
+DeckItem& DeckItem::operator=( DeckItem&& other ) noexcept {
+    if( this == &other ) return *this;
+
+    this->destroy_values();
+    this->reset_lazy();
+
+    this->type = other.type;
+    this->dummy_default = other.dummy_default;
+    this->si_stored = other.si_stored;
+    this->item_name = other.item_name;
+    this->runs = std::move( other.runs );
+    this->dimensions = std::move( other.dimensions );
+    this->lazy = other.lazy.exchange( nullptr );
+
+    switch( this->type ) {
+        case type_tag::fdouble:
+            new (&this->dval) value_list< double >( std::move( other.dval ) );
+            break;
+        case type_tag::string:
+            new (&this->sval) value_list< std::string >( std::move( other.sval ) );
+            break;
+        default:
+            new (&this->ival) value_list< int >( std::move( other.ival ) );
+            break;
+    }
+
+    return *this;
+}
+
+DeckItem::~DeckItem() {
+    this->destroy_values();
+    this->reset_lazy();
+}
+
+void DeckItem::construct_values( type_tag tag ) {
+    this->type = tag;
+    switch( tag ) {
+        case type_tag::fdouble:
+            new (&this->dval) value_list< double >();
+            break;
+        case type_tag::string:
+            new (&this->sval) value_list< std::string >();
+            break;
+        default:
+            new (&this->ival) value_list< int >();
+            break;
+    }
+}
+
+void DeckItem::destroy_values() {
+    switch( this->type ) {
+        case type_tag::fdouble:
+            this->dval.~value_list< double >();
+            break;
+        case type_tag::string:
+            this->sval.~value_list< std::string >();
+            break;
+        default:
+            this->ival.~value_list< int >();
+            break;
+    }
+}
+
+/* the block of lazy values, which is allocated if needed. Call with the lock */
+DeckItem::lazy_values& DeckItem::lazy_block() const {
+    auto* block = this->lazy.load( std::memory_order_relaxed );
+    if( block ) return *block;
+
+    block = new lazy_values();
+    this->lazy.store( block, std::memory_order_release );
+    return *block;
+}
+
+void DeckItem::reset_lazy() {
+    delete this->lazy.exchange( nullptr );
+}
+
 template< typename T >
-std::vector< T >& DeckItem::value_ref() {
-    return const_cast< std::vector< T >& >(
+DeckItem::value_list< T >& DeckItem::value_ref() {
+    return const_cast< value_list< T >& >(
             const_cast< const DeckItem& >( *this ).value_ref< T >()
          );
 }
 
 template<>
-const std::vector< int >& DeckItem::value_ref< int >() const {
+const DeckItem::value_list< int >& DeckItem::value_ref< int >() const {
     if( this->type != get_type< int >() )
         throw std::invalid_argument( "Item of wrong type." );
 
@@ -42,7 +218,7 @@ const std::vector< int >& DeckItem::value_ref< int >() const {
 }
 
 template<>
-const std::vector< double >& DeckItem::value_ref< double >() const {
+const DeckItem::value_list< double >& DeckItem::value_ref< double >() const {
     if( this->type != get_type< double >() )
         throw std::invalid_argument( "Item of wrong type." );
 
@@ -50,81 +226,199 @@ const std::vector< double >& DeckItem::value_ref< double >() const {
 }
 
 template<>
-const std::vector< std::string >& DeckItem::value_ref< std::string >() const {
+const DeckItem::value_list< std::string >& DeckItem::value_ref< std::string >() const {
     if( this->type != get_type< std::string >() )
         throw std::invalid_argument( "Item of wrong type." );
 
     return this->sval;
 }
 
-DeckItem::DeckItem( const std::string& nm ) : item_name( nm ) {}
+template< typename T >
+const DeckItem::value_list< T >& DeckItem::raw_ref() const {
+    return this->value_ref< T >();
+}
+
+/*
+ * An item stored in SI converts its run values back to raw the first time
+ * they are asked for. A repeated run is only ever under a single dimension,
+ * see convertToSI, so the dimension of a stored value is the one of the
+ * index it is first used at.
+ */
+template<>
+const DeckItem::value_list< double >& DeckItem::raw_ref< double >() const {
+    const auto& val = this->value_ref< double >();
+    if( !this->si_stored ) return val;
+
+    const auto* cached = this->lazy.load( std::memory_order_acquire );
+    if( cached && cached->raw_done.load( std::memory_order_acquire ) ) return cached->raw;
+
+    std::lock_guard< std::mutex > lock( lock_of( this ) );
+    auto& block = this->lazy_block();
+    if( !block.raw_done.load( std::memory_order_relaxed ) ) {
+        const auto& dims = this->dimensions;
+        std::vector< double > raw( val.size() );
+
+        for( const auto& r : this->runs ) {
+            const auto stored = r.repeated ? 1 : r.end - r.begin;
+            for( size_t i = 0; i < stored; ++i ) {
+                const auto* dim = dims[ ( r.begin + i ) % dims.size() ];
+                raw[ r.offset + i ] = dim->convertSiToRaw( val[ r.offset + i ] );
+            }
+        }
+
+        block.raw.assign( std::move( raw ) );
+        block.raw_done.store( true, std::memory_order_release );
+    }
+
+    return block.raw;
+}
+
+DeckItem::DeckItem( InternedString nm ) : item_name( nm ) {
+    this->construct_values( type_tag::unknown );
+}
 
-DeckItem::DeckItem( const std::string& nm, int, size_t hint ) :
-    type( get_type< int >() ),
+DeckItem::DeckItem( InternedString nm, int, size_t hint ) :
     item_name( nm )
 {
+    this->construct_values( get_type< int >() );
     this->ival.reserve( hint );
-    this->defaulted.reserve( hint );
 }
 
-DeckItem::DeckItem( const std::string& nm, double, size_t hint ) :
-    type( get_type< double >() ),
+DeckItem::DeckItem( InternedString nm, double, size_t hint ) :
     item_name( nm )
 {
+    this->construct_values( get_type< double >() );
     this->dval.reserve( hint );
-    this->defaulted.reserve( hint );
 }
 
-DeckItem::DeckItem( const std::string& nm, std::string, size_t hint ) :
-    type( get_type< std::string >() ),
+DeckItem::DeckItem( InternedString nm, std::string, size_t hint ) :
     item_name( nm )
 {
+    this->construct_values( get_type< std::string >() );
     this->sval.reserve( hint );
-    this->defaulted.reserve( hint );
 }
 
 const std::string& DeckItem::name() const {
     return this->item_name;
 }
 
+const DeckItem::run& DeckItem::find_run( size_t index ) const {
+    if( index >= this->size() )
+        throw std::out_of_range( "Index " + std::to_string( index )
+                               + " out of range for item '"
+                               + this->name() + "'" );
+
+    /* the first run that starts after index, the one before holds it */
+    auto next = std::upper_bound( this->runs.begin(), this->runs.end(), index,
+            []( size_t i, const run& r ) { return i < r.begin; } );
+
+    return *std::prev( next );
+}
+
 bool DeckItem::defaultApplied( size_t index ) const {
-    return this->defaulted.at( index );
+    if( this->runs.empty() && this->dummy_default && index == 0 )
+        return true;
+
+    return this->find_run( index ).defaulted;
 }
 
 bool DeckItem::hasValue( size_t index ) const {
-    switch( this->type ) {
-        case type_tag::integer: return this->ival.size() > index;
-        case type_tag::fdouble: return this->dval.size() > index;
-        case type_tag::string:  return this->sval.size() > index;
-        default: throw std::logic_error( "Type not set." );
-    }
+    return index < this->size();
 }
 
 size_t DeckItem::size() const {
-    switch( this->type ) {
-        case type_tag::integer: return this->ival.size();
-        case type_tag::fdouble: return this->dval.size();
-        case type_tag::string:  return this->sval.size();
-        default: throw std::logic_error( "Type not set." );
-    }
+    if( this->type == type_tag::unknown )
+        throw std::logic_error( "Type not set." );
+
+    return this->runs.empty() ? 0 : this->runs.back().end;
 }
 
 template< typename T >
 const T& DeckItem::get( size_t index ) const {
-    return this->value_ref< T >().at( index );
+    const auto& val = this->raw_ref< T >();
+    const auto& r = this->find_run( index );
+    return val[ r.offset + ( r.repeated ? 0 : index - r.begin ) ];
 }
 
 template< typename T >
 const std::vector< T >& DeckItem::getData() const {
-    return this->value_ref< T >();
+    const auto& val = this->raw_ref< T >();
+
+    /* no repeated runs, and the values are already in a vector */
+    if( val.size() == this->size() && val.heap() ) return *val.heap();
+
+    /*
+     * Like the SI values, the dense values are an unobservable state change
+     * and are expanded only once
+     */
+    const auto* cached = this->lazy.load( std::memory_order_acquire );
+    if( cached && cached->dense_done.load( std::memory_order_acquire ) )
+        return *std::static_pointer_cast< std::vector< T > >( cached->dense );
+
+    std::lock_guard< std::mutex > lock( lock_of( this ) );
+    auto& block = this->lazy_block();
+    if( !block.dense_done.load( std::memory_order_relaxed ) ) {
+        auto data = std::make_shared< std::vector< T > >();
+        data->reserve( this->size() );
+
+        for( const auto& r : this->runs ) {
+            if( r.repeated )
+                data->insert( data->end(), r.end - r.begin, val[ r.offset ] );
+            else
+                data->insert( data->end(), val.begin() + r.offset,
+                                           val.begin() + r.offset + (r.end - r.begin) );
+        }
+
+        block.dense = data;
+        block.dense_done.store( true, std::memory_order_release );
+    }
+
+    return *std::static_pointer_cast< std::vector< T > >( block.dense );
+}
+
+const DeckItem::run_list& DeckItem::getRuns() const {
+    return this->runs;
+}
+
+template< typename T >
+const DeckItem::value_list< T >& DeckItem::getRunValues() const {
+    return this->raw_ref< T >();
+}
+
+template< typename T >
+const T& DeckItem::getRunValue( const run& r, size_t index ) const {
+    return this->raw_ref< T >()[ r.offset + ( r.repeated ? 0 : index ) ];
+}
+
+void DeckItem::push_run( size_t count, size_t offset, bool repeated, bool defaulted ) {
+    if( count == 0 ) return;
+    if( count == 1 ) repeated = false;
+
+    if( this->si_stored )
+        throw std::logic_error( "Can not add values to item '" + this->name()
+                              + "', which is converted to SI" );
+
+    this->reset_lazy();
+
+    if( !repeated && !this->runs.empty() ) {
+        auto& last = this->runs.back();
+        if( !last.repeated && last.defaulted == defaulted
+            && last.offset + (last.end - last.begin) == offset ) {
+            last.end += count;
+            return;
+        }
+    }
+
+    const auto begin = this->size();
+    this->runs.push_back( { begin, begin + count, offset, repeated, defaulted } );
 }
 
 template< typename T >
 void DeckItem::push( T x ) {
     auto& val = this->value_ref< T >();
 
+    this->push_run( 1, val.size(), false, false );
     val.push_back( std::move( x ) );
-    this->defaulted.push_back( false );
 }
 
 void DeckItem::push_back( int x ) {
@@ -142,9 +436,10 @@ void DeckItem::push_back( std::string x ) {
 template< typename T >
 void DeckItem::push( T x, size_t n ) {
     auto& val = this->value_ref< T >();
+    if( n == 0 ) return;
 
-    val.insert( val.end(), n, x );
-    this->defaulted.insert( this->defaulted.end(), n, false );
+    this->push_run( n, val.size(), true, false );
+    val.push_back( std::move( x ) );
 }
 
 void DeckItem::push_back( int x, size_t n ) {
@@ -160,80 +455,356 @@ void DeckItem::push_back( std::string x, size_t n ) {
 }
 
 template< typename T >
-void DeckItem::push_default( T x ) {
+void DeckItem::push( std::vector< T >&& xs ) {
+    auto& val = this->value_ref< T >();
+
+    this->push_run( xs.size(), val.size(), false, false );
+
+    if( val.empty() )
+        val.assign( std::move( xs ) );
+    else
+        val.append( xs.begin(), xs.end() );
+}
+
+void DeckItem::push_back( std::vector< int >&& xs ) {
+    this->push( std::move( xs ) );
+}
+
+void DeckItem::push_back( std::vector< double >&& xs ) {
+    this->push( std::move( xs ) );
+}
+
+template< typename T >
+void DeckItem::push( std::vector< T >&& xs, std::vector< bool >&& defs ) {
     auto& val = this->value_ref< T >();
-    if( this->defaulted.size() != val.size() )
+
+    if( xs.size() != defs.size() )
+        throw std::logic_error( "Values and defaulted flags must be of equal size" );
+
+    if( this->dummy_default )
         throw std::logic_error("To add a value to an item, "
                 "no 'pseudo defaults' can be added before");
 
+    const auto base = val.size();
+    size_t first = 0;
+    for( size_t i = 1; i <= defs.size(); ++i ) {
+        if( i < defs.size() && defs[ i ] == defs[ first ] ) continue;
+        this->push_run( i - first, base + first, false, defs[ first ] );
+        first = i;
+    }
+
+    if( val.empty() ) {
+        val.assign( std::move( xs ) );
+        return;
+    }
+
+    val.append( std::make_move_iterator( xs.begin() ),
+                std::make_move_iterator( xs.end() ) );
+}
+
+void DeckItem::push_back( std::vector< int >&& xs, std::vector< bool >&& defs ) {
+    this->push( std::move( xs ), std::move( defs ) );
+}
+
+void DeckItem::push_back( std::vector< double >&& xs, std::vector< bool >&& defs ) {
+    this->push( std::move( xs ), std::move( defs ) );
+}
+
+void DeckItem::push_back( std::vector< std::string >&& xs, std::vector< bool >&& defs ) {
+    this->push( std::move( xs ), std::move( defs ) );
+}
+
+template< typename T >
+void DeckItem::push( std::vector< T >&& xs, std::vector< run >&& rs ) {
+    auto& val = this->value_ref< T >();
+
+    if( this->dummy_default )
+        throw std::logic_error("To add a value to an item, "
+                "no 'pseudo defaults' can be added before");
+
+    const auto base = val.size();
+    for( const auto& r : rs ) {
+        const auto stored = r.repeated ? 1 : r.end - r.begin;
+        if( r.end < r.begin || r.offset + stored > xs.size() )
+            throw std::logic_error( "Run out of range of its values" );
+
+        this->push_run( r.end - r.begin, base + r.offset, r.repeated, r.defaulted );
+    }
+
+    if( val.empty() ) {
+        val.assign( std::move( xs ) );
+        return;
+    }
+
+    val.append( std::make_move_iterator( xs.begin() ),
+                std::make_move_iterator( xs.end() ) );
+}
+
+void DeckItem::push_back( std::vector< int >&& xs, std::vector< run >&& rs ) {
+    this->push( std::move( xs ), std::move( rs ) );
+}
+
+void DeckItem::push_back( std::vector< double >&& xs, std::vector< run >&& rs ) {
+    this->push( std::move( xs ), std::move( rs ) );
+}
+
+void DeckItem::push_back( std::vector< std::string >&& xs, std::vector< run >&& rs ) {
+    this->push( std::move( xs ), std::move( rs ) );
+}
+
+template< typename T >
+void DeckItem::push_default( T x, size_t n ) {
+    auto& val = this->value_ref< T >();
+    if( this->dummy_default )
+        throw std::logic_error("To add a value to an item, "
+                "no 'pseudo defaults' can be added before");
+
+    if( n == 0 ) return;
+
+    this->push_run( n, val.size(), true, true );
     val.push_back( std::move( x ) );
-    this->defaulted.push_back( true );
 }
 
 void DeckItem::push_backDefault( int x ) {
-    this->push_default( x );
+    this->push_default( x, 1 );
 }
 
 void DeckItem::push_backDefault( double x ) {
-    this->push_default( x );
+    this->push_default( x, 1 );
 }
 
 void DeckItem::push_backDefault( std::string x ) {
-    this->push_default( std::move( x ) );
+    this->push_default( std::move( x ), 1 );
+}
+
+void DeckItem::push_backDefault( int x, size_t n ) {
+    this->push_default( x, n );
+}
+
+void DeckItem::push_backDefault( double x, size_t n ) {
+    this->push_default( x, n );
+}
+
+void DeckItem::push_backDefault( std::string x, size_t n ) {
+    this->push_default( std::move( x ), n );
 }
 
 
 void DeckItem::push_backDummyDefault() {
-    if( !this->defaulted.empty() )
+    if( !this->runs.empty() || this->dummy_default )
         throw std::logic_error("Pseudo defaults can only be specified for empty items");
 
-    this->defaulted.push_back( true );
+    this->dummy_default = true;
 }
 
 std::string DeckItem::getTrimmedString( size_t index ) const {
-    return boost::algorithm::trim_copy(
-               this->value_ref< std::string >().at( index )
-           );
+    return boost::algorithm::trim_copy( this->get< std::string >( index ) );
 }
 
 double DeckItem::getSIDouble( size_t index ) const {
-    return this->getSIDoubleData().at( index );
+    const auto& val = this->value_ref< double >();
+
+    if( this->dimensions.empty() )
+        throw std::invalid_argument("No dimension has been set for item'"
+                                    + this->name()
+                                    + "'; can not ask for SI data");
+
+    const auto& r = this->find_run( index );
+    const auto x = val[ r.offset + ( r.repeated ? 0 : index - r.begin ) ];
+    if( this->si_stored ) return x;
+
+    return this->dimensions[ index % this->dimensions.size() ]->convertRawToSi( x );
 }
 
-const std::vector< double >& DeckItem::getSIDoubleData() const {
+namespace {
+
+/*
+ * Write the values of the runs to out, through convert. Literal runs without
+ * an index are tight loops over contiguous memory, which is where the bulk of
+ * grid data ends up.
+ */
+template< typename Out, typename In, typename Convert >
+void write_runs( const DeckItem::run_list& runs,
+                 const DeckItem::value_list< In >& values,
+                 Out* out,
+                 const size_t* index,
+                 bool with_defaults,
+                 Convert convert ) {
+
+    for( const auto& r : runs ) {
+        if( r.defaulted && !with_defaults ) continue;
+
+        const auto* src = values.data() + r.offset;
+
+        if( !index && !r.repeated ) {
+            for( size_t i = r.begin; i < r.end; ++i )
+                out[ i ] = convert( src[ i - r.begin ], i );
+        }
+        else if( !index ) {
+            for( size_t i = r.begin; i < r.end; ++i )
+                out[ i ] = convert( *src, i );
+        }
+        else {
+            for( size_t i = r.begin; i < r.end; ++i )
+                out[ index[ i ] ] = convert( src[ r.repeated ? 0 : i - r.begin ], i );
+        }
+    }
+}
+
+}
+
+template< typename T >
+void DeckItem::write_si( T* out, const size_t* index, bool with_defaults ) const {
     const auto& raw = this->value_ref< double >();
-    // we already converted this item to SI?
-    if( !this->SIdata.empty() ) return this->SIdata;
 
     if( this->dimensions.empty() )
         throw std::invalid_argument("No dimension has been set for item'"
                                     + this->name()
                                     + "'; can not ask for SI data");
 
+    if( this->si_stored ) {
+        write_runs( this->runs, raw, out, index, with_defaults,
+                    []( double x, size_t ) { return T( x ); } );
+        return;
+    }
+
+    const auto& dims = this->dimensions;
+    if( dims.size() > 1 ) {
+        write_runs( this->runs, raw, out, index, with_defaults,
+                    [&dims]( double x, size_t i ) {
+                        return T( dims[ i % dims.size() ]->convertRawToSi( x ) );
+                    } );
+        return;
+    }
+
     /*
-     * This is an unobservable state change - SIData is lazily converted to
-     * SI units, so externally the object still behaves as const
+     * With a single dimension the factor is looked up once. A context
+     * dependent unit is only an error if there is a value to convert.
      */
-    const auto dim_size = dimensions.size();
-    const auto sz = raw.size();
-    this->SIdata.resize( sz );
-
-    for( size_t index = 0; index < sz; index++ ) {
-        const auto dimIndex = index % dim_size;
-        this->SIdata[ index ] = this->dimensions[ dimIndex ]
-                                .convertRawToSi( raw[ index ] );
+    const auto given = []( const run& r ) { return !r.defaulted; };
+    if( this->runs.empty() ) return;
+    if( !with_defaults && std::none_of( this->runs.begin(), this->runs.end(), given ) )
+        return;
+
+    const auto factor = dims[ 0 ]->getSIScaling();
+    const auto offset = dims[ 0 ]->getSIOffset();
+    write_runs( this->runs, raw, out, index, with_defaults,
+                [factor, offset]( double x, size_t ) {
+                    return T( x * factor + offset );
+                } );
+}
+
+const std::vector< double >& DeckItem::getSIDoubleData() const {
+    /* the stored values are already in SI, and dense */
+    if( this->si_stored && this->dval.size() == this->size() && this->dval.heap() )
+        return *this->dval.heap();
+
+    // we already converted this item to SI?
+    const auto* cached = this->lazy.load( std::memory_order_acquire );
+    if( cached && cached->si_done.load( std::memory_order_acquire ) ) return cached->si;
+
+    /*
+     * This is an unobservable state change - the SI data is lazily converted
+     * to SI units, so externally the object still behaves as const
+     */
+    std::lock_guard< std::mutex > lock( lock_of( this ) );
+    auto& block = this->lazy_block();
+    if( !block.si_done.load( std::memory_order_relaxed ) ) {
+        std::vector< double > data( this->size() );
+        this->write_si( data.data(), nullptr, true );
+        block.si = std::move( data );
+        block.si_done.store( true, std::memory_order_release );
     }
 
-    return this->SIdata;
+    return block.si;
+}
+
+void DeckItem::writeData( int* out, const size_t* index ) const {
+    write_runs( this->runs, this->value_ref< int >(), out, index, false,
+                []( int x, size_t ) { return x; } );
+}
+
+void DeckItem::writeSIData( double* out, const size_t* index ) const {
+    this->write_si( out, index, false );
+}
+
+void DeckItem::writeSIData( float* out, const size_t* index ) const {
+    this->write_si( out, index, false );
 }
 
 void DeckItem::push_backDimension( const Dimension& active,
                                     const Dimension& def ) {
-    const auto& ds = this->value_ref< double >();
-    const bool dim_inactive = ds.empty()
-                            || this->defaultApplied( ds.size() - 1 );
+    this->value_ref< double >();
+    if( this->si_stored )
+        throw std::logic_error( "Can not add dimensions to item '" + this->name()
+                              + "', which is converted to SI" );
+
+    const auto sz = this->size();
+    const bool dim_inactive = sz == 0
+                            || this->defaultApplied( sz - 1 );
+
+    this->dimensions.push_back( intern( dim_inactive ? def : active ) );
+}
+
+const DeckItem::dimension_list& DeckItem::getDimensions() const {
+    return this->dimensions;
+}
+
+void DeckItem::convertToSI() {
+    auto& val = this->value_ref< double >();
+    if( this->si_stored ) return;
+
+    if( this->dimensions.empty() )
+        throw std::invalid_argument("No dimension has been set for item'"
+                                    + this->name()
+                                    + "'; can not convert to SI");
 
-    this->dimensions.push_back( dim_inactive ? def : active );
+    const auto& dims = this->dimensions;
+    if( std::any_of( dims.begin(), dims.end(),
+                     []( const Dimension* dim ) { return dim->isContextDependent(); } ) )
+        return;
+
+    /*
+     * With several dimensions, the values of a repeated run may be under
+     * different dimensions, so the runs are expanded.
+     */
+    const auto repeated = []( const run& r ) { return r.repeated; };
+    if( dims.size() > 1 && std::any_of( this->runs.begin(), this->runs.end(), repeated ) ) {
+        std::vector< double > expanded;
+        expanded.reserve( this->size() );
+
+        for( auto& r : this->runs ) {
+            const auto offset = expanded.size();
+            if( r.repeated )
+                expanded.insert( expanded.end(), r.end - r.begin, val[ r.offset ] );
+            else
+                expanded.insert( expanded.end(), val.begin() + r.offset,
+                                                 val.begin() + r.offset + (r.end - r.begin) );
+
+            r.offset = offset;
+            r.repeated = false;
+        }
+
+        val.assign( std::move( expanded ) );
+    }
+
+    for( const auto& r : this->runs ) {
+        const auto stored = r.repeated ? 1 : r.end - r.begin;
+        for( size_t i = 0; i < stored; ++i )
+            val[ r.offset + i ] = dims[ ( r.begin + i ) % dims.size() ]
+                                  ->convertRawToSi( val[ r.offset + i ] );
+    }
+
+    this->reset_lazy();
+    this->si_stored = true;
+}
+
+bool DeckItem::storesSI() const {
+    return this->si_stored;
+}
+
+bool DeckItem::isDummyDefault() const {
+    return this->dummy_default;
 }
 
 type_tag DeckItem::getType() const {
@@ -253,4 +824,12 @@ template const std::vector< int >& DeckItem::getData< int >() const;
 template const std::vector< double >& DeckItem::getData< double >() const;
 template const std::vector< std::string >& DeckItem::getData< std::string >() const;
 
+template const DeckItem::value_list< int >& DeckItem::getRunValues< int >() const;
+template const DeckItem::value_list< double >& DeckItem::getRunValues< double >() const;
+template const DeckItem::value_list< std::string >& DeckItem::getRunValues< std::string >() const;
+
+template const int& DeckItem::getRunValue< int >( const run&, size_t ) const;
+template const double& DeckItem::getRunValue< double >( const run&, size_t ) const;
+template const std::string& DeckItem::getRunValue< std::string >( const run&, size_t ) const;
+
 }
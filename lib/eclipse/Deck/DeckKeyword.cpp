@@ -23,19 +23,69 @@
 
 namespace Opm {
 
-    DeckKeyword::DeckKeyword(const std::string& keywordName) :
+    DeckKeyword::DeckKeyword(InternedString keywordName) :
         m_keywordName(keywordName), m_lineNumber(-1),
         m_knownKeyword(true), m_isDataKeyword(false)
     {
     }
 
-    DeckKeyword::DeckKeyword(const std::string& keywordName, bool knownKeyword) :
+    DeckKeyword::DeckKeyword(InternedString keywordName, bool knownKeyword) :
         m_keywordName(keywordName), m_lineNumber(-1),
         m_knownKeyword(knownKeyword), m_isDataKeyword(false)
     {
     }
 
-    void DeckKeyword::setLocation(const std::string& fileName, int lineNumber) {
+    DeckKeyword::DeckKeyword(InternedString keywordName, std::shared_ptr< const Source > source) :
+        m_keywordName(keywordName), m_lineNumber(-1),
+        m_knownKeyword(true), m_isDataKeyword(false),
+        m_source(std::move(source))
+    {
+        this->m_lazy.once.reset( new std::once_flag );
+        this->m_lazy.done = false;
+    }
+
+    /*
+     * A once_flag can't be copied or reset, so a copy that still needs to be
+     * parsed gets a flag of its own.
+     */
+    DeckKeyword::lazy_state::lazy_state( const lazy_state& other ) :
+        done( other.done.load() )
+    {
+        if( !this->done ) this->once.reset( new std::once_flag );
+    }
+
+    DeckKeyword::lazy_state::lazy_state( lazy_state&& other ) noexcept :
+        once( std::move( other.once ) ),
+        done( other.done.load() )
+    {}
+
+    DeckKeyword::lazy_state& DeckKeyword::lazy_state::operator=( const lazy_state& other ) {
+        this->done = other.done.load();
+        this->once.reset( this->done ? nullptr : new std::once_flag );
+        return *this;
+    }
+
+    DeckKeyword::lazy_state& DeckKeyword::lazy_state::operator=( lazy_state&& other ) noexcept {
+        this->done = other.done.load();
+        this->once = std::move( other.once );
+        return *this;
+    }
+
+    void DeckKeyword::materialize() const {
+        if( this->m_lazy.done.load( std::memory_order_acquire ) ) return;
+
+        std::call_once( *this->m_lazy.once, [this] {
+            auto keyword = this->m_source->parse();
+            this->m_recordList = std::move( keyword.m_recordList );
+            this->m_lazy.done.store( true, std::memory_order_release );
+        } );
+    }
+
+    bool DeckKeyword::isLazy() const {
+        return !this->m_lazy.done.load( std::memory_order_acquire );
+    }
+
+    void DeckKeyword::setLocation(InternedString fileName, int lineNumber) {
         m_fileName = fileName;
         m_lineNumber = lineNumber;
     }
@@ -62,6 +112,7 @@ namespace Opm {
     }
 
     size_t DeckKeyword::size() const {
+        if( this->isLazy() ) return this->m_source->size();
         return m_recordList.size();
     }
 
@@ -70,26 +121,32 @@ namespace Opm {
     }
 
     void DeckKeyword::addRecord(DeckRecord&& record) {
+        this->materialize();
         this->m_recordList.push_back( std::move( record ) );
     }
 
     DeckKeyword::const_iterator DeckKeyword::begin() const {
+        this->materialize();
         return m_recordList.begin();
     }
 
     DeckKeyword::const_iterator DeckKeyword::end() const {
+        this->materialize();
         return m_recordList.end();
     }
 
     const DeckRecord& DeckKeyword::getRecord(size_t index) const {
+        this->materialize();
         return this->m_recordList.at( index );
     }
 
     DeckRecord& DeckKeyword::getRecord(size_t index) {
+        this->materialize();
         return this->m_recordList.at( index );
     }
 
     const DeckRecord& DeckKeyword::getDataRecord() const {
+        this->materialize();
         if (m_recordList.size() == 1)
             return getRecord(0);
         else
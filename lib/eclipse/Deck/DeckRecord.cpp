@@ -114,6 +114,24 @@ namespace Opm {
             throw std::range_error("Not a data keyword ?");
     }
 
+    DeckItem& DeckRecord::getInternedItem( const InternedString& name, size_t index ) {
+        const auto& item = static_cast< const DeckRecord& >( *this ).getInternedItem( name, index );
+        return const_cast< DeckItem& >( item );
+    }
+
+    const DeckItem& DeckRecord::findInternedItem( const InternedString& name ) const {
+        const auto eq = [&name]( const DeckItem& e ) {
+            return &e.name() == &name.string();
+        };
+
+        auto item = std::find_if( this->begin(), this->end(), eq );
+
+        if( item == m_items.end() )
+            throw std::invalid_argument("Item: " + name.string() + " does not exist.");
+
+        return *item;
+    }
+
     bool DeckRecord::hasItem(const std::string& name) const {
         const auto eq = [&name]( const DeckItem& e ) {
             return e.name() == name;
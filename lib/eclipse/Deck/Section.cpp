@@ -32,37 +32,8 @@
 
 namespace Opm {
 
-    static bool isSectionDelimiter( const DeckKeyword& keyword ) {
-        const auto& name = keyword.name();
-        for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
-                               "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } )
-            if( name == x ) return true;
-
-        return false;
-    }
-
-    static std::pair< DeckView::const_iterator, DeckView::const_iterator >
-    find_section( const Deck& deck, const std::string& keyword ) {
-
-        const auto fn = [&keyword]( const DeckKeyword& kw ) {
-            return kw.name() == keyword;
-        };
-
-        auto first = std::find_if( deck.begin(), deck.end(), fn );
-
-        if( first == deck.end() )
-            return { first, first };
-
-        auto last = std::find_if( first + 1, deck.end(), isSectionDelimiter );
-
-        if( last != deck.end() && last->name() == keyword )
-            throw std::invalid_argument( std::string( "Deck contains the '" ) + keyword + "' section multiple times" );
-
-        return { first, last };
-    }
-
     Section::Section( const Deck& deck, const std::string& section )
-        : DeckView( find_section( deck, section ) ),
+        : DeckView( deck, section ),
           section_name( section ),
           units( deck.getActiveUnitSystem() )
     {}
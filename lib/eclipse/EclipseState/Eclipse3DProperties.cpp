@@ -431,6 +431,9 @@ namespace Opm {
           m_doubleGridProperties(eclipseGrid, &m_deckUnitSystem,
                                  makeSupportedDoubleKeywords(&tableManager, &eclipseGrid, &m_intGridProperties))
     {
+        /* the post processors of PORV and ACTNUM look up each other */
+        m_intGridProperties.m_mutex = m_doubleGridProperties.m_mutex;
+
         /*
          * The EQUALREG, MULTREG, COPYREG, ... keywords are used to manipulate
          * vectors based on region values; for instance the statement
@@ -520,18 +523,14 @@ namespace Opm {
 
 
     const GridProperty<int>& Eclipse3DProperties::getIntGridProperty( const std::string& keyword ) const {
-        auto& gridProperty = const_cast< Eclipse3DProperties* >( this )->m_intGridProperties.getKeyword( keyword );
-        gridProperty.runPostProcessor();
-        return gridProperty;
+        return m_intGridProperties.getKeyword( keyword );
     }
 
 
 
     /// gets property from doubleGridProperty --- and calls the runPostProcessor
     const GridProperty<double>& Eclipse3DProperties::getDoubleGridProperty( const std::string& keyword ) const {
-        auto& gridProperty = const_cast< Eclipse3DProperties* >( this )->m_doubleGridProperties.getKeyword( keyword );
-        gridProperty.runPostProcessor();
-        return gridProperty;
+        return m_doubleGridProperties.getKeyword( keyword );
     }
 
     const GridProperties<int>& Eclipse3DProperties::getIntProperties() const {
@@ -21,6 +21,7 @@
 #include <cmath>
 
 #include <iostream>
+#include <limits>
 #include <tuple>
 #include <functional>
 
@@ -446,6 +447,15 @@ namespace Opm {
     {
         const std::vector<float> zcorn_float( zcorn.begin() , zcorn.end() );
         const std::vector<float> coord_float( coord.begin() , coord.end() );
+        initCornerPointGrid( dims, coord_float, zcorn_float, actnum, mapaxes );
+    }
+
+    void EclipseGrid::initCornerPointGrid(const std::array<int,3>& dims ,
+                                          const std::vector<float>& coord_float ,
+                                          const std::vector<float>& zcorn_float ,
+                                          const int * actnum,
+                                          const double * mapaxes)
+    {
         float * mapaxes_float = nullptr;
         if (mapaxes) {
             mapaxes_float = new float[6];
@@ -469,10 +479,17 @@ namespace Opm {
     void EclipseGrid::initCornerPointGrid(const std::array<int,3>& dims, const Deck& deck) {
         assertCornerPointKeywords( dims , deck);
         {
-            const auto& ZCORNKeyWord = deck.getKeyword<ParserKeywords::ZCORN>();
-            const auto& COORDKeyWord = deck.getKeyword<ParserKeywords::COORD>();
-            const std::vector<double>& zcorn = ZCORNKeyWord.getSIDoubleData();
-            const std::vector<double>& coord = COORDKeyWord.getSIDoubleData();
+            /*
+              ZCORN and COORD are converted from the deck straight to the
+              single precision ecl_grid wants; defaulted values stay NaN as
+              they would be in the SI data.
+            */
+            const auto& ZCORNItem = deck.getKeyword<ParserKeywords::ZCORN>().getDataRecord().getDataItem();
+            const auto& COORDItem = deck.getKeyword<ParserKeywords::COORD>().getDataRecord().getDataItem();
+            std::vector<float> zcorn( ZCORNItem.size() , std::numeric_limits<float>::quiet_NaN() );
+            std::vector<float> coord( COORDItem.size() , std::numeric_limits<float>::quiet_NaN() );
+            ZCORNItem.writeSIData( zcorn.data() );
+            COORDItem.writeSIData( coord.data() );
             double * mapaxes = nullptr;
 
             if (deck.hasKeyword<ParserKeywords::MAPAXES>()) {
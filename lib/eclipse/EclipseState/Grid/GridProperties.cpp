@@ -21,6 +21,11 @@
 
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/A.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/C.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/E.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/M.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/O.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
 
 namespace Opm {
@@ -112,15 +117,12 @@ namespace Opm {
 
 
 
-    void setKeywordBox( const DeckRecord& deckRecord,
-                        BoxManager& boxManager) {
-        const auto& I1Item = deckRecord.getItem("I1");
-        const auto& I2Item = deckRecord.getItem("I2");
-        const auto& J1Item = deckRecord.getItem("J1");
-        const auto& J2Item = deckRecord.getItem("J2");
-        const auto& K1Item = deckRecord.getItem("K1");
-        const auto& K2Item = deckRecord.getItem("K2");
+    namespace {
 
+    void setBox( const DeckItem& I1Item, const DeckItem& I2Item,
+                 const DeckItem& J1Item, const DeckItem& J2Item,
+                 const DeckItem& K1Item, const DeckItem& K2Item,
+                 BoxManager& boxManager ) {
         size_t setCount = 0;
 
         if (!I1Item.defaultApplied(0))
@@ -155,6 +157,28 @@ namespace Opm {
         }
     }
 
+    /* the box of a record of a known keyword, with the items looked up by index */
+    template< typename Keyword >
+    void setRecordBox( const DeckRecord& record, BoxManager& boxManager ) {
+        setBox( record.getItem< typename Keyword::I1 >(),
+                record.getItem< typename Keyword::I2 >(),
+                record.getItem< typename Keyword::J1 >(),
+                record.getItem< typename Keyword::J2 >(),
+                record.getItem< typename Keyword::K1 >(),
+                record.getItem< typename Keyword::K2 >(),
+                boxManager );
+    }
+
+    }
+
+    void setKeywordBox( const DeckRecord& deckRecord,
+                        BoxManager& boxManager) {
+        setBox( deckRecord.getItem("I1"), deckRecord.getItem("I2"),
+                deckRecord.getItem("J1"), deckRecord.getItem("J2"),
+                deckRecord.getItem("K1"), deckRecord.getItem("K2"),
+                boxManager );
+    }
+
     template< typename T >
     const MessageContainer& GridProperties<T>::getMessageContainer() const {
         return m_messages;
@@ -167,12 +191,14 @@ namespace Opm {
 
     template< typename T >
     bool GridProperties<T>::supportsKeyword(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *m_mutex );
         const std::string kw = normalize(keyword);
         return m_supportedKeywords.count( kw ) > 0 || isFipxxx<T>(kw);
     }
 
     template< typename T >
     bool GridProperties<T>::hasKeyword(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *m_mutex );
         const std::string kw = normalize( keyword );
 
         const auto cnt = m_properties.count( kw );
@@ -183,6 +209,7 @@ namespace Opm {
 
     template< typename T >
     bool GridProperties<T>::hasDeckKeyword(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *m_mutex );
         const std::string kw = normalize( keyword );
 
         const auto cnt = m_properties.count( kw );
@@ -195,12 +222,14 @@ namespace Opm {
 
     template< typename T >
     size_t GridProperties<T>::size() const {
+        std::lock_guard< std::recursive_mutex > lock( *m_mutex );
         return m_properties.size();
     }
 
 
     template< typename T >
     void GridProperties<T>::assertKeyword(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *m_mutex );
         const std::string kw = normalize(keyword);
         if (m_properties.count( kw ) == 0)
             addAutoGeneratedKeyword_(kw);
@@ -212,14 +241,16 @@ namespace Opm {
 
     template< typename T >
     const GridProperty<T>& GridProperties<T>::getKeyword(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *m_mutex );
         assertKeyword( keyword );
-        return m_properties.at( keyword );
+        return m_properties.at( normalize( keyword ) );
     }
 
 
 
     template< typename T >
     const GridProperty<T>& GridProperties<T>::getDeckKeyword(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *m_mutex );
         const std::string kw = normalize(keyword);
 
         if (hasDeckKeyword(kw))
@@ -299,12 +330,12 @@ namespace Opm {
 
     template< typename T >
     void GridProperties<T>::handleADDRecord( const DeckRecord& record, BoxManager& boxManager) {
-        const std::string& field = record.getItem("field").get< std::string >(0);
+        const std::string& field = record.getItem<ParserKeywords::ADD::field>().get< std::string >(0);
 
         if (hasKeyword( field )) {
             GridProperty<T>& property = getKeyword( field );
-            T shiftValue  = convertInputValue( property , record.getItem("shift").get< double >(0) );
-            setKeywordBox(record, boxManager);
+            T shiftValue  = convertInputValue( property , record.getItem<ParserKeywords::ADD::shift>().get< double >(0) );
+            setRecordBox< ParserKeywords::ADD >(record, boxManager);
             property.add( shiftValue , boxManager.getActiveBox() );
         } else
             throw std::invalid_argument("Fatal error processing ADD keyword. Tried to shift not defined keyword " + field);
@@ -312,12 +343,12 @@ namespace Opm {
 
     template< typename T >
     void GridProperties<T>::handleMULTIPLYRecord( const DeckRecord& record, BoxManager& boxManager) {
-        const std::string& field = record.getItem("field").get< std::string >(0);
+        const std::string& field = record.getItem<ParserKeywords::MULTIPLY::field>().get< std::string >(0);
 
         if (hasKeyword( field )) {
             GridProperty<T>& property = getKeyword( field );
-            T factor  = convertInputValue( record.getItem("factor").get< double >(0) );
-            setKeywordBox(record, boxManager);
+            T factor  = convertInputValue( record.getItem<ParserKeywords::MULTIPLY::factor>().get< double >(0) );
+            setRecordBox< ParserKeywords::MULTIPLY >(record, boxManager);
             property.scale( factor , boxManager.getActiveBox() );
         } else
             throw std::invalid_argument("Fatal error processing ADD keyword. Tried to shift not defined keyword " + field);
@@ -326,11 +357,11 @@ namespace Opm {
 
     template< typename T >
     void GridProperties<T>::handleCOPYRecord( const DeckRecord& record, BoxManager& boxManager) {
-        const std::string& srcField = record.getItem("src").get< std::string >(0);
-        const std::string& targetField = record.getItem("target").get< std::string >(0);
+        const std::string& srcField = record.getItem<ParserKeywords::COPY::src>().get< std::string >(0);
+        const std::string& targetField = record.getItem<ParserKeywords::COPY::target>().get< std::string >(0);
 
         if (hasKeyword( srcField )) {
-            setKeywordBox(record, boxManager);
+            setRecordBox< ParserKeywords::COPY >(record, boxManager);
             copyKeyword( srcField , targetField , boxManager.getActiveBox() );
         } else {
             if (!supportsKeyword( srcField))
@@ -341,14 +372,14 @@ namespace Opm {
 
     template< typename T >
     void GridProperties<T>::handleEQUALSRecord( const DeckRecord& record, BoxManager& boxManager) {
-        const std::string& field = record.getItem("field").get< std::string >(0);
-        double      value  = record.getItem("value").get< double >(0);
+        const std::string& field = record.getItem<ParserKeywords::EQUALS::field>().get< std::string >(0);
+        double      value  = record.getItem<ParserKeywords::EQUALS::value>().get< double >(0);
 
         if (supportsKeyword( field )) {
             GridProperty<T>& property = getOrCreateProperty( field );
             T targetValue = convertInputValue( property , value );
 
-            setKeywordBox(record, boxManager);
+            setRecordBox< ParserKeywords::EQUALS >(record, boxManager);
             property.setScalar( targetValue , boxManager.getActiveBox() );
         } else
             throw std::invalid_argument("Fatal error processing EQUALS keyword. Tried to set not defined keyword " + field);
@@ -357,11 +388,11 @@ namespace Opm {
 
     template< typename T >
     void GridProperties<T>::handleEQUALREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty ) {
-        const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
+        const std::string& targetArray = record.getItem<ParserKeywords::EQUALREG::ARRAY>().get< std::string >(0);
         if (supportsKeyword( targetArray )) {
             GridProperty<T>& targetProperty = getOrCreateProperty( targetArray  );
-            double inputValue = record.getItem("VALUE").get<double>(0);
-            int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
+            double inputValue = record.getItem<ParserKeywords::EQUALREG::VALUE>().get<double>(0);
+            int regionValue = record.getItem<ParserKeywords::EQUALREG::REGION_NUMBER>().get<int>(0);
             T targetValue = convertInputValue( targetProperty , inputValue );
             std::vector<bool> mask;
 
@@ -373,11 +404,11 @@ namespace Opm {
 
     template< typename T >
     void GridProperties<T>::handleADDREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty ) {
-        const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
+        const std::string& targetArray = record.getItem<ParserKeywords::ADDREG::ARRAY>().get< std::string >(0);
         if (hasKeyword( targetArray )) {
             GridProperty<T>& targetProperty = getKeyword( targetArray  );
-            double inputValue = record.getItem("SHIFT").get<double>(0);
-            int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
+            double inputValue = record.getItem<ParserKeywords::ADDREG::SHIFT>().get<double>(0);
+            int regionValue = record.getItem<ParserKeywords::ADDREG::REGION_NUMBER>().get<int>(0);
             T shiftValue = convertInputValue( targetProperty , inputValue );
             std::vector<bool> mask;
 
@@ -389,11 +420,11 @@ namespace Opm {
 
     template< typename T >
     void GridProperties<T>::handleMULTIREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty ) {
-        const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
+        const std::string& targetArray = record.getItem<ParserKeywords::MULTIREG::ARRAY>().get< std::string >(0);
         if (supportsKeyword( targetArray )) {
             GridProperty<T>& targetProperty = getOrCreateProperty( targetArray  );
-            double inputValue = record.getItem("FACTOR").get<double>(0);
-            int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
+            double inputValue = record.getItem<ParserKeywords::MULTIREG::FACTOR>().get<double>(0);
+            int regionValue = record.getItem<ParserKeywords::MULTIREG::REGION_NUMBER>().get<int>(0);
             T factor = convertInputValue( inputValue );
             std::vector<bool> mask;
 
@@ -405,8 +436,8 @@ namespace Opm {
 
     template< typename T >
     void GridProperties<T>::handleCOPYREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty ) {
-        const std::string& srcArray    = record.getItem("ARRAY").get< std::string >(0);
-        const std::string& targetArray = record.getItem("TARGET_ARRAY").get< std::string >(0);
+        const std::string& srcArray    = record.getItem<ParserKeywords::COPYREG::ARRAY>().get< std::string >(0);
+        const std::string& targetArray = record.getItem<ParserKeywords::COPYREG::TARGET_ARRAY>().get< std::string >(0);
 
         if (!supportsKeyword( targetArray))
             throw std::invalid_argument("Fatal error processing COPYREG record - invalid/undefined keyword: " + targetArray);
@@ -415,7 +446,7 @@ namespace Opm {
             throw std::invalid_argument("Fatal error processing COPYREG record - invalid/undefined keyword: " + srcArray);
 
         {
-            int regionValue = record.getItem("REGION_NUMBER").get< int >(0);
+            int regionValue = record.getItem<ParserKeywords::COPYREG::REGION_NUMBER>().get< int >(0);
             std::vector<bool> mask;
             GridProperty<T>& targetProperty = getOrCreateProperty( targetArray );
             GridProperty<T>& srcProperty = getKeyword( srcArray );
@@ -513,11 +544,11 @@ namespace Opm {
                                                                         {"ABS"    , &ABS},
                                                                         {"MULTIPLY" , &MULTIPLY}};
 
-        const std::string& srcArray    = record.getItem("ARRAY").get< std::string >(0);
-        const std::string& targetArray = record.getItem("TARGET_ARRAY").get< std::string >(0);
-        const std::string& operation   = record.getItem("OPERATION").get< std::string >(0);
-        double alpha = record.getItem("PARAM1").get< double >(0);
-        double beta = record.getItem("PARAM2").get< double >(0);
+        const std::string& srcArray    = record.getItem<ParserKeywords::OPERATE::ARRAY>().get< std::string >(0);
+        const std::string& targetArray = record.getItem<ParserKeywords::OPERATE::TARGET_ARRAY>().get< std::string >(0);
+        const std::string& operation   = record.getItem<ParserKeywords::OPERATE::OPERATION>().get< std::string >(0);
+        double alpha = record.getItem<ParserKeywords::OPERATE::PARAM1>().get< double >(0);
+        double beta = record.getItem<ParserKeywords::OPERATE::PARAM2>().get< double >(0);
 
         if (!supportsKeyword( targetArray))
             throw std::invalid_argument("Fatal error processing COPYREG record - invalid/undefined keyword: " + targetArray);
@@ -530,7 +561,7 @@ namespace Opm {
             std::vector<T>& targetData = getOrCreateProperty( targetArray ).getData();
             operate_fptr func = operations.at( operation );
 
-            setKeywordBox(record, boxManager);
+            setRecordBox< ParserKeywords::OPERATE >(record, boxManager);
             for (auto index : boxManager.getActiveBox())
                 targetData[index] = func( targetData[index] , srcData[index] , alpha, beta );
         }
@@ -566,6 +597,7 @@ namespace Opm {
     */
     template< typename T >
     bool GridProperties<T>::addAutoGeneratedKeyword_(const std::string& keywordName) const {
+        std::lock_guard< std::recursive_mutex > lock( *m_mutex );
         if (!supportsKeyword( keywordName ))
             throw std::invalid_argument("The keyword: " + keywordName + " is not supported in this container");
 
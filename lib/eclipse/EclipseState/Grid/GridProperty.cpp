@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <stdexcept>
@@ -235,11 +236,7 @@ namespace Opm {
     template< typename T >
     void GridProperty< T >::loadFromDeckKeyword( const DeckKeyword& deckKeyword ) {
         const auto& deckItem = getDeckItem(deckKeyword);
-        const auto size = deckItem.size();
-        for (size_t dataPointIdx = 0; dataPointIdx < size; ++dataPointIdx) {
-            if (!deckItem.defaultApplied(dataPointIdx))
-                setDataPoint(dataPointIdx, dataPointIdx, deckItem);
-        }
+        loadFromDeckItem(deckItem, nullptr);
     }
 
     template< typename T >
@@ -250,14 +247,7 @@ namespace Opm {
             const auto& deckItem = getDeckItem(deckKeyword);
             const std::vector<size_t>& indexList = inputBox.getIndexList();
             if (indexList.size() == deckItem.size()) {
-                for (size_t sourceIdx = 0; sourceIdx < indexList.size(); sourceIdx++) {
-                    size_t targetIdx = indexList[sourceIdx];
-                    if (sourceIdx < deckItem.size()
-                        && !deckItem.defaultApplied(sourceIdx))
-                        {
-                            setDataPoint(sourceIdx, targetIdx, deckItem);
-                        }
-                }
+                loadFromDeckItem(deckItem, indexList.data());
             } else {
                 std::string boxSize = std::to_string(static_cast<long long>(indexList.size()));
                 std::string keywordSize = std::to_string(static_cast<long long>(deckItem.size()));
@@ -370,14 +360,18 @@ namespace Opm {
         return deckItem;
     }
 
+/*
+ * The values are converted straight from the runs of the item into the
+ * property, and the cells that are defaulted in the deck keep their value.
+ */
 template<>
-void GridProperty<int>::setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem) {
-    m_data[targetIdx] = deckItem.get< int >(sourceIdx);
+void GridProperty<int>::loadFromDeckItem(const DeckItem& deckItem, const size_t* indexList) {
+    deckItem.writeData(m_data.data(), indexList);
 }
 
 template<>
-void GridProperty<double>::setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem) {
-    m_data[targetIdx] = deckItem.getSIDouble(sourceIdx);
+void GridProperty<double>::loadFromDeckItem(const DeckItem& deckItem, const size_t* indexList) {
+    deckItem.writeSIData(m_data.data(), indexList);
 }
 
 template<>
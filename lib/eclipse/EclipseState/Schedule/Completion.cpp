@@ -31,6 +31,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
 #include <opm/parser/eclipse/EclipseState/Util/Value.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/C.hpp>
 
 namespace Opm {
 
@@ -114,17 +115,17 @@ namespace Opm {
         // We change from eclipse's 1 - n, to a 0 - n-1 solution
         // I and J can be defaulted with 0 or *, in which case they are fetched
         // from the well head
-        const auto& itemI = compdatRecord.getItem( "I" );
+        const auto& itemI = compdatRecord.getItem<ParserKeywords::COMPDAT::I>();
         const auto defaulted_I = itemI.defaultApplied( 0 ) || itemI.get< int >( 0 ) == 0;
         const int I = !defaulted_I ? itemI.get< int >( 0 ) - 1 : well.getHeadI();
 
-        const auto& itemJ = compdatRecord.getItem( "J" );
+        const auto& itemJ = compdatRecord.getItem<ParserKeywords::COMPDAT::J>();
         const auto defaulted_J = itemJ.defaultApplied( 0 ) || itemJ.get< int >( 0 ) == 0;
         const int J = !defaulted_J ? itemJ.get< int >( 0 ) - 1 : well.getHeadJ();
 
-        int K1 = compdatRecord.getItem("K1").get< int >(0) - 1;
-        int K2 = compdatRecord.getItem("K2").get< int >(0) - 1;
-        WellCompletion::StateEnum state = WellCompletion::StateEnumFromString( compdatRecord.getItem("STATE").getTrimmedString(0) );
+        int K1 = compdatRecord.getItem<ParserKeywords::COMPDAT::K1>().get< int >(0) - 1;
+        int K2 = compdatRecord.getItem<ParserKeywords::COMPDAT::K2>().get< int >(0) - 1;
+        WellCompletion::StateEnum state = WellCompletion::StateEnumFromString( compdatRecord.getItem<ParserKeywords::COMPDAT::STATE>().getTrimmedString(0) );
         Value<double> connectionTransmissibilityFactor("ConnectionTransmissibilityFactor");
         Value<double> diameter("Diameter");
         Value<double> skinFactor("SkinFactor");
@@ -132,10 +133,10 @@ namespace Opm {
         const auto& satnum = eclipseProperties.getIntGridProperty("SATNUM");
         bool defaultSatTable = true;
         {
-            const auto& connectionTransmissibilityFactorItem = compdatRecord.getItem("CONNECTION_TRANSMISSIBILITY_FACTOR");
-            const auto& diameterItem = compdatRecord.getItem("DIAMETER");
-            const auto& skinFactorItem = compdatRecord.getItem("SKIN");
-            const auto& satTableIdItem = compdatRecord.getItem("SAT_TABLE");
+            const auto& connectionTransmissibilityFactorItem = compdatRecord.getItem<ParserKeywords::COMPDAT::CONNECTION_TRANSMISSIBILITY_FACTOR>();
+            const auto& diameterItem = compdatRecord.getItem<ParserKeywords::COMPDAT::DIAMETER>();
+            const auto& skinFactorItem = compdatRecord.getItem<ParserKeywords::COMPDAT::SKIN>();
+            const auto& satTableIdItem = compdatRecord.getItem<ParserKeywords::COMPDAT::SAT_TABLE>();
 
             if (connectionTransmissibilityFactorItem.hasValue(0) && connectionTransmissibilityFactorItem.getSIDouble(0) > 0)
                 connectionTransmissibilityFactor.setValue(connectionTransmissibilityFactorItem.getSIDouble(0));
@@ -153,7 +154,7 @@ namespace Opm {
             }
         }
 
-        const WellCompletion::DirectionEnum direction = WellCompletion::DirectionEnumFromString(compdatRecord.getItem("DIR").getTrimmedString(0));
+        const WellCompletion::DirectionEnum direction = WellCompletion::DirectionEnumFromString(compdatRecord.getItem<ParserKeywords::COMPDAT::DIR>().getTrimmedString(0));
 
         for (int k = K1; k <= K2; k++) {
             if (defaultSatTable)
@@ -194,7 +195,7 @@ namespace Opm {
 
         for( const auto& record : compdatKeyword ) {
 
-            const auto wellname = record.getItem( "WELL" ).getTrimmedString( 0 );
+            const auto wellname = record.getItem<ParserKeywords::COMPDAT::WELL>().getTrimmedString( 0 );
             const auto name_eq = [&]( const Well* w ) {
                 return w->name() == wellname;
             };
@@ -30,6 +30,10 @@
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/C.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/D.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/G.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/T.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/V.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/W.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -270,10 +274,10 @@ namespace Opm {
 
     void Schedule::handleWHISTCTL(const ParseContext& parseContext, const DeckKeyword& keyword) {
         for( const auto& record : keyword ) {
-            const std::string& cmodeString = record.getItem("CMODE").getTrimmedString(0);
+            const std::string& cmodeString = record.getItem<ParserKeywords::WHISTCTL::CMODE>().getTrimmedString(0);
             WellProducer::ControlModeEnum controlMode = WellProducer::ControlModeFromString( cmodeString );
             m_controlModeWHISTCTL = controlMode;
-            const std::string bhp_terminate = record.getItem("BPH_TERMINATE").getTrimmedString(0);
+            const std::string bhp_terminate = record.getItem<ParserKeywords::WHISTCTL::BPH_TERMINATE>().getTrimmedString(0);
             if (bhp_terminate == "YES") {
                 std::string msg = "The WHISTCTL keyword does not handle 'YES'. i.e. to terminate the run";
                 m_messages.error(msg);
@@ -316,8 +320,8 @@ namespace Opm {
 
         for (size_t recordNr = 0; recordNr < keyword.size(); recordNr++) {
             const auto& record = keyword.getRecord(recordNr);
-            const std::string& wellName = record.getItem("WELL").getTrimmedString(0);
-            const std::string& groupName = record.getItem("GROUP").getTrimmedString(0);
+            const std::string& wellName = record.getItem<ParserKeywords::WELSPECS::WELL>().getTrimmedString(0);
+            const std::string& groupName = record.getItem<ParserKeywords::WELSPECS::GROUP>().getTrimmedString(0);
             bool new_well = false;
 
             if (!hasGroup(groupName))
@@ -345,8 +349,8 @@ namespace Opm {
 
             auto& currentWell = this->m_wells.get( wellName );
 
-            const auto headI = record.getItem( "HEAD_I" ).get< int >( 0 ) - 1;
-            const auto headJ = record.getItem( "HEAD_J" ).get< int >( 0 ) - 1;
+            const auto headI = record.getItem<ParserKeywords::WELSPECS::HEAD_I>().get< int >( 0 ) - 1;
+            const auto headJ = record.getItem<ParserKeywords::WELSPECS::HEAD_J>().get< int >( 0 ) - 1;
             if (!new_well)
                 currentWell.addEvent( ScheduleEvents::WELL_WELSPECS_UPDATE , currentStep );
 
@@ -362,7 +366,7 @@ namespace Opm {
                 currentWell.setHeadJ( currentStep, headJ );
             }
 
-            const auto& refDepthItem = record.getItem( "REF_DEPTH" );
+            const auto& refDepthItem = record.getItem<ParserKeywords::WELSPECS::REF_DEPTH>();
             double refDepth = refDepthItem.hasValue( 0 )
                             ? refDepthItem.getSIDouble( 0 )
                             : -1.0;
@@ -384,8 +388,8 @@ namespace Opm {
 
     void Schedule::handleVAPPARS( const DeckKeyword& keyword, size_t currentStep){
         for( const auto& record : keyword ) {
-            double vap = record.getItem("OIL_VAP_PROPENSITY").get< double >(0);
-            double density = record.getItem("OIL_DENSITY_PROPENSITY").get< double >(0);
+            double vap = record.getItem<ParserKeywords::VAPPARS::OIL_VAP_PROPENSITY>().get< double >(0);
+            double density = record.getItem<ParserKeywords::VAPPARS::OIL_DENSITY_PROPENSITY>().get< double >(0);
             auto vappars = OilVaporizationProperties::createVAPPARS(vap, density);
             this->m_oilvaporizationproperties.update( currentStep, vappars );
 
@@ -394,7 +398,7 @@ namespace Opm {
 
     void Schedule::handleDRVDT( const DeckKeyword& keyword, size_t currentStep){
         for( const auto& record : keyword ) {
-            double max = record.getItem("DRVDT_MAX").getSIDouble(0);
+            double max = record.getItem<ParserKeywords::DRVDT::DRVDT_MAX>().getSIDouble(0);
             auto drvdt = OilVaporizationProperties::createDRVDT(max);
             this->m_oilvaporizationproperties.update( currentStep, drvdt );
 
@@ -404,20 +408,26 @@ namespace Opm {
 
     void Schedule::handleDRSDT( const DeckKeyword& keyword, size_t currentStep){
         for( const auto& record : keyword ) {
-            double max = record.getItem("DRSDT_MAX").getSIDouble(0);
-            std::string option = record.getItem("Option").get< std::string >(0);
+            double max = record.getItem<ParserKeywords::DRSDT::DRSDT_MAX>().getSIDouble(0);
+            std::string option = record.getItem<ParserKeywords::DRSDT::Option>().get< std::string >(0);
             auto drsdt = OilVaporizationProperties::createDRSDT(max, option);
             this->m_oilvaporizationproperties.update( currentStep, drsdt );
         }
     }
 
     void Schedule::handleWCONProducer( const DeckKeyword& keyword, size_t currentStep, bool isPredictionMode) {
+        /*
+         * WELL, STATUS and CMODE are the first three items of both WCONHIST
+         * and WCONPROD, so the WCONHIST items are found by index in both.
+         */
+        using ParserKeywords::WCONHIST;
+
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern =
-                record.getItem("WELL").getTrimmedString(0);
+                record.getItem<WCONHIST::WELL>().getTrimmedString(0);
 
             const WellCommon::StatusEnum status =
-                WellCommon::StatusFromString(record.getItem("STATUS").getTrimmedString(0));
+                WellCommon::StatusFromString(record.getItem<WCONHIST::STATUS>().getTrimmedString(0));
 
             auto wells = getWells(wellNamePattern);
 
@@ -436,7 +446,7 @@ namespace Opm {
 
                 if (status != WellCommon::SHUT) {
                         std::string cmodeString =
-                        record.getItem("CMODE").getTrimmedString(0);
+                        record.getItem<WCONHIST::CMODE>().getTrimmedString(0);
 
                     WellProducer::ControlModeEnum control =
                         WellProducer::ControlModeFromString(cmodeString);
@@ -503,19 +513,19 @@ namespace Opm {
 
     void Schedule::handleWPIMULT( const DeckKeyword& keyword, size_t currentStep) {
         for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            double wellPi = record.getItem("WELLPI").get< double >(0);
+            const std::string& wellNamePattern = record.getItem<ParserKeywords::WPIMULT::WELL>().getTrimmedString(0);
+            double wellPi = record.getItem<ParserKeywords::WPIMULT::WELLPI>().get< double >(0);
 
             for( auto* well : getWells( wellNamePattern ) ) {
                 const auto& currentCompletionSet = well->getCompletions(currentStep);
 
                 CompletionSet newCompletionSet;
 
-                Opm::Value<int> I  = getValueItem(record.getItem("I"));
-                Opm::Value<int> J  = getValueItem(record.getItem("J"));
-                Opm::Value<int> K  = getValueItem(record.getItem("K"));
-                Opm::Value<int> FIRST = getValueItem(record.getItem("FIRST"));
-                Opm::Value<int> LAST = getValueItem(record.getItem("LAST"));
+                Opm::Value<int> I  = getValueItem(record.getItem<ParserKeywords::WPIMULT::I>());
+                Opm::Value<int> J  = getValueItem(record.getItem<ParserKeywords::WPIMULT::J>());
+                Opm::Value<int> K  = getValueItem(record.getItem<ParserKeywords::WPIMULT::K>());
+                Opm::Value<int> FIRST = getValueItem(record.getItem<ParserKeywords::WPIMULT::FIRST>());
+                Opm::Value<int> LAST = getValueItem(record.getItem<ParserKeywords::WPIMULT::LAST>());
 
                 size_t completionSize = currentCompletionSet.size();
 
@@ -565,11 +575,11 @@ namespace Opm {
 
     void Schedule::handleWCONINJE( const SCHEDULESection& section, const DeckKeyword& keyword, size_t currentStep) {
         for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
+            const std::string& wellNamePattern = record.getItem<ParserKeywords::WCONINJE::WELL>().getTrimmedString(0);
 
             for( auto* well : getWells( wellNamePattern ) ) {
-                WellInjector::TypeEnum injectorType = WellInjector::TypeFromString( record.getItem("TYPE").getTrimmedString(0) );
-                WellCommon::StatusEnum status = WellCommon::StatusFromString( record.getItem("STATUS").getTrimmedString(0));
+                WellInjector::TypeEnum injectorType = WellInjector::TypeFromString( record.getItem<ParserKeywords::WCONINJE::TYPE>().getTrimmedString(0) );
+                WellCommon::StatusEnum status = WellCommon::StatusFromString( record.getItem<ParserKeywords::WCONINJE::STATUS>().getTrimmedString(0));
 
                 updateWellStatus( *well , currentStep , status );
                 WellInjectionProperties properties(well->getInjectionPropertiesCopy(currentStep));
@@ -577,23 +587,23 @@ namespace Opm {
                 properties.injectorType = injectorType;
                 properties.predictionMode = true;
 
-                if (!record.getItem("RATE").defaultApplied(0)) {
-                    properties.surfaceInjectionRate = convertInjectionRateToSI(record.getItem("RATE").get< double >(0) , injectorType, section.unitSystem());
+                if (!record.getItem<ParserKeywords::WCONINJE::RATE>().defaultApplied(0)) {
+                    properties.surfaceInjectionRate = convertInjectionRateToSI(record.getItem<ParserKeywords::WCONINJE::RATE>().get< double >(0) , injectorType, section.unitSystem());
                     properties.addInjectionControl(WellInjector::RATE);
                 } else
                     properties.dropInjectionControl(WellInjector::RATE);
 
 
-                if (!record.getItem("RESV").defaultApplied(0)) {
-                    properties.reservoirInjectionRate = record.getItem("RESV").getSIDouble(0);
+                if (!record.getItem<ParserKeywords::WCONINJE::RESV>().defaultApplied(0)) {
+                    properties.reservoirInjectionRate = record.getItem<ParserKeywords::WCONINJE::RESV>().getSIDouble(0);
                     properties.addInjectionControl(WellInjector::RESV);
                 } else
                     properties.dropInjectionControl(WellInjector::RESV);
 
 
-                if (!record.getItem("THP").defaultApplied(0)) {
-                    properties.THPLimit       = record.getItem("THP").getSIDouble(0);
-                    properties.VFPTableNumber = record.getItem("VFP_TABLE").get< int >(0);
+                if (!record.getItem<ParserKeywords::WCONINJE::THP>().defaultApplied(0)) {
+                    properties.THPLimit       = record.getItem<ParserKeywords::WCONINJE::THP>().getSIDouble(0);
+                    properties.VFPTableNumber = record.getItem<ParserKeywords::WCONINJE::VFP_TABLE>().get< int >(0);
                     properties.addInjectionControl(WellInjector::THP);
                 } else
                     properties.dropInjectionControl(WellInjector::THP);
@@ -605,7 +615,7 @@ namespace Opm {
                   current behavoir agrees with the behovir of Eclipse when BHPLimit is not
                   specified while employed during group control.
                 */
-                properties.BHPLimit = record.getItem("BHP").getSIDouble(0);
+                properties.BHPLimit = record.getItem<ParserKeywords::WCONINJE::BHP>().getSIDouble(0);
                 // BHP control should always be there.
                 properties.addInjectionControl(WellInjector::BHP);
 
@@ -614,7 +624,7 @@ namespace Opm {
                 else
                     properties.dropInjectionControl(WellInjector::GRUP);
                 {
-                    const std::string& cmodeString = record.getItem("CMODE").getTrimmedString(0);
+                    const std::string& cmodeString = record.getItem<ParserKeywords::WCONINJE::CMODE>().getTrimmedString(0);
                     WellInjector::ControlModeEnum controlMode = WellInjector::ControlModeFromString( cmodeString );
                     if (properties.hasInjectionControl( controlMode))
                         properties.controlMode = controlMode;
@@ -640,16 +650,16 @@ namespace Opm {
 
     void Schedule::handleWPOLYMER( const DeckKeyword& keyword, size_t currentStep) {
         for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
+            const std::string& wellNamePattern = record.getItem<ParserKeywords::WPOLYMER::WELL>().getTrimmedString(0);
 
             for( auto* well : getWells( wellNamePattern ) ) {
                 WellPolymerProperties properties(well->getPolymerPropertiesCopy(currentStep));
 
-                properties.m_polymerConcentration = record.getItem("POLYMER_CONCENTRATION").getSIDouble(0);
-                properties.m_saltConcentration = record.getItem("SALT_CONCENTRATION").getSIDouble(0);
+                properties.m_polymerConcentration = record.getItem<ParserKeywords::WPOLYMER::POLYMER_CONCENTRATION>().getSIDouble(0);
+                properties.m_saltConcentration = record.getItem<ParserKeywords::WPOLYMER::SALT_CONCENTRATION>().getSIDouble(0);
 
-                const auto& group_polymer_item = record.getItem("GROUP_POLYMER_CONCENTRATION");
-                const auto& group_salt_item = record.getItem("GROUP_SALT_CONCENTRATION");
+                const auto& group_polymer_item = record.getItem<ParserKeywords::WPOLYMER::GROUP_POLYMER_CONCENTRATION>();
+                const auto& group_salt_item = record.getItem<ParserKeywords::WPOLYMER::GROUP_SALT_CONCENTRATION>();
 
                 if (!group_polymer_item.defaultApplied(0)) {
                     throw std::logic_error("Sorry explicit setting of \'GROUP_POLYMER_CONCENTRATION\' is not supported!");
@@ -667,7 +677,7 @@ namespace Opm {
 
     void Schedule::handleWECON( const DeckKeyword& keyword, size_t currentStep) {
         for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
+            const std::string& wellNamePattern = record.getItem<ParserKeywords::WECON::WELL>().getTrimmedString(0);
             WellEconProductionLimits econ_production_limits(record);
 
             for( auto* well : getWells( wellNamePattern ) ) {
@@ -680,12 +690,12 @@ namespace Opm {
     void Schedule::handleWSOLVENT( const DeckKeyword& keyword, size_t currentStep) {
 
         for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
+            const std::string& wellNamePattern = record.getItem<ParserKeywords::WSOLVENT::WELL>().getTrimmedString(0);
 
             for( auto* well : getWells( wellNamePattern ) ) {
                 WellInjectionProperties injectionProperties = well->getInjectionProperties( currentStep );
                 if (well->isInjector( currentStep ) && injectionProperties.injectorType == WellInjector::GAS) {
-                    double fraction = record.getItem("SOLVENT_FRACTION").get< double >(0);
+                    double fraction = record.getItem<ParserKeywords::WSOLVENT::SOLVENT_FRACTION>().get< double >(0);
                     well->setSolventFraction(currentStep, fraction);
                 } else {
                     throw std::invalid_argument("WSOLVENT keyword can only be applied to Gas injectors");
@@ -696,14 +706,14 @@ namespace Opm {
 
     void Schedule::handleWCONINJH( const SCHEDULESection& section,  const DeckKeyword& keyword, size_t currentStep) {
         for( const auto& record : keyword ) {
-            const std::string& wellName = record.getItem("WELL").getTrimmedString(0);
+            const std::string& wellName = record.getItem<ParserKeywords::WCONINJH::WELL>().getTrimmedString(0);
 
             // convert injection rates to SI
-            WellInjector::TypeEnum injectorType = WellInjector::TypeFromString( record.getItem("TYPE").getTrimmedString(0));
-            double injectionRate = record.getItem("RATE").get< double >(0);
+            WellInjector::TypeEnum injectorType = WellInjector::TypeFromString( record.getItem<ParserKeywords::WCONINJH::TYPE>().getTrimmedString(0));
+            double injectionRate = record.getItem<ParserKeywords::WCONINJH::RATE>().get< double >(0);
             injectionRate = convertInjectionRateToSI(injectionRate, injectorType, section.unitSystem());
 
-            WellCommon::StatusEnum status = WellCommon::StatusFromString( record.getItem("STATUS").getTrimmedString(0));
+            WellCommon::StatusEnum status = WellCommon::StatusFromString( record.getItem<ParserKeywords::WCONINJH::STATUS>().getTrimmedString(0));
 
             auto& well = this->m_wells.get( wellName );
             updateWellStatus( well, currentStep, status );
@@ -711,9 +721,9 @@ namespace Opm {
 
             properties.injectorType = injectorType;
 
-            const std::string& cmodeString = record.getItem("CMODE").getTrimmedString(0);
+            const std::string& cmodeString = record.getItem<ParserKeywords::WCONINJH::CMODE>().getTrimmedString(0);
             WellInjector::ControlModeEnum controlMode = WellInjector::ControlModeFromString( cmodeString );
-            if (!record.getItem("RATE").defaultApplied(0)) {
+            if (!record.getItem<ParserKeywords::WCONINJH::RATE>().defaultApplied(0)) {
                 properties.surfaceInjectionRate = injectionRate;
                 properties.addInjectionControl(controlMode);
                 properties.controlMode = controlMode;
@@ -736,8 +746,9 @@ namespace Opm {
     namespace {
 
         bool defaulted( int x ) { return x < 0; }
-        int maybe( const DeckRecord& rec, const std::string& s ) {
-            const auto& item = rec.getItem( s );
+        template< typename Item >
+        int maybe( const DeckRecord& rec ) {
+            const DeckItem& item = rec.getItem< Item >();
             return item.defaultApplied( 0 ) ? -1 : item.get< int >( 0 ) - 1;
         }
     }
@@ -746,16 +757,16 @@ namespace Opm {
                                    size_t timestep ) {
 
         for( const auto& record : keyword ) {
-            const int N  = maybe( record, "N" ) + 1;
+            const int N  = maybe< ParserKeywords::COMPLUMP::N >( record ) + 1;
             if( N < 1 ) throw std::invalid_argument(
                 "Completion number in COMPLUMP can not be defaulted."
             );
 
-            const auto& wellname = record.getItem( "WELL" ).getTrimmedString(0);
-            const int I  = maybe( record, "I" );
-            const int J  = maybe( record, "J" );
-            const int K1 = maybe( record, "K1" );
-            const int K2 = maybe( record, "K2" );
+            const auto& wellname = record.getItem<ParserKeywords::COMPLUMP::WELL>().getTrimmedString(0);
+            const int I  = maybe< ParserKeywords::COMPLUMP::I >( record );
+            const int J  = maybe< ParserKeywords::COMPLUMP::J >( record );
+            const int K1 = maybe< ParserKeywords::COMPLUMP::K1 >( record );
+            const int K2 = maybe< ParserKeywords::COMPLUMP::K2 >( record );
 
             auto new_completion = [=]( const Completion& c ) -> Completion {
                 if( !defaulted( I ) && c.getI() != I )  return c;
@@ -790,8 +801,8 @@ namespace Opm {
         constexpr auto shut = WellCommon::StatusEnum::SHUT;
 
         for( const auto& record : keyword ) {
-            const auto& wellname = record.getItem( "WELL" ).getTrimmedString(0);
-            const auto& status_str = record.getItem( "STATUS" ).getTrimmedString( 0 );
+            const auto& wellname = record.getItem<ParserKeywords::WELOPEN::WELL>().getTrimmedString(0);
+            const auto& status_str = record.getItem<ParserKeywords::WELOPEN::STATUS>().getTrimmedString( 0 );
 
             /* if all records are defaulted or just the status is set, only
              * well status is updated
@@ -815,11 +826,11 @@ namespace Opm {
                 continue;
             }
 
-            const int I  = maybe( record, "I" );
-            const int J  = maybe( record, "J" );
-            const int K  = maybe( record, "K" );
-            const int C1 = maybe( record, "C1" );
-            const int C2 = maybe( record, "C2" );
+            const int I  = maybe< ParserKeywords::WELOPEN::I >( record );
+            const int J  = maybe< ParserKeywords::WELOPEN::J >( record );
+            const int K  = maybe< ParserKeywords::WELOPEN::K >( record );
+            const int C1 = maybe< ParserKeywords::WELOPEN::C1 >( record );
+            const int C2 = maybe< ParserKeywords::WELOPEN::C2 >( record );
 
             const auto status = WellCompletion::StateEnumFromString( status_str );
 
@@ -883,9 +894,9 @@ namespace Opm {
 
         for( const auto& record : keyword ) {
 
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            const std::string& cMode = record.getItem("CMODE").getTrimmedString(0);
-            double newValue = record.getItem("NEW_VALUE").get< double >(0);
+            const std::string& wellNamePattern = record.getItem<ParserKeywords::WELTARG::WELL>().getTrimmedString(0);
+            const std::string& cMode = record.getItem<ParserKeywords::WELTARG::CMODE>().getTrimmedString(0);
+            double newValue = record.getItem<ParserKeywords::WELTARG::NEW_VALUE>().get< double >(0);
 
             const auto wells = getWells( wellNamePattern );
 
@@ -996,29 +1007,29 @@ namespace Opm {
 
     void Schedule::handleGCONINJE( const SCHEDULESection& section,  const DeckKeyword& keyword, size_t currentStep) {
         for( const auto& record : keyword ) {
-            const std::string& groupName = record.getItem("GROUP").getTrimmedString(0);
+            const std::string& groupName = record.getItem<ParserKeywords::GCONINJE::GROUP>().getTrimmedString(0);
             auto& group = this->m_groups.at( groupName );
 
             {
-                Phase phase = get_phase( record.getItem("PHASE").getTrimmedString(0) );
+                Phase phase = get_phase( record.getItem<ParserKeywords::GCONINJE::PHASE>().getTrimmedString(0) );
                 group.setInjectionPhase( currentStep , phase );
             }
             {
-                GroupInjection::ControlEnum controlMode = GroupInjection::ControlEnumFromString( record.getItem("CONTROL_MODE").getTrimmedString(0) );
+                GroupInjection::ControlEnum controlMode = GroupInjection::ControlEnumFromString( record.getItem<ParserKeywords::GCONINJE::CONTROL_MODE>().getTrimmedString(0) );
                 group.setInjectionControlMode( currentStep , controlMode );
             }
 
-            Phase wellPhase = get_phase( record.getItem("PHASE").getTrimmedString(0));
+            Phase wellPhase = get_phase( record.getItem<ParserKeywords::GCONINJE::PHASE>().getTrimmedString(0));
 
             // calculate SI injection rates for the group
-            double surfaceInjectionRate = record.getItem("SURFACE_TARGET").get< double >(0);
+            double surfaceInjectionRate = record.getItem<ParserKeywords::GCONINJE::SURFACE_TARGET>().get< double >(0);
             surfaceInjectionRate = convertInjectionRateToSI(surfaceInjectionRate, wellPhase, section.unitSystem());
-            double reservoirInjectionRate = record.getItem("RESV_TARGET").getSIDouble(0);
+            double reservoirInjectionRate = record.getItem<ParserKeywords::GCONINJE::RESV_TARGET>().getSIDouble(0);
 
             group.setSurfaceMaxRate( currentStep , surfaceInjectionRate);
             group.setReservoirMaxRate( currentStep , reservoirInjectionRate);
-            group.setTargetReinjectFraction( currentStep , record.getItem("REINJ_TARGET").getSIDouble(0));
-            group.setTargetVoidReplacementFraction( currentStep , record.getItem("VOIDAGE_TARGET").getSIDouble(0));
+            group.setTargetReinjectFraction( currentStep , record.getItem<ParserKeywords::GCONINJE::REINJ_TARGET>().getSIDouble(0));
+            group.setTargetVoidReplacementFraction( currentStep , record.getItem<ParserKeywords::GCONINJE::VOIDAGE_TARGET>().getSIDouble(0));
 
             group.setInjectionGroup(currentStep, true);
         }
@@ -1026,19 +1037,19 @@ namespace Opm {
 
     void Schedule::handleGCONPROD( const DeckKeyword& keyword, size_t currentStep) {
         for( const auto& record : keyword ) {
-            const std::string& groupName = record.getItem("GROUP").getTrimmedString(0);
+            const std::string& groupName = record.getItem<ParserKeywords::GCONPROD::GROUP>().getTrimmedString(0);
             auto& group = this->m_groups.at( groupName );
             {
-                GroupProduction::ControlEnum controlMode = GroupProduction::ControlEnumFromString( record.getItem("CONTROL_MODE").getTrimmedString(0) );
+                GroupProduction::ControlEnum controlMode = GroupProduction::ControlEnumFromString( record.getItem<ParserKeywords::GCONPROD::CONTROL_MODE>().getTrimmedString(0) );
                 group.setProductionControlMode( currentStep , controlMode );
             }
-            group.setOilTargetRate( currentStep , record.getItem("OIL_TARGET").getSIDouble(0));
-            group.setGasTargetRate( currentStep , record.getItem("GAS_TARGET").getSIDouble(0));
-            group.setWaterTargetRate( currentStep , record.getItem("WATER_TARGET").getSIDouble(0));
-            group.setLiquidTargetRate( currentStep , record.getItem("LIQUID_TARGET").getSIDouble(0));
-            group.setReservoirVolumeTargetRate( currentStep , record.getItem("RESERVOIR_FLUID_TARGET").getSIDouble(0));
+            group.setOilTargetRate( currentStep , record.getItem<ParserKeywords::GCONPROD::OIL_TARGET>().getSIDouble(0));
+            group.setGasTargetRate( currentStep , record.getItem<ParserKeywords::GCONPROD::GAS_TARGET>().getSIDouble(0));
+            group.setWaterTargetRate( currentStep , record.getItem<ParserKeywords::GCONPROD::WATER_TARGET>().getSIDouble(0));
+            group.setLiquidTargetRate( currentStep , record.getItem<ParserKeywords::GCONPROD::LIQUID_TARGET>().getSIDouble(0));
+            group.setReservoirVolumeTargetRate( currentStep , record.getItem<ParserKeywords::GCONPROD::RESERVOIR_FLUID_TARGET>().getSIDouble(0));
             {
-                GroupProductionExceedLimit::ActionEnum exceedAction = GroupProductionExceedLimit::ActionEnumFromString(record.getItem("EXCEED_PROC").getTrimmedString(0) );
+                GroupProductionExceedLimit::ActionEnum exceedAction = GroupProductionExceedLimit::ActionEnumFromString(record.getItem<ParserKeywords::GCONPROD::EXCEED_PROC>().getTrimmedString(0) );
                 group.setProductionExceedLimitAction( currentStep , exceedAction );
             }
 
@@ -1049,12 +1060,12 @@ namespace Opm {
 
     void Schedule::handleGEFAC( const DeckKeyword& keyword, size_t currentStep) {
         for( const auto& record : keyword ) {
-            const std::string& groupName = record.getItem("GROUP").getTrimmedString(0);
+            const std::string& groupName = record.getItem<ParserKeywords::GEFAC::GROUP>().getTrimmedString(0);
             auto& group = this->m_groups.at( groupName );
 
-            group.setGroupEfficiencyFactor(currentStep, record.getItem("EFFICIENCY_FACTOR").get< double >(0));
+            group.setGroupEfficiencyFactor(currentStep, record.getItem<ParserKeywords::GEFAC::EFFICIENCY_FACTOR>().get< double >(0));
 
-            const std::string& transfer_str = record.getItem("TRANSFER_EXT_NET").getTrimmedString(0);
+            const std::string& transfer_str = record.getItem<ParserKeywords::GEFAC::TRANSFER_EXT_NET>().getTrimmedString(0);
             bool transfer = (transfer_str == "YES") ? true : false;
             group.setTransferGroupEfficiencyFactor(currentStep, transfer);
         }
@@ -1068,34 +1079,34 @@ namespace Opm {
         if (numrecords > 0) {
             const auto& record1 = keyword.getRecord(0);
 
-            double TSINIT = record1.getItem("TSINIT").getSIDouble(0);
+            double TSINIT = record1.getItem<ParserKeywords::TUNING::TSINIT>().getSIDouble(0);
             this->m_tuning.setTSINIT(currentStep, TSINIT);
 
-            double TSMAXZ = record1.getItem("TSMAXZ").getSIDouble(0);
+            double TSMAXZ = record1.getItem<ParserKeywords::TUNING::TSMAXZ>().getSIDouble(0);
             this->m_tuning.setTSMAXZ(currentStep, TSMAXZ);
 
-            double TSMINZ = record1.getItem("TSMINZ").getSIDouble(0);
+            double TSMINZ = record1.getItem<ParserKeywords::TUNING::TSMINZ>().getSIDouble(0);
             this->m_tuning.setTSMINZ(currentStep, TSMINZ);
 
-            double TSMCHP = record1.getItem("TSMCHP").getSIDouble(0);
+            double TSMCHP = record1.getItem<ParserKeywords::TUNING::TSMCHP>().getSIDouble(0);
             this->m_tuning.setTSMCHP(currentStep, TSMCHP);
 
-            double TSFMAX = record1.getItem("TSFMAX").get< double >(0);
+            double TSFMAX = record1.getItem<ParserKeywords::TUNING::TSFMAX>().get< double >(0);
             this->m_tuning.setTSFMAX(currentStep, TSFMAX);
 
-            double TSFMIN = record1.getItem("TSFMIN").get< double >(0);
+            double TSFMIN = record1.getItem<ParserKeywords::TUNING::TSFMIN>().get< double >(0);
             this->m_tuning.setTSFMIN(currentStep, TSFMIN);
 
-            double TSFCNV = record1.getItem("TSFCNV").get< double >(0);
+            double TSFCNV = record1.getItem<ParserKeywords::TUNING::TSFCNV>().get< double >(0);
             this->m_tuning.setTSFCNV(currentStep, TSFCNV);
 
-            double TFDIFF = record1.getItem("TFDIFF").get< double >(0);
+            double TFDIFF = record1.getItem<ParserKeywords::TUNING::TFDIFF>().get< double >(0);
             this->m_tuning.setTFDIFF(currentStep, TFDIFF);
 
-            double THRUPT = record1.getItem("THRUPT").get< double >(0);
+            double THRUPT = record1.getItem<ParserKeywords::TUNING::THRUPT>().get< double >(0);
             this->m_tuning.setTHRUPT(currentStep, THRUPT);
 
-            const auto& TMAXWCdeckItem = record1.getItem("TMAXWC");
+            const auto& TMAXWCdeckItem = record1.getItem<ParserKeywords::TUNING::TMAXWC>();
             if (TMAXWCdeckItem.hasValue(0)) {
                 double TMAXWC = TMAXWCdeckItem.getSIDouble(0);
                 this->m_tuning.setTMAXWC(currentStep, TMAXWC);
@@ -1106,46 +1117,46 @@ namespace Opm {
         if (numrecords > 1) {
             const auto& record2 = keyword.getRecord(1);
 
-            double TRGTTE = record2.getItem("TRGTTE").get< double >(0);
+            double TRGTTE = record2.getItem<ParserKeywords::TUNING::TRGTTE>().get< double >(0);
             this->m_tuning.setTRGTTE(currentStep, TRGTTE);
 
-            double TRGCNV = record2.getItem("TRGCNV").get< double >(0);
+            double TRGCNV = record2.getItem<ParserKeywords::TUNING::TRGCNV>().get< double >(0);
             this->m_tuning.setTRGCNV(currentStep, TRGCNV);
 
-            double TRGMBE = record2.getItem("TRGMBE").get< double >(0);
+            double TRGMBE = record2.getItem<ParserKeywords::TUNING::TRGMBE>().get< double >(0);
             this->m_tuning.setTRGMBE(currentStep, TRGMBE);
 
-            double TRGLCV = record2.getItem("TRGLCV").get< double >(0);
+            double TRGLCV = record2.getItem<ParserKeywords::TUNING::TRGLCV>().get< double >(0);
             this->m_tuning.setTRGLCV(currentStep, TRGLCV);
 
-            double XXXTTE = record2.getItem("XXXTTE").get< double >(0);
+            double XXXTTE = record2.getItem<ParserKeywords::TUNING::XXXTTE>().get< double >(0);
             this->m_tuning.setXXXTTE(currentStep, XXXTTE);
 
-            double XXXCNV = record2.getItem("XXXCNV").get< double >(0);
+            double XXXCNV = record2.getItem<ParserKeywords::TUNING::XXXCNV>().get< double >(0);
             this->m_tuning.setXXXCNV(currentStep, XXXCNV);
 
-            double XXXMBE = record2.getItem("XXXMBE").get< double >(0);
+            double XXXMBE = record2.getItem<ParserKeywords::TUNING::XXXMBE>().get< double >(0);
             this->m_tuning.setXXXMBE(currentStep, XXXMBE);
 
-            double XXXLCV = record2.getItem("XXXLCV").get< double >(0);
+            double XXXLCV = record2.getItem<ParserKeywords::TUNING::XXXLCV>().get< double >(0);
             this->m_tuning.setXXXLCV(currentStep, XXXLCV);
 
-            double XXXWFL = record2.getItem("XXXWFL").get< double >(0);
+            double XXXWFL = record2.getItem<ParserKeywords::TUNING::XXXWFL>().get< double >(0);
             this->m_tuning.setXXXWFL(currentStep, XXXWFL);
 
-            double TRGFIP = record2.getItem("TRGFIP").get< double >(0);
+            double TRGFIP = record2.getItem<ParserKeywords::TUNING::TRGFIP>().get< double >(0);
             this->m_tuning.setTRGFIP(currentStep, TRGFIP);
 
-            const auto& TRGSFTdeckItem = record2.getItem("TRGSFT");
+            const auto& TRGSFTdeckItem = record2.getItem<ParserKeywords::TUNING::TRGSFT>();
             if (TRGSFTdeckItem.hasValue(0)) {
                 double TRGSFT = TRGSFTdeckItem.get< double >(0);
                 this->m_tuning.setTRGSFT(currentStep, TRGSFT);
             }
 
-            double THIONX = record2.getItem("THIONX").get< double >(0);
+            double THIONX = record2.getItem<ParserKeywords::TUNING::THIONX>().get< double >(0);
             this->m_tuning.setTHIONX(currentStep, THIONX);
 
-            int TRWGHT = record2.getItem("TRWGHT").get< int >(0);
+            int TRWGHT = record2.getItem<ParserKeywords::TUNING::TRWGHT>().get< int >(0);
             this->m_tuning.setTRWGHT(currentStep, TRWGHT);
         }
 
@@ -1153,34 +1164,34 @@ namespace Opm {
         if (numrecords > 2) {
             const auto& record3 = keyword.getRecord(2);
 
-            int NEWTMX = record3.getItem("NEWTMX").get< int >(0);
+            int NEWTMX = record3.getItem<ParserKeywords::TUNING::NEWTMX>().get< int >(0);
             this->m_tuning.setNEWTMX(currentStep, NEWTMX);
 
-            int NEWTMN = record3.getItem("NEWTMN").get< int >(0);
+            int NEWTMN = record3.getItem<ParserKeywords::TUNING::NEWTMN>().get< int >(0);
             this->m_tuning.setNEWTMN(currentStep, NEWTMN);
 
-            int LITMAX = record3.getItem("LITMAX").get< int >(0);
+            int LITMAX = record3.getItem<ParserKeywords::TUNING::LITMAX>().get< int >(0);
             this->m_tuning.setLITMAX(currentStep, LITMAX);
 
-            int LITMIN = record3.getItem("LITMIN").get< int >(0);
+            int LITMIN = record3.getItem<ParserKeywords::TUNING::LITMIN>().get< int >(0);
             this->m_tuning.setLITMIN(currentStep, LITMIN);
 
-            int MXWSIT = record3.getItem("MXWSIT").get< int >(0);
+            int MXWSIT = record3.getItem<ParserKeywords::TUNING::MXWSIT>().get< int >(0);
             this->m_tuning.setMXWSIT(currentStep, MXWSIT);
 
-            int MXWPIT = record3.getItem("MXWPIT").get< int >(0);
+            int MXWPIT = record3.getItem<ParserKeywords::TUNING::MXWPIT>().get< int >(0);
             this->m_tuning.setMXWPIT(currentStep, MXWPIT);
 
-            double DDPLIM = record3.getItem("DDPLIM").getSIDouble(0);
+            double DDPLIM = record3.getItem<ParserKeywords::TUNING::DDPLIM>().getSIDouble(0);
             this->m_tuning.setDDPLIM(currentStep, DDPLIM);
 
-            double DDSLIM = record3.getItem("DDSLIM").get< double >(0);
+            double DDSLIM = record3.getItem<ParserKeywords::TUNING::DDSLIM>().get< double >(0);
             this->m_tuning.setDDSLIM(currentStep, DDSLIM);
 
-            double TRGDPR = record3.getItem("TRGDPR").getSIDouble(0);
+            double TRGDPR = record3.getItem<ParserKeywords::TUNING::TRGDPR>().getSIDouble(0);
             this->m_tuning.setTRGDPR(currentStep, TRGDPR);
 
-            const auto& XXXDPRdeckItem = record3.getItem("XXXDPR");
+            const auto& XXXDPRdeckItem = record3.getItem<ParserKeywords::TUNING::XXXDPR>();
             if (XXXDPRdeckItem.hasValue(0)) {
                 double XXXDPR = XXXDPRdeckItem.getSIDouble(0);
                 this->m_tuning.setXXXDPR(currentStep, XXXDPR);
@@ -1249,7 +1260,7 @@ namespace Opm {
 
     void Schedule::handleCOMPSEGS( const DeckKeyword& keyword, size_t currentStep) {
         const auto& record1 = keyword.getRecord(0);
-        const std::string& well_name = record1.getItem("WELL").getTrimmedString(0);
+        const std::string& well_name = record1.getItem<ParserKeywords::COMPSEGS::WELL>().getTrimmedString(0);
         auto& well = this->m_wells.get( well_name );
 
         auto compsegs_vector = Compsegs::compsegsFromCOMPSEGSKeyword( keyword );
@@ -1265,21 +1276,21 @@ namespace Opm {
 
     void Schedule::handleWGRUPCON( const DeckKeyword& keyword, size_t currentStep) {
         for( const auto& record : keyword ) {
-            const std::string& wellName = record.getItem("WELL").getTrimmedString(0);
+            const std::string& wellName = record.getItem<ParserKeywords::WGRUPCON::WELL>().getTrimmedString(0);
             auto& well = this->m_wells.get( wellName );
 
-            bool availableForGroupControl = convertEclipseStringToBool(record.getItem("GROUP_CONTROLLED").getTrimmedString(0));
+            bool availableForGroupControl = convertEclipseStringToBool(record.getItem<ParserKeywords::WGRUPCON::GROUP_CONTROLLED>().getTrimmedString(0));
             well.setAvailableForGroupControl(currentStep, availableForGroupControl);
 
-            well.setGuideRate(currentStep, record.getItem("GUIDE_RATE").get< double >(0));
+            well.setGuideRate(currentStep, record.getItem<ParserKeywords::WGRUPCON::GUIDE_RATE>().get< double >(0));
 
-            if (!record.getItem("PHASE").defaultApplied(0)) {
-                std::string guideRatePhase = record.getItem("PHASE").getTrimmedString(0);
+            if (!record.getItem<ParserKeywords::WGRUPCON::PHASE>().defaultApplied(0)) {
+                std::string guideRatePhase = record.getItem<ParserKeywords::WGRUPCON::PHASE>().getTrimmedString(0);
                 well.setGuideRatePhase(currentStep, GuideRate::GuideRatePhaseEnumFromString(guideRatePhase));
             } else
                 well.setGuideRatePhase(currentStep, GuideRate::UNDEFINED);
 
-            well.setGuideRateScalingFactor(currentStep, record.getItem("SCALING_FACTOR").get< double >(0));
+            well.setGuideRateScalingFactor(currentStep, record.getItem<ParserKeywords::WGRUPCON::SCALING_FACTOR>().get< double >(0));
         }
     }
 
@@ -1287,8 +1298,8 @@ namespace Opm {
         const auto& currentTree = m_rootGroupTree.get(currentStep);
         auto newTree = currentTree;
         for( const auto& record : keyword ) {
-            const std::string& childName = record.getItem("CHILD_GROUP").getTrimmedString(0);
-            const std::string& parentName = record.getItem("PARENT_GROUP").getTrimmedString(0);
+            const std::string& childName = record.getItem<ParserKeywords::GRUPTREE::CHILD_GROUP>().getTrimmedString(0);
+            const std::string& parentName = record.getItem<ParserKeywords::GRUPTREE::PARENT_GROUP>().getTrimmedString(0);
             newTree.update(childName, parentName);
 
             if (!hasGroup(parentName))
@@ -1308,7 +1319,7 @@ namespace Opm {
 
         for( const auto& record : keyword ) {
 
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
+            const std::string& wellNamePattern = record.getItem<ParserKeywords::WRFT::WELL>().getTrimmedString(0);
 
             for( auto* well : getWells( wellNamePattern ) ) {
 
@@ -1329,10 +1340,10 @@ namespace Opm {
 
         for( const auto& record : keyword ) {
 
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
+            const std::string& wellNamePattern = record.getItem<ParserKeywords::WRFTPLT::WELL>().getTrimmedString(0);
 
-            RFTConnections::RFTEnum RFTKey = RFTConnections::RFTEnumFromString(record.getItem("OUTPUT_RFT").getTrimmedString(0));
-            PLTConnections::PLTEnum PLTKey = PLTConnections::PLTEnumFromString(record.getItem("OUTPUT_PLT").getTrimmedString(0));
+            RFTConnections::RFTEnum RFTKey = RFTConnections::RFTEnumFromString(record.getItem<ParserKeywords::WRFTPLT::OUTPUT_RFT>().getTrimmedString(0));
+            PLTConnections::PLTEnum PLTKey = PLTConnections::PLTEnumFromString(record.getItem<ParserKeywords::WRFTPLT::OUTPUT_PLT>().getTrimmedString(0));
 
             for( auto* well : getWells( wellNamePattern ) ) {
                 switch(RFTKey){
@@ -1381,10 +1392,10 @@ namespace Opm {
 
     void Schedule::addWell(const std::string& wellName, const DeckRecord& record, size_t timeStep, WellCompletion::CompletionOrderEnum wellCompletionOrder) {
         // We change from eclipse's 1 - n, to a 0 - n-1 solution
-        int headI = record.getItem("HEAD_I").get< int >(0) - 1;
-        int headJ = record.getItem("HEAD_J").get< int >(0) - 1;
-        Phase preferredPhase = get_phase(record.getItem("PHASE").getTrimmedString(0));
-        const auto& refDepthItem = record.getItem("REF_DEPTH");
+        int headI = record.getItem<ParserKeywords::WELSPECS::HEAD_I>().get< int >(0) - 1;
+        int headJ = record.getItem<ParserKeywords::WELSPECS::HEAD_J>().get< int >(0) - 1;
+        Phase preferredPhase = get_phase(record.getItem<ParserKeywords::WELSPECS::PHASE>().getTrimmedString(0));
+        const auto& refDepthItem = record.getItem<ParserKeywords::WELSPECS::REF_DEPTH>();
 
         double refDepth = refDepthItem.hasValue( 0 )
                         ? refDepthItem.getSIDouble( 0 )
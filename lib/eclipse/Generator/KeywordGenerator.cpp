@@ -17,8 +17,11 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cstdint>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <cctype>
@@ -29,6 +32,7 @@
 #include <opm/json/JsonObject.hpp>
 #include <opm/parser/eclipse/Generator/KeywordGenerator.hpp>
 #include <opm/parser/eclipse/Generator/KeywordLoader.hpp>
+#include <opm/parser/eclipse/Parser/KeywordHash.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 
 
@@ -49,6 +53,9 @@ const std::string testHeader =
     "auto unitSystem =  UnitSystem::newMETRIC();\n";
 
 const std::string sourceHeader =
+    "#include <iterator>\n"
+    "#include <opm/parser/eclipse/Parser/KeywordHash.hpp>\n"
+    "#include <opm/parser/eclipse/Parser/KeywordRegistry.hpp>\n"
     "#include <opm/parser/eclipse/Parser/ParserKeyword.hpp>\n"
     "#include <opm/parser/eclipse/Parser/ParserItem.hpp>\n"
     "#include <opm/parser/eclipse/Parser/ParserRecord.hpp>\n"
@@ -56,6 +63,16 @@ const std::string sourceHeader =
     "#include <opm/parser/eclipse/Parser/ParserKeywords.hpp>\n\n\n"
     "namespace Opm {\n"
     "namespace ParserKeywords {\n\n";
+
+/* FNV-1a, continued from h */
+uint64_t fnv1a( const std::string& text, uint64_t h ) {
+    for( const auto c : text ) {
+        h ^= static_cast< unsigned char >( c );
+        h *= 1099511628211ULL;
+    }
+
+    return h;
+}
 }
 
 namespace Opm {
@@ -102,19 +119,107 @@ namespace Opm {
     }
 
 
-    bool KeywordGenerator::updateSource(const KeywordLoader& loader , const std::string& sourceFile ) const {
-        std::stringstream newSource;
-        newSource << sourceHeader << std::endl;
+    /*
+     * The perfect hash of all the deck names of the default keywords is built
+     * here, and only the seeds, the names in slot order and the keyword of
+     * every slot end up in the library. A deck name of several keywords
+     * belongs to the last one.
+     */
+    std::string KeywordGenerator::createKeywordHash(const KeywordLoader& loader) {
+        std::map< std::string, size_t > owner;
+        size_t index = 0;
+        for( auto iter = loader.keyword_begin(); iter != loader.keyword_end(); ++iter, ++index ) {
+            const auto& keyword = *iter->second;
+            for( auto name = keyword.deckNamesBegin(); name != keyword.deckNamesEnd(); ++name )
+                owner[ *name ] = index;
+        }
+
+        std::vector< std::string > names;
+        for( const auto& name : owner )
+            names.push_back( name.first );
+
+        const auto hash = KeywordHash::build( names );
+
+        std::stringstream stream;
+        stream << "static const uint32_t deckNameSeeds[] = {";
+        for( const auto seed : hash.seeds() )
+            stream << " " << seed << ",";
+        stream << " };" << std::endl;
+
+        stream << "static const char* const deckNames[] = {";
+        for( const auto& name : hash.names() )
+            stream << " \"" << name << "\",";
+        stream << " };" << std::endl;
+
+        stream << "static const uint32_t deckNameKeywords[] = {";
+        for( const auto& name : hash.names() )
+            stream << " " << owner.at( name.string() ) << ",";
+        stream << " };" << std::endl;
+
+        stream << "const KeywordHash& defaultKeywordHash();" << std::endl
+               << "const KeywordHash& defaultKeywordHash() {" << std::endl
+               << "    static const KeywordHash hash(" << std::endl
+               << "        { std::begin( deckNameSeeds ), std::end( deckNameSeeds ) }," << std::endl
+               << "        { std::begin( deckNames ), std::end( deckNames ) } );" << std::endl
+               << "    return hash;" << std::endl
+               << "}" << std::endl;
+
+        return stream.str();
+    }
 
-        newSource << "void addDefaultKeywords(Parser& p);"  << std::endl
-                  << "void addDefaultKeywords(Parser& p) {" << std::endl;
+    /*
+     * A constant descriptor of every default keyword, with what the parser
+     * needs to know without building the keyword, and a function that builds
+     * it. The descriptors are in the order of the keyword indices in the
+     * hash.
+     *
+     * The registry also gets a hash of the code of every keyword, which
+     * changes with the definition of any of them.
+     */
+    std::string KeywordGenerator::createKeywordRegistry(const KeywordLoader& loader) {
+        uint64_t definitions = 14695981039346656037ULL;
+        for( auto iter = loader.keyword_begin(); iter != loader.keyword_end(); ++iter )
+            definitions = fnv1a( iter->second->createCode(), definitions );
+
+        std::stringstream stream;
+        stream << "template< typename Keyword >" << std::endl
+               << "ParserKeyword* make() { return new Keyword(); }" << std::endl;
+
+        stream << "static const KeywordRegistry::Descriptor descriptors[] = {" << std::endl;
         for( auto iter = loader.keyword_begin(); iter != loader.keyword_end(); ++iter ) {
-            newSource << "p.addKeyword< ParserKeywords::"
-                      << iter->second->className()
-                      << " >();" << std::endl;
+            const auto& keyword = *iter->second;
+            stream << "    { \"" << keyword.getName() << "\", ";
+
+            if( keyword.getSizeType() == OTHER_KEYWORD_IN_DECK )
+                stream << "\"" << keyword.getSizeDefinitionPair().first << "\", ";
+            else
+                stream << "nullptr, ";
+
+            stream << ( keyword.hasMatchRegex() ? "true" : "false" ) << ", "
+                   << "&make< " << keyword.className() << " > }," << std::endl;
         }
+        stream << "};" << std::endl;
+
+        stream << "const KeywordRegistry& defaultKeywordRegistry();" << std::endl
+               << "const KeywordRegistry& defaultKeywordRegistry() {" << std::endl
+               << "    static const KeywordRegistry registry( defaultKeywordHash()," << std::endl
+               << "                                           descriptors," << std::endl
+               << "                                           std::end( descriptors ) - std::begin( descriptors )," << std::endl
+               << "                                           deckNameKeywords," << std::endl
+               << "                                           0x" << std::hex << std::setw( 16 ) << std::setfill( '0' )
+               << definitions << std::dec << "ULL );" << std::endl
+               << "    return registry;" << std::endl
+               << "}" << std::endl;
+
+        return stream.str();
+    }
 
-        newSource << "}" << std::endl;
+    bool KeywordGenerator::updateSource(const KeywordLoader& loader , const std::string& sourceFile ) const {
+        std::stringstream newSource;
+        newSource << sourceHeader << std::endl;
+
+        newSource << createKeywordHash( loader ) << std::endl;
+        newSource << createKeywordRegistry( loader ) << std::endl;
 
         for (auto iter = loader.keyword_begin(); iter != loader.keyword_end(); ++iter) {
             std::shared_ptr<ParserKeyword> keyword = (*iter).second;
@@ -124,7 +229,7 @@ namespace Opm {
         newSource << "}" << std::endl;
 
         newSource << "void Parser::addDefaultKeywords() {" << std::endl
-                  << "Opm::ParserKeywords::addDefaultKeywords(*this);" << std::endl
+                  << "this->setDefaultKeywords( Opm::ParserKeywords::defaultKeywordRegistry() );" << std::endl
                   << "}}" << std::endl;
 
         return write_file( newSource, sourceFile, m_verbose, "source" );
@@ -0,0 +1,302 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Parser/BinaryImport.hpp>
+
+namespace Opm {
+
+namespace {
+
+bool host_little_endian() {
+    const uint16_t x = 1;
+    unsigned char first;
+    std::memcpy( &first, &x, 1 );
+    return first == 1;
+}
+
+const bool little_endian = host_little_endian();
+
+uint32_t swap( uint32_t x ) {
+    return ( x >> 24 )
+         | ( ( x >> 8 ) & 0x0000ff00 )
+         | ( ( x << 8 ) & 0x00ff0000 )
+         | ( x << 24 );
+}
+
+uint64_t swap( uint64_t x ) {
+    return ( uint64_t( swap( uint32_t( x ) ) ) << 32 )
+         | swap( uint32_t( x >> 32 ) );
+}
+
+template< typename Word >
+Word load( const char* src, bool swapped ) {
+    Word w;
+    std::memcpy( &w, src, sizeof( w ) );
+    return swapped ? swap( w ) : w;
+}
+
+/*
+ * The values are stored as Stored, in words that may have to be byte
+ * swapped. The loop is branch free for a given block, and vectorises.
+ */
+template< typename Word, typename Stored, typename T >
+void decode( const char* src, size_t count, bool swapped, T* dst ) {
+    static_assert( sizeof( Word ) == sizeof( Stored ), "word size mismatch" );
+
+    for( size_t i = 0; i < count; ++i ) {
+        const auto w = load< Word >( src + i * sizeof( Word ), swapped );
+        Stored x;
+        std::memcpy( &x, &w, sizeof( x ) );
+        dst[ i ] = T( x );
+    }
+}
+
+const size_t unknown_type = size_t( -1 );
+
+/* the size in bytes of an element of the type, as written by Eclipse */
+size_t element_size( const std::string& type ) {
+    if( type == "INTE" || type == "REAL" || type == "LOGI" ) return 4;
+    if( type == "DOUB" || type == "CHAR" ) return 8;
+    if( type == "MESS" ) return 0;
+
+    /* C0nn are strings of nn characters */
+    if( type.size() == 4 && type[ 0 ] == 'C' && type[ 1 ] == '0'
+        && std::isdigit( (unsigned char) type[ 2 ] )
+        && std::isdigit( (unsigned char) type[ 3 ] ) )
+        return std::stoul( type.substr( 2 ) );
+
+    return unknown_type;
+}
+
+std::string trimmed_name( const char* src ) {
+    std::string name( src, 8 );
+    return name.substr( 0, name.find_last_not_of( ' ' ) + 1 );
+}
+
+}
+
+BinaryImport::Format BinaryImport::formatFromString( const std::string& str ) {
+    if( str == "UNFORMATTED" ) return Format::UNFORMATTED;
+    if( str == "RAW" ) return Format::RAW;
+    if( str == "FORMATTED" )
+        throw std::invalid_argument( "IMPORT of formatted files is not supported" );
+
+    throw std::invalid_argument( str + " is not a valid IMPORT format" );
+}
+
+BinaryImport::BinaryImport( const boost::filesystem::path& p, Format fmt ) :
+    path( p ),
+    format( fmt ),
+    mapping( p.string() )
+{
+    if( this->mapping ) {
+        this->pos = this->mapping.data();
+        this->end = this->pos + this->mapping.size();
+        return;
+    }
+
+    const auto closer = []( std::FILE* f ) { std::fclose( f ); };
+    std::unique_ptr< std::FILE, decltype( closer ) > ufp(
+            std::fopen( p.string().c_str(), "rb" ),
+            closer
+            );
+
+    if( !ufp )
+        throw std::invalid_argument( "Could not open IMPORT file " + p.string() );
+
+    auto* fp = ufp.get();
+    std::fseek( fp, 0, SEEK_END );
+    this->buffer.resize( std::ftell( fp ) );
+    std::rewind( fp );
+    const auto readc = std::fread( &this->buffer[ 0 ], 1, this->buffer.size(), fp );
+
+    if( std::ferror( fp ) || readc != this->buffer.size() )
+        throw std::invalid_argument( "Error when reading IMPORT file " + p.string() );
+
+    this->pos = this->buffer.data();
+    this->end = this->pos + this->buffer.size();
+}
+
+void BinaryImport::malformed( const std::string& msg ) const {
+    throw std::invalid_argument( "Malformed IMPORT file " + this->path.string()
+                               + ": " + msg );
+}
+
+bool BinaryImport::next() {
+    this->blocks.clear();
+    if( this->pos == this->end ) return false;
+
+    return this->format == Format::UNFORMATTED
+         ? this->next_unformatted()
+         : this->next_raw();
+}
+
+/*
+ * Every array is a header record followed by as many data records as it
+ * takes to hold the values, usually 1000 numbers per record. A record is
+ * its length in bytes, the data, and the length again, in big endian.
+ */
+bool BinaryImport::next_unformatted() {
+    const auto record = [this]( size_t& length ) {
+        if( this->end - this->pos < 4 ) this->malformed( "truncated record" );
+
+        length = load< uint32_t >( this->pos, little_endian );
+        if( size_t( this->end - this->pos ) < length + 8 )
+            this->malformed( "truncated record" );
+
+        const char* data = this->pos + 4;
+        if( load< uint32_t >( data + length, little_endian ) != length )
+            this->malformed( "record markers do not match" );
+
+        this->pos = data + length + 4;
+        return data;
+    };
+
+    size_t length;
+    const char* header = record( length );
+    if( length != 16 ) this->malformed( "expected an array header" );
+
+    this->array_name = trimmed_name( header );
+    const auto count = int32_t( load< uint32_t >( header + 8, little_endian ) );
+    this->array_type = std::string( header + 12, 4 );
+
+    if( count < 0 ) this->malformed( "negative size of " + this->array_name );
+    this->array_size = count;
+
+    const auto elem = element_size( this->array_type );
+    if( elem == unknown_type )
+        this->malformed( "unknown type " + this->array_type + " of " + this->array_name );
+
+    size_t read = 0;
+    while( read < this->array_size ) {
+        const char* data = record( length );
+        if( elem == 0 || length % elem != 0 || length / elem > this->array_size - read )
+            this->malformed( "wrong record size in " + this->array_name );
+
+        this->blocks.push_back( { data, length / elem } );
+        read += length / elem;
+    }
+
+    return true;
+}
+
+bool BinaryImport::next_raw() {
+    const size_t header_size = 32;
+    if( size_t( this->end - this->pos ) < header_size )
+        this->malformed( "truncated header" );
+
+    if( std::memcmp( this->pos, "OPMARRAY", 8 ) != 0 )
+        this->malformed( "not a raw array file" );
+
+    this->array_name = trimmed_name( this->pos + 8 );
+    this->array_type = std::string( this->pos + 16, 4 );
+    const auto count = load< uint64_t >( this->pos + 24, !little_endian );
+
+    const auto elem = this->array_type == "DOUB" ? 8
+                    : this->array_type == "INTE" || this->array_type == "REAL" ? 4
+                    : 0;
+    if( elem == 0 )
+        this->malformed( "unknown type " + this->array_type + " of " + this->array_name );
+
+    const char* data = this->pos + header_size;
+    const size_t left = this->end - data;
+    if( count > left / elem ) this->malformed( "truncated array " + this->array_name );
+
+    this->array_size = count;
+    this->blocks.push_back( { data, size_t( count ) } );
+
+    /* the last array needs no padding */
+    const size_t bytes = count * elem;
+    const size_t padded = ( bytes + 7 ) / 8 * 8;
+    this->pos = data + ( padded < left ? padded : left );
+    return true;
+}
+
+const std::string& BinaryImport::name() const {
+    return this->array_name;
+}
+
+size_t BinaryImport::size() const {
+    return this->array_size;
+}
+
+type_tag BinaryImport::type() const {
+    if( this->array_type == "INTE" || this->array_type == "LOGI" )
+        return type_tag::integer;
+
+    if( this->array_type == "REAL" || this->array_type == "DOUB" )
+        return type_tag::fdouble;
+
+    return type_tag::string;
+}
+
+template< typename T >
+std::vector< T > BinaryImport::convert() const {
+    const bool swapped = this->format == Format::UNFORMATTED
+                       ? little_endian
+                       : !little_endian;
+
+    std::vector< T > values( this->array_size );
+    auto* dst = values.data();
+
+    for( const auto& b : this->blocks ) {
+        if( this->array_type == "DOUB" )
+            decode< uint64_t, double >( b.data, b.count, swapped, dst );
+        else if( this->array_type == "REAL" )
+            decode< uint32_t, float >( b.data, b.count, swapped, dst );
+        else
+            decode< uint32_t, int32_t >( b.data, b.count, swapped, dst );
+
+        dst += b.count;
+    }
+
+    return values;
+}
+
+std::vector< int > BinaryImport::getIntData() const {
+    if( this->type() != type_tag::integer )
+        throw std::invalid_argument( "The IMPORT array " + this->array_name + " is of type "
+                                   + this->array_type + ", expected integers" );
+
+    auto values = this->convert< int >();
+
+    /* Eclipse writes true as -1 */
+    if( this->array_type == "LOGI" ) {
+        for( auto& x : values ) x = x != 0 ? 1 : 0;
+    }
+
+    return values;
+}
+
+std::vector< double > BinaryImport::getDoubleData() const {
+    if( this->type() == type_tag::string || this->array_type == "LOGI" )
+        throw std::invalid_argument( "The IMPORT array " + this->array_name + " is of type "
+                                   + this->array_type + ", expected numbers" );
+
+    return this->convert< double >();
+}
+
+}
@@ -0,0 +1,660 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <boost/filesystem.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Parser/DeckCache.hpp>
+#include <opm/parser/eclipse/Parser/KeywordRegistry.hpp>
+#include <opm/parser/eclipse/Parser/MessageContainer.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+namespace Opm {
+
+namespace {
+
+const char magic[ 8 ] = { 'O', 'P', 'M', 'D', 'E', 'C', 'K', '\0' };
+const uint32_t format_version = 1;
+
+/* written as is, so that entries from a machine of other endianness are rejected */
+const uint32_t byte_order = 0x01020304;
+
+inline uint64_t mix( uint64_t x ) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/*
+ * A 64-bit hash that consumes 8 bytes at a time, so that hashing the input
+ * files is bound by reading them. Input given in several updates must come in
+ * multiples of 8 bytes, except for the last.
+ */
+class hasher {
+    public:
+        explicit hasher( uint64_t seed = 0 ) :
+            h( mix( seed ) ^ 0x9e3779b97f4a7c15ULL )
+        {}
+
+        void update( const char* data, size_t size ) {
+            this->length += size;
+
+            for( ; size >= 8; data += 8, size -= 8 ) {
+                uint64_t w;
+                std::memcpy( &w, data, 8 );
+                this->word( w );
+            }
+
+            if( size == 0 ) return;
+
+            uint64_t w = 0;
+            std::memcpy( &w, data, size );
+            this->word( w ^ ( uint64_t( size ) << 56 ) );
+        }
+
+        void update( const std::string& str ) {
+            this->update( uint64_t( str.size() ) );
+            this->update( str.data(), str.size() );
+        }
+
+        void update( uint64_t x ) {
+            this->word( x );
+        }
+
+        uint64_t digest() const {
+            return mix( this->h ^ this->length );
+        }
+
+    private:
+        uint64_t h;
+        uint64_t length = 0;
+
+        void word( uint64_t w ) {
+            this->h ^= mix( w );
+            this->h = ( ( this->h << 31 ) | ( this->h >> 33 ) ) * 0x9e3779b97f4a7c15ULL;
+        }
+};
+
+const uint64_t missing = uint64_t( -1 );
+
+struct input {
+    std::string path;
+    uint64_t size;
+    uint64_t hash;
+
+    bool operator==( const input& rhs ) const {
+        return this->path == rhs.path
+            && this->size == rhs.size
+            && this->hash == rhs.hash;
+    }
+};
+
+using file_ptr = std::unique_ptr< std::FILE, int (*)( std::FILE* ) >;
+
+file_ptr open( const boost::filesystem::path& path, const char* mode ) {
+    return file_ptr( std::fopen( path.string().c_str(), mode ), &std::fclose );
+}
+
+/* the size and content hash of the file, or a missing marker */
+input hash_input( const boost::filesystem::path& path ) {
+    input in{ path.string(), missing, 0 };
+
+    auto fp = open( path, "rb" );
+    if( !fp ) return in;
+
+    std::vector< char > buffer( size_t( 1 ) << 20 );
+    hasher h;
+    uint64_t size = 0;
+
+    while( true ) {
+        const auto readc = std::fread( buffer.data(), 1, buffer.size(), fp.get() );
+        h.update( buffer.data(), readc );
+        size += readc;
+        if( readc < buffer.size() ) break;
+    }
+
+    if( std::ferror( fp.get() ) )
+        throw std::runtime_error( "Error when reading input file '" + in.path + "'" );
+
+    in.size = size;
+    in.hash = h.digest();
+    return in;
+}
+
+/*
+ * Sizes and counts are written as LEB128 varints, and the names of keywords,
+ * items, files and dimensions as indices into a table of distinct names
+ * which is written in front of the deck.
+ */
+class writer {
+    public:
+        void u8( uint8_t x ) {
+            this->buffer.push_back( char( x ) );
+        }
+
+        void varint( uint64_t x ) {
+            while( x >= 0x80 ) {
+                this->u8( uint8_t( x ) | 0x80 );
+                x >>= 7;
+            }
+            this->u8( uint8_t( x ) );
+        }
+
+        void raw( const void* data, size_t size ) {
+            this->buffer.append( static_cast< const char* >( data ), size );
+        }
+
+        template< typename T >
+        void pod( const T& x ) {
+            this->raw( &x, sizeof( x ) );
+        }
+
+        void string( const std::string& str ) {
+            this->varint( str.size() );
+            this->raw( str.data(), str.size() );
+        }
+
+        void name( const std::string& str ) {
+            const auto itr = this->index.emplace( str, this->names.size() );
+            if( itr.second ) this->names.push_back( &itr.first->first );
+            this->varint( itr.first->second );
+        }
+
+        template< typename T, size_t N >
+        void values( const small_vector< T, N >& xs ) {
+            this->varint( xs.size() );
+            if( !xs.empty() ) this->raw( xs.data(), xs.size() * sizeof( T ) );
+        }
+
+        template< size_t N >
+        void values( const small_vector< std::string, N >& xs ) {
+            this->varint( xs.size() );
+            for( const auto& x : xs ) this->string( x );
+        }
+
+        std::string buffer;
+        std::vector< const std::string* > names;
+
+    private:
+        std::unordered_map< std::string, size_t > index;
+};
+
+class reader {
+    public:
+        reader( const char* first, const char* last ) :
+            pos( first ), end( last )
+        {}
+
+        uint8_t u8() {
+            this->need( 1 );
+            return uint8_t( *this->pos++ );
+        }
+
+        uint64_t varint() {
+            uint64_t x = 0;
+            for( int shift = 0; shift < 64; shift += 7 ) {
+                const auto b = this->u8();
+                x |= uint64_t( b & 0x7f ) << shift;
+                if( !( b & 0x80 ) ) return x;
+            }
+
+            throw std::runtime_error( "Malformed deck cache entry" );
+        }
+
+        void raw( void* dst, size_t size ) {
+            this->need( size );
+            std::memcpy( dst, this->pos, size );
+            this->pos += size;
+        }
+
+        template< typename T >
+        T pod() {
+            T x;
+            this->raw( &x, sizeof( x ) );
+            return x;
+        }
+
+        std::string string() {
+            const auto size = this->varint();
+            this->need( size );
+            std::string str( this->pos, size );
+            this->pos += size;
+            return str;
+        }
+
+        const InternedString& name() {
+            return this->names.at( this->varint() );
+        }
+
+        /*
+         * A count of things that take up at least size bytes each, checked
+         * against what is left so that a corrupt count doesn't allocate.
+         */
+        uint64_t count( size_t size = 1 ) {
+            const auto n = this->varint();
+            if( n > uint64_t( this->end - this->pos ) / size )
+                throw std::runtime_error( "Truncated deck cache entry" );
+            return n;
+        }
+
+        template< typename T >
+        std::vector< T > values() {
+            const auto size = this->count( sizeof( T ) );
+            std::vector< T > xs( size );
+            this->raw( xs.data(), size * sizeof( T ) );
+            return xs;
+        }
+
+        std::vector< std::string > strings() {
+            const auto size = this->count();
+            std::vector< std::string > xs;
+            xs.reserve( size );
+            for( size_t i = 0; i < size; ++i ) xs.push_back( this->string() );
+            return xs;
+        }
+
+        std::vector< InternedString > names;
+
+    private:
+        const char* pos;
+        const char* end;
+
+        void need( uint64_t size ) const {
+            if( uint64_t( this->end - this->pos ) < size )
+                throw std::runtime_error( "Truncated deck cache entry" );
+        }
+};
+
+enum item_flags : uint8_t {
+    repeated = 1,
+    defaulted = 2,
+};
+
+/* the scaling of a context dependent dimension is NaN, which getSIScaling refuses */
+double si_scaling( const Dimension& dim ) {
+    try {
+        return dim.getSIScaling();
+    } catch( const std::logic_error& ) {
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+}
+
+void write_item( writer& out, const DeckItem& item ) {
+    out.name( item.name() );
+    out.u8( uint8_t( item.getType() ) );
+    if( item.getType() == type_tag::unknown ) return;
+
+    out.u8( item.isDummyDefault() );
+
+    const auto& runs = item.getRuns();
+    out.varint( runs.size() );
+    for( const auto& r : runs ) {
+        out.varint( r.end - r.begin );
+        out.varint( r.offset );
+        out.u8( ( r.repeated ? repeated : 0 ) | ( r.defaulted ? defaulted : 0 ) );
+    }
+
+    switch( item.getType() ) {
+        case type_tag::integer:
+            out.values( item.getRunValues< int >() );
+            break;
+
+        case type_tag::string:
+            out.values( item.getRunValues< std::string >() );
+            break;
+
+        case type_tag::fdouble:
+            out.values( item.getRunValues< double >() );
+            out.varint( item.getDimensions().size() );
+            for( const auto& dim : item.getDimensions() ) {
+                out.name( dim->getName() );
+                out.pod( si_scaling( *dim ) );
+                out.pod( dim->getSIOffset() );
+            }
+            break;
+
+        default:
+            throw std::logic_error( "Unexpected item type" );
+    }
+}
+
+template< typename T >
+void read_values( reader& in, DeckItem& item, std::vector< DeckItem::run >&& runs ) {
+    auto values = in.values< T >();
+    if( !runs.empty() ) item.push_back( std::move( values ), std::move( runs ) );
+}
+
+void read_values( reader& in, DeckItem& item, std::vector< DeckItem::run >&& runs, std::string ) {
+    auto values = in.strings();
+    if( !runs.empty() ) item.push_back( std::move( values ), std::move( runs ) );
+}
+
+DeckItem read_item( reader& in ) {
+    const auto& name = in.name();
+    const auto type = type_tag( in.u8() );
+
+    switch( type ) {
+        case type_tag::unknown: return DeckItem( name );
+        case type_tag::integer: break;
+        case type_tag::string:  break;
+        case type_tag::fdouble: break;
+        default: throw std::runtime_error( "Malformed deck cache entry" );
+    }
+
+    DeckItem item = type == type_tag::integer ? DeckItem( name, int() )
+                  : type == type_tag::fdouble ? DeckItem( name, double() )
+                  : DeckItem( name, std::string() );
+
+    const bool dummy = in.u8();
+
+    std::vector< DeckItem::run > runs( in.count( 3 ) );
+    size_t begin = 0;
+    for( auto& r : runs ) {
+        const auto length = in.varint();
+        r.begin = begin;
+        r.end = begin + length;
+        r.offset = in.varint();
+        const auto flags = in.u8();
+        r.repeated = flags & repeated;
+        r.defaulted = flags & defaulted;
+        begin = r.end;
+    }
+
+    switch( type ) {
+        case type_tag::integer:
+            read_values< int >( in, item, std::move( runs ) );
+            break;
+
+        case type_tag::string:
+            read_values( in, item, std::move( runs ), std::string() );
+            break;
+
+        default:
+            read_values< double >( in, item, std::move( runs ) );
+            for( auto dims = in.count( 17 ); dims > 0; --dims ) {
+                const auto& dimName = in.name();
+                const auto factor = in.pod< double >();
+                const auto offset = in.pod< double >();
+                const auto dim = Dimension::newComposite( dimName, factor, offset );
+                item.push_backDimension( dim, dim );
+            }
+            break;
+    }
+
+    if( dummy ) item.push_backDummyDefault();
+    return item;
+}
+
+void write_deck( writer& out, const Deck& deck ) {
+    out.u8( uint8_t( deck.getDefaultUnitSystem().getType() ) );
+    out.u8( uint8_t( deck.getActiveUnitSystem().getType() ) );
+
+    const auto& messages = deck.getMessageContainer();
+    out.varint( messages.size() );
+    for( const auto& message : messages ) {
+        out.u8( uint8_t( message.mtype ) );
+        out.string( message.message );
+        out.name( message.location.filename );
+        out.varint( message.location.lineno );
+    }
+
+    out.varint( deck.size() );
+    for( const auto& keyword : deck ) {
+        out.name( keyword.name() );
+        out.name( keyword.getFileName() );
+        out.varint( uint64_t( int64_t( keyword.getLineNumber() ) ) );
+        out.u8( ( keyword.isKnown() ? 1 : 0 ) | ( keyword.isDataKeyword() ? 2 : 0 ) );
+
+        out.varint( keyword.size() );
+        for( const auto& record : keyword ) {
+            out.varint( record.size() );
+            for( const auto& item : record )
+                write_item( out, item );
+        }
+    }
+}
+
+UnitSystem read_units( reader& in ) {
+    switch( UnitSystem::UnitType( in.u8() ) ) {
+        case UnitSystem::UnitType::UNIT_TYPE_METRIC: return UnitSystem::newMETRIC();
+        case UnitSystem::UnitType::UNIT_TYPE_FIELD:  return UnitSystem::newFIELD();
+        case UnitSystem::UnitType::UNIT_TYPE_LAB:    return UnitSystem::newLAB();
+    }
+
+    throw std::runtime_error( "Malformed deck cache entry" );
+}
+
+/*
+ * Only the type of the unit systems is stored. The composite dimensions
+ * that were added to them while applying units are added again when needed.
+ */
+void read_deck( reader& in, Deck& deck ) {
+    deck.getDefaultUnitSystem() = read_units( in );
+    deck.getActiveUnitSystem() = read_units( in );
+
+    auto& messages = deck.getMessageContainer();
+    for( auto count = in.count( 4 ); count > 0; --count ) {
+        const auto mtype = Message::type( in.u8() );
+        auto text = in.string();
+        const auto& filename = in.name();
+        const auto lineno = in.varint();
+
+        if( lineno == 0 )
+            messages.add( Message( mtype, text ) );
+        else
+            messages.add( Message( mtype, text, Location( filename, lineno ) ) );
+    }
+
+    for( auto count = in.count( 5 ); count > 0; --count ) {
+        const auto& name = in.name();
+        const auto& filename = in.name();
+        const auto lineno = int( int64_t( in.varint() ) );
+        const auto flags = in.u8();
+
+        DeckKeyword keyword( name, bool( flags & 1 ) );
+        keyword.setLocation( filename, lineno );
+        keyword.setDataKeyword( flags & 2 );
+
+        for( auto records = in.count(); records > 0; --records ) {
+            std::vector< DeckItem > items;
+            items.reserve( in.count( 2 ) );
+            for( auto i = items.capacity(); i > 0; --i )
+                items.push_back( read_item( in ) );
+
+            keyword.addRecord( DeckRecord( std::move( items ) ) );
+        }
+
+        deck.addKeyword( std::move( keyword ) );
+    }
+}
+
+}
+
+DeckCache::DeckCache( boost::filesystem::path dir,
+                      const Parser& parser,
+                      const ParseContext& context ) :
+    directory( std::move( dir ) )
+{
+    hasher h( format_version );
+    for( const auto& name : parser.getAllDeckNames() )
+        h.update( name );
+
+    /*
+     * A keyword that is replaced by one with the same deck names but other
+     * items must miss too. The definitions of the default keywords are hashed
+     * by genkw, so that they are not built here.
+     */
+    if( parser.m_defaults )
+        h.update( parser.m_defaults->definitions() );
+
+    for( const auto& keyword : parser.keyword_storage )
+        h.update( keyword->createCode() );
+
+    for( const auto& key : context ) {
+        h.update( key.first );
+        h.update( uint64_t( key.second ) );
+    }
+
+    this->configuration = h.digest();
+}
+
+boost::filesystem::path DeckCache::entry( const boost::filesystem::path& dataFile ) const {
+    hasher h( this->configuration );
+    h.update( boost::filesystem::canonical( dataFile ).string() );
+
+    char name[ 32 ];
+    std::snprintf( name, sizeof( name ), "%016llx.deck",
+                   static_cast< unsigned long long >( h.digest() ) );
+
+    return this->directory / name;
+}
+
+/*
+ * The entry is read with a single read, and the inputs are hashed to check
+ * that they are unchanged before the deck is built. A corrupt or stale entry
+ * is simply a miss.
+ */
+bool DeckCache::load( const boost::filesystem::path& dataFile, Deck& deck ) const {
+    std::string buffer;
+
+    try {
+        const auto path = this->entry( dataFile );
+        auto fp = open( path, "rb" );
+        if( !fp ) return false;
+
+        std::fseek( fp.get(), 0, SEEK_END );
+        const auto size = std::ftell( fp.get() );
+        if( size <= 0 ) return false;
+        std::rewind( fp.get() );
+
+        buffer.resize( size );
+        if( std::fread( &buffer[ 0 ], 1, buffer.size(), fp.get() ) != buffer.size() )
+            return false;
+
+        reader in( buffer.data(), buffer.data() + buffer.size() );
+
+        char head[ sizeof( magic ) ];
+        in.raw( head, sizeof( head ) );
+        if( std::memcmp( head, magic, sizeof( magic ) ) != 0 ) return false;
+        if( in.pod< uint32_t >() != byte_order ) return false;
+        if( in.pod< uint32_t >() != format_version ) return false;
+        if( in.pod< uint64_t >() != this->configuration ) return false;
+
+        const auto root = boost::filesystem::canonical( dataFile ).string();
+        const auto inputs = in.varint();
+        for( uint64_t i = 0; i < inputs; ++i ) {
+            input recorded;
+            recorded.path = in.string();
+            recorded.size = in.varint();
+            recorded.hash = in.pod< uint64_t >();
+
+            if( i == 0 && recorded.path != root ) return false;
+            if( !( hash_input( recorded.path ) == recorded ) ) return false;
+        }
+
+        for( auto names = in.count(); names > 0; --names )
+            in.names.emplace_back( in.string() );
+
+        Deck cached;
+        read_deck( in, cached );
+        deck = std::move( cached );
+        return true;
+    } catch( const std::exception& ) {
+        return false;
+    }
+}
+
+void DeckCache::store( const boost::filesystem::path& dataFile,
+                       const std::vector< boost::filesystem::path >& inputs,
+                       const Deck& deck ) const {
+    try {
+        writer body;
+        write_deck( body, deck );
+
+        writer out;
+        out.raw( magic, sizeof( magic ) );
+        out.pod( byte_order );
+        out.pod( format_version );
+        out.pod( this->configuration );
+
+        /* files included more than once are only checked once */
+        std::set< boost::filesystem::path > seen;
+        std::vector< boost::filesystem::path > unique;
+        for( const auto& path : inputs ) {
+            if( seen.insert( path ).second ) unique.push_back( path );
+        }
+
+        if( unique.empty() || unique.front() != boost::filesystem::canonical( dataFile ) )
+            return;
+
+        out.varint( unique.size() );
+        for( const auto& path : unique ) {
+            const auto in = hash_input( path );
+            out.string( in.path );
+            out.varint( in.size );
+            out.pod( in.hash );
+        }
+
+        out.varint( body.names.size() );
+        for( const auto* name : body.names )
+            out.string( *name );
+
+        boost::filesystem::create_directories( this->directory );
+        const auto path = this->entry( dataFile );
+        const auto tmp = this->directory / boost::filesystem::unique_path( "%%%%%%%%%%%%.tmp" );
+
+        {
+            auto fp = open( tmp, "wb" );
+            if( !fp ) return;
+
+            const bool ok = std::fwrite( out.buffer.data(), 1, out.buffer.size(), fp.get() ) == out.buffer.size()
+                         && std::fwrite( body.buffer.data(), 1, body.buffer.size(), fp.get() ) == body.buffer.size()
+                         && std::fflush( fp.get() ) == 0;
+
+            if( !ok ) {
+                fp.reset();
+                boost::filesystem::remove( tmp );
+                return;
+            }
+        }
+
+        boost::filesystem::rename( tmp, path );
+    } catch( const std::exception& ) {
+        /* the cache is only an optimisation */
+    }
+}
+
+}
@@ -0,0 +1,141 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Parser/KeywordHash.hpp>
+
+namespace Opm {
+
+namespace {
+
+/* FNV-1a, seeded, with the murmur3 finalizer to spread short names */
+uint32_t hash( const string_view& name, uint32_t seed ) {
+    uint32_t h = 2166136261u ^ ( seed * 0x9e3779b9u );
+    for( const auto c : name ) {
+        h ^= static_cast< unsigned char >( c );
+        h *= 16777619u;
+    }
+
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/* about four names to a bucket */
+size_t num_buckets( size_t names ) {
+    return names / 4 + 1;
+}
+
+}
+
+const size_t KeywordHash::npos;
+
+KeywordHash::KeywordHash( std::vector< uint32_t > seeds,
+                          std::vector< string_view > names ) :
+    m_seeds( std::move( seeds ) ),
+    m_names( std::move( names ) )
+{
+    if( !this->m_names.empty()
+        && this->m_seeds.size() != num_buckets( this->m_names.size() ) )
+        throw std::invalid_argument( "Keyword hash seeds do not match the names" );
+}
+
+KeywordHash KeywordHash::build( const std::vector< std::string >& names ) {
+    const auto n = names.size();
+    if( n == 0 ) return KeywordHash();
+
+    /* equal names would never be placed apart */
+    auto sorted = names;
+    std::sort( sorted.begin(), sorted.end() );
+    if( std::adjacent_find( sorted.begin(), sorted.end() ) != sorted.end() )
+        throw std::invalid_argument( "Keyword names are not distinct" );
+
+    std::vector< std::vector< size_t > > buckets( num_buckets( n ) );
+    for( size_t i = 0; i < n; ++i )
+        buckets[ hash( names[ i ], 0 ) % buckets.size() ].push_back( i );
+
+    /* the largest buckets are the hardest to place, so they go first */
+    std::vector< size_t > order( buckets.size() );
+    for( size_t i = 0; i < order.size(); ++i ) order[ i ] = i;
+    std::stable_sort( order.begin(), order.end(), [&]( size_t lhs, size_t rhs ) {
+        return buckets[ lhs ].size() > buckets[ rhs ].size();
+    } );
+
+    std::vector< uint32_t > seeds( buckets.size(), 1 );
+    std::vector< string_view > slots( n );
+    std::vector< bool > taken( n, false );
+    std::vector< size_t > placed;
+
+    for( const auto b : order ) {
+        const auto& bucket = buckets[ b ];
+        if( bucket.empty() ) break;
+
+        for( uint32_t seed = 1; ; ++seed ) {
+            placed.clear();
+            for( const auto i : bucket ) {
+                const auto slot = hash( names[ i ], seed ) % n;
+                if( taken[ slot ] ) break;
+                taken[ slot ] = true;
+                placed.push_back( slot );
+            }
+
+            if( placed.size() == bucket.size() ) {
+                seeds[ b ] = seed;
+                for( size_t k = 0; k < bucket.size(); ++k )
+                    slots[ placed[ k ] ] = string_view( names[ bucket[ k ] ] );
+                break;
+            }
+
+            for( const auto slot : placed ) taken[ slot ] = false;
+        }
+    }
+
+    return KeywordHash( std::move( seeds ), std::move( slots ) );
+}
+
+size_t KeywordHash::find( const string_view& name ) const {
+    if( this->m_names.empty() ) return npos;
+
+    const auto seed = this->m_seeds[ hash( name, 0 ) % this->m_seeds.size() ];
+    const auto slot = hash( name, seed ) % this->m_names.size();
+
+    const auto& candidate = this->m_names[ slot ];
+    if( candidate.size() != name.size() ) return npos;
+
+    return candidate == name ? slot : npos;
+}
+
+size_t KeywordHash::size() const {
+    return this->m_names.size();
+}
+
+const std::vector< uint32_t >& KeywordHash::seeds() const {
+    return this->m_seeds;
+}
+
+const std::vector< string_view >& KeywordHash::names() const {
+    return this->m_names;
+}
+
+}
@@ -0,0 +1,104 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Parser/KeywordHash.hpp>
+#include <opm/parser/eclipse/Parser/KeywordRegistry.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+
+namespace Opm {
+
+KeywordRegistry::KeywordRegistry( const KeywordHash& hash,
+                                  const Descriptor* descriptors,
+                                  size_t count,
+                                  const uint32_t* slotKeywords,
+                                  uint64_t definitions ) :
+    m_hash( hash ),
+    m_descriptors( descriptors ),
+    m_size( count ),
+    m_slotKeywords( slotKeywords ),
+    m_definitions( definitions ),
+    m_keywords( new std::atomic< const ParserKeyword* >[ count ]() ),
+    m_built( 0 )
+{
+    for( size_t i = 0; i < count; ++i ) {
+        if( descriptors[ i ].matchRegex )
+            this->m_wildcards.push_back( &this->get( i ) );
+    }
+
+    std::sort( this->m_wildcards.begin(), this->m_wildcards.end(),
+               []( const ParserKeyword* lhs, const ParserKeyword* rhs ) {
+                   return lhs->getName() < rhs->getName();
+               } );
+}
+
+KeywordRegistry::~KeywordRegistry() {
+    for( size_t i = 0; i < this->m_size; ++i )
+        delete this->m_keywords[ i ].load();
+}
+
+const KeywordHash& KeywordRegistry::hash() const {
+    return this->m_hash;
+}
+
+size_t KeywordRegistry::size() const {
+    return this->m_size;
+}
+
+const KeywordRegistry::Descriptor& KeywordRegistry::descriptor( size_t index ) const {
+    return this->m_descriptors[ index ];
+}
+
+uint64_t KeywordRegistry::definitions() const {
+    return this->m_definitions;
+}
+
+const ParserKeyword& KeywordRegistry::get( size_t index ) const {
+    if( index >= this->m_size )
+        throw std::out_of_range( "No keyword " + std::to_string( index ) + " in the registry" );
+
+    auto& slot = this->m_keywords[ index ];
+    if( const auto* keyword = slot.load( std::memory_order_acquire ) )
+        return *keyword;
+
+    std::lock_guard< std::mutex > lock( this->m_mutex );
+    if( const auto* keyword = slot.load( std::memory_order_relaxed ) )
+        return *keyword;
+
+    const auto* keyword = this->m_descriptors[ index ].make();
+    slot.store( keyword, std::memory_order_release );
+    ++this->m_built;
+    return *keyword;
+}
+
+const ParserKeyword& KeywordRegistry::getSlot( size_t slot ) const {
+    return this->get( this->m_slotKeywords[ slot ] );
+}
+
+const std::vector< const ParserKeyword* >& KeywordRegistry::wildcards() const {
+    return this->m_wildcards;
+}
+
+size_t KeywordRegistry::built() const {
+    return this->m_built;
+}
+
+}
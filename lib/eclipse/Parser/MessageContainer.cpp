@@ -24,12 +24,12 @@
 
 namespace Opm {
 
-    Location::Location( const std::string& fn, size_t ln ) :
+    Location::Location( InternedString fn, size_t ln ) :
         filename( fn ), lineno( ln )
     {
         if( ln == 0 )
             throw std::invalid_argument( "Invalid line number 0 for file '"
-                                         + fn + "'" );
+                                         + fn.string() + "'" );
     }
 
     void MessageContainer::error( const std::string& msg,
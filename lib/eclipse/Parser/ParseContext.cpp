@@ -63,6 +63,8 @@ namespace Opm {
         addKey(PARSE_MISSING_DIMS_KEYWORD);
         addKey(PARSE_EXTRA_DATA);
         addKey(PARSE_MISSING_INCLUDE);
+        addKey(PARSE_IMPORT_NON_DATA);
+        updateKey(PARSE_IMPORT_NON_DATA, InputError::WARN);
 
         addKey(UNSUPPORTED_SCHEDULE_GEO_MODIFIER);
         addKey(UNSUPPORTED_COMPORD_TYPE);
@@ -238,6 +240,7 @@ namespace Opm {
     const std::string ParseContext::PARSE_MISSING_DIMS_KEYWORD = "PARSE_MISSING_DIMS_KEYWORD";
     const std::string ParseContext::PARSE_EXTRA_DATA = "PARSE_EXTRA_DATA";
     const std::string ParseContext::PARSE_MISSING_INCLUDE = "PARSE_MISSING_INCLUDE";
+    const std::string ParseContext::PARSE_IMPORT_NON_DATA = "PARSE_IMPORT_NON_DATA";
 
     const std::string ParseContext::UNSUPPORTED_SCHEDULE_GEO_MODIFIER = "UNSUPPORTED_SCHEDULE_GEO_MODIFIER";
     const std::string ParseContext::UNSUPPORTED_COMPORD_TYPE = "UNSUPPORTED_COMPORD_TYPE";
@@ -0,0 +1,155 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <opm/parser/eclipse/Parser/ParseProfile.hpp>
+
+namespace Opm {
+
+namespace {
+
+thread_local ParseProfile::Entry* current_sample = nullptr;
+thread_local size_t allocation_count = 0;
+
+std::vector< ParseProfile::Entry > top( const std::map< std::string, ParseProfile::Entry >& entries,
+                                        size_t n ) {
+    std::vector< ParseProfile::Entry > sorted;
+    sorted.reserve( entries.size() );
+    for( const auto& entry : entries ) sorted.push_back( entry.second );
+
+    n = std::min( n, sorted.size() );
+    std::partial_sort( sorted.begin(), sorted.begin() + n, sorted.end(),
+        []( const ParseProfile::Entry& lhs, const ParseProfile::Entry& rhs ) {
+            return lhs.totalSeconds() > rhs.totalSeconds();
+        } );
+
+    sorted.resize( n );
+    return sorted;
+}
+
+}
+
+double ParseProfile::Entry::totalSeconds() const {
+    return this->seconds + this->unitSeconds + this->readSeconds;
+}
+
+void ParseProfile::Entry::add( const Entry& other ) {
+    this->keywords += other.keywords;
+    this->bytes += other.bytes;
+    this->records += other.records;
+    this->items += other.items;
+    this->allocations += other.allocations;
+    this->seconds += other.seconds;
+    this->recordSeconds += other.recordSeconds;
+    this->unitSeconds += other.unitSeconds;
+    this->readSeconds += other.readSeconds;
+}
+
+const std::map< std::string, ParseProfile::Entry >& ParseProfile::getKeywords() const {
+    return this->keywords;
+}
+
+const std::map< std::string, ParseProfile::Entry >& ParseProfile::getFiles() const {
+    return this->files;
+}
+
+std::vector< ParseProfile::Entry > ParseProfile::topKeywords( size_t n ) const {
+    return top( this->keywords, n );
+}
+
+std::vector< ParseProfile::Entry > ParseProfile::topFiles( size_t n ) const {
+    return top( this->files, n );
+}
+
+double ParseProfile::getTotalSeconds() const {
+    return this->totalSeconds;
+}
+
+double ParseProfile::getReadSeconds() const {
+    return this->readSeconds;
+}
+
+double ParseProfile::getUnitSeconds() const {
+    return this->unitSeconds;
+}
+
+void ParseProfile::addKeyword( const std::string& file, const Entry& sample ) {
+    std::lock_guard< std::mutex > lock( this->mutex );
+
+    auto& keyword = this->keywords[ sample.name ];
+    keyword.name = sample.name;
+    keyword.add( sample );
+
+    auto& in = this->files[ file ];
+    in.name = file;
+    in.add( sample );
+}
+
+void ParseProfile::addRead( const std::string& file, double seconds ) {
+    std::lock_guard< std::mutex > lock( this->mutex );
+
+    auto& in = this->files[ file ];
+    in.name = file;
+    in.readSeconds += seconds;
+    this->readSeconds += seconds;
+}
+
+void ParseProfile::addUnits( const std::string& keyword,
+                             const std::string& file,
+                             double seconds ) {
+    std::lock_guard< std::mutex > lock( this->mutex );
+
+    this->keywords[ keyword ].unitSeconds += seconds;
+    this->files[ file ].unitSeconds += seconds;
+    this->unitSeconds += seconds;
+}
+
+void ParseProfile::setTotalSeconds( double seconds ) {
+    this->totalSeconds = seconds;
+}
+
+double ParseProfile::since( clock::time_point start ) {
+    return std::chrono::duration< double >( clock::now() - start ).count();
+}
+
+ParseProfile::Scope::Scope( Entry& s ) :
+    sample( s ),
+    previous( current_sample ),
+    allocations( allocation_count ),
+    start( clock::now() )
+{
+    current_sample = &this->sample;
+}
+
+ParseProfile::Scope::~Scope() {
+    this->sample.seconds += since( this->start );
+    this->sample.allocations += allocation_count - this->allocations;
+    current_sample = this->previous;
+}
+
+ParseProfile::Entry* ParseProfile::current() {
+    return current_sample;
+}
+
+void ParseProfile::countAllocation() {
+    ++allocation_count;
+}
+
+}
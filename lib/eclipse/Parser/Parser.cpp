@@ -17,9 +17,19 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <set>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -33,17 +43,35 @@
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/Parser/BinaryImport.hpp>
+#include <opm/parser/eclipse/Parser/DeckCache.hpp>
+#include <opm/parser/eclipse/Parser/KeywordHash.hpp>
+#include <opm/parser/eclipse/Parser/KeywordRegistry.hpp>
+#include <opm/parser/eclipse/Parser/MessageContainer.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/ParseProfile.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
+#include <opm/parser/eclipse/RawDeck/Lexer.hpp>
 #include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 #include <opm/parser/eclipse/RawDeck/RawEnums.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
 #include <opm/parser/eclipse/RawDeck/StarToken.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <opm/parser/eclipse/Utility/MappedFile.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
+#include <opm/parser/eclipse/Utility/ThreadPool.hpp>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 
 namespace Opm {
 
@@ -85,185 +113,1198 @@ inline Itr find_terminator( Itr begin, Itr end, Term terminator ) {
     return find_terminator( qend + 1, end, terminator );
 }
 
-/**
-    This function will return a copy of the input string where all
-    characters following '--' are removed. The copy is a view and relies on
-    the source string to remain alive. The function handles quoting with
-    single quotes and double quotes:
+inline bool getline( string_view& input, string_view& line ) {
+    if( input.empty() ) return false;
 
-    ABC --Comment                =>  ABC
-    ABC '--Comment1' --Comment2  =>  ABC '--Comment1'
-    ABC "-- Not balanced quote?  =>  ABC "-- Not balanced quote?
-*/
-static inline string_view strip_comments( string_view str ) {
-    return { str.begin(),
-             find_terminator( str.begin(), str.end(), find_comment() ) };
+    auto end = std::find( input.begin(), input.end(), '\n' );
+
+    line = string_view( input.begin(), end );
+    input = end == input.end()
+          ? string_view( end, end )
+          : string_view( end + 1, input.end() );
+    return true;
 }
 
-template< typename Itr >
-inline Itr trim_left( Itr begin, Itr end ) {
-    return std::find_if_not( begin, end, RawConsts::is_separator() );
+inline std::string clean( string_view str ) {
+    std::string dst( str.size(), '\0' );
+    const auto* last = lexer::clean( str, &dst[ 0 ] );
+    dst.resize( std::distance( dst.data(), last ) );
+    return dst;
 }
 
-template< typename Itr >
-inline Itr trim_right( Itr begin, Itr end ) {
+/*
+ * A cleaned input file, backed either by a mapping of the file or by a buffer
+ * with its contents. The cleaned input is the first size bytes.
+ *
+ * A mapped file can also be cleaned lazily, a chunk at a time, and the pages
+ * that have been consumed released again. Every chunk is cleaned in place
+ * right after the previous one, so the cleaned input stays contiguous and
+ * keywords can span chunks. This keeps the memory use of a streaming parse
+ * independent of the input size.
+ */
+struct input_file {
+    MappedFile mapping;
+    std::string buffer;
+    size_t size = 0;
+    size_t raw = 0;
+    size_t released = 0;
+
+    static constexpr size_t chunk_size = size_t( 1 ) << 24;
+
+    string_view input() const {
+        const char* data = this->mapping ? this->mapping.data() : this->buffer.data();
+        return { data, data + this->size };
+    }
+
+    bool exhausted() const {
+        return this->raw == this->mapping.size();
+    }
+
+    /*
+     * Clean the next chunk, which ends on a line boundary, and return the
+     * newly cleaned input.
+     */
+    string_view clean_more() {
+        auto* data = this->mapping.data();
+        const auto* first = data + this->raw;
+        const auto* end = data + this->mapping.size();
+        const size_t left = this->mapping.size() - this->raw;
+        const auto* last = first + ( left < chunk_size ? left : chunk_size );
+
+        if( last != end ) {
+            const void* nl = std::memchr( last, '\n', end - last );
+            last = nl ? static_cast< const char* >( nl ) + 1 : end;
+        }
+
+        auto* dst = data + this->size;
+        const auto* dst_end = lexer::clean( { first, last }, dst );
+        this->raw = last - data;
+        this->size = dst_end - data;
+
+        /* the raw input between the cleaned and raw ends has been read */
+        this->mapping.discard( this->size, this->raw );
+        return { dst, dst_end };
+    }
+
+    /* everything before pos has been consumed, and will not be read again */
+    void release( const char* pos ) {
+        if( !this->mapping ) return;
+
+        const size_t offset = pos - this->mapping.data();
+        if( offset <= this->released ) return;
 
-    std::reverse_iterator< Itr > rbegin( end );
-    std::reverse_iterator< Itr > rend( begin );
+        this->released = this->mapping.discard( this->released, offset );
+    }
+};
+
+/*
+ * Compressed input is recognised by its magic bytes, regardless of the file
+ * name.
+ */
+enum class compression { none, gzip, zstd };
+
+compression compression_of( const char* data, size_t size ) {
+    const auto* bytes = reinterpret_cast< const unsigned char* >( data );
+
+    if( size >= 2 && bytes[ 0 ] == 0x1f && bytes[ 1 ] == 0x8b )
+        return compression::gzip;
 
-    return std::find_if_not( rbegin, rend, RawConsts::is_separator() ).base();
+    if( size >= 4 && bytes[ 0 ] == 0x28 && bytes[ 1 ] == 0xb5
+                  && bytes[ 2 ] == 0x2f && bytes[ 3 ] == 0xfd )
+        return compression::zstd;
+
+    return compression::none;
 }
 
-inline string_view trim( string_view str ) {
-    auto fst = trim_left( str.begin(), str.end() );
-    auto lst = trim_right( fst, str.end() );
-    return { fst, lst };
+/*
+ * Decompress into the buffer a block at a time, and clean every block, up to
+ * its last complete line, right behind the input cleaned so far. The
+ * incomplete line is moved down and completed by the next block, so the
+ * decompressed input is never held in full, and the cleaned input stays the
+ * same as if the file was cleaned in one go.
+ *
+ * The source fills up to n bytes and returns how many it wrote, or 0 at the
+ * end of the input.
+ */
+template< typename Source >
+size_t clean_decompressed( Source&& source, std::string& buffer ) {
+    const size_t block_size = size_t( 1 ) << 20;
+    size_t size = 0;
+    size_t raw = 0;
+
+    while( true ) {
+        if( buffer.size() < raw + block_size ) buffer.resize( raw + block_size );
+
+        const size_t n = source( &buffer[ raw ], block_size );
+        raw += n;
+
+        auto* data = &buffer[ 0 ];
+        const char* first = data + size;
+        const char* end = data + raw;
+        const char* last = end;
+
+        if( n > 0 ) {
+            using rev = std::reverse_iterator< const char* >;
+            last = std::find( rev( end ), rev( first ), '\n' ).base();
+        }
+
+        auto* dst_end = lexer::clean( { first, last }, data + size );
+        std::memmove( dst_end, last, end - last );
+        size = dst_end - data;
+        raw = size + ( end - last );
+
+        if( n == 0 ) break;
+    }
+
+    buffer.resize( size );
+    return size;
 }
 
-inline string_view strip_slash( string_view view ) {
-    using itr = string_view::const_iterator;
-    const auto term = []( itr begin, itr end ) {
-        return std::find( begin, end, '/' );
-    };
+#ifdef HAVE_ZLIB
+
+/*
+ * zlib takes at most a uInt of input at a time, so the input is fed to it in
+ * slices. Zeros after the last member are padding, which gzip(1) ignores as
+ * well.
+ */
+struct gzip_source {
+    gzip_source( const char* data, size_t size, const std::string& p ) :
+        end( data + size ),
+        path( p )
+    {
+        this->stream.next_in = reinterpret_cast< Bytef* >( const_cast< char* >( data ) );
+        this->stream.avail_in = 0;
 
-    auto begin = view.begin();
-    auto end = view.end();
-    auto slash = find_terminator( begin, end, term );
+        /* adding 32 to the window bits makes zlib expect a gzip header */
+        if( inflateInit2( &this->stream, 15 + 32 ) != Z_OK )
+            throw std::runtime_error( "Could not initialise zlib" );
+    }
+
+    gzip_source( const gzip_source& ) = delete;
+
+    ~gzip_source() {
+        inflateEnd( &this->stream );
+    }
+
+    /* the input that zlib has not consumed yet */
+    const char* rest() const {
+        return reinterpret_cast< const char* >( this->stream.next_in );
+    }
 
-    /* we want to preserve terminating slashes */
-    if( slash != end ) ++slash;
+    void feed() {
+        if( this->stream.avail_in > 0 ) return;
 
-    return { begin, slash };
+        const size_t remaining = this->end - this->rest();
+        this->stream.avail_in = uInt( std::min< size_t >( remaining, std::numeric_limits< uInt >::max() ) );
+    }
+
+    size_t operator()( char* dst, size_t n ) {
+        this->stream.next_out = reinterpret_cast< Bytef* >( dst );
+        this->stream.avail_out = uInt( n );
+
+        while( this->stream.avail_out > 0 && !this->finished ) {
+            this->feed();
+
+            if( this->ended ) {
+                const auto padding = std::all_of( this->rest(), this->end,
+                                                  []( char c ) { return c == 0; } );
+                if( padding ) {
+                    this->finished = true;
+                    break;
+                }
+
+                /* a gzip file can be several compressed files concatenated */
+                inflateReset( &this->stream );
+                this->ended = false;
+            }
+
+            const auto status = inflate( &this->stream, Z_NO_FLUSH );
+            if( status == Z_STREAM_END ) this->ended = true;
+            else if( status != Z_OK )
+                throw std::runtime_error( "Error when decompressing input file '"
+                                        + this->path + "'" );
+        }
+
+        return n - this->stream.avail_out;
+    }
+
+    z_stream stream = z_stream();
+    const char* end;
+    std::string path;
+    bool ended = false;
+    bool finished = false;
+};
+
+#endif
+
+#ifdef HAVE_ZSTD
+
+struct zstd_source {
+    zstd_source( const char* data, size_t size, const std::string& p ) :
+        stream( ZSTD_createDStream() ),
+        path( p )
+    {
+        if( !this->stream || ZSTD_isError( ZSTD_initDStream( this->stream ) ) )
+            throw std::runtime_error( "Could not initialise zstd" );
+
+        this->input = { data, size, 0 };
+    }
+
+    zstd_source( const zstd_source& ) = delete;
+
+    ~zstd_source() {
+        ZSTD_freeDStream( this->stream );
+    }
+
+    size_t operator()( char* dst, size_t n ) {
+        ZSTD_outBuffer output = { dst, n, 0 };
+
+        while( output.pos < output.size ) {
+            /* a hint of 0 means the frame is complete and flushed */
+            const bool consumed = this->input.pos == this->input.size;
+            if( consumed && this->hint == 0 ) break;
+
+            const auto written = output.pos;
+            this->hint = ZSTD_decompressStream( this->stream, &output, &this->input );
+
+            if( ZSTD_isError( this->hint ) || ( consumed && output.pos == written ) )
+                throw std::runtime_error( "Error when decompressing input file '"
+                                        + this->path + "'" );
+        }
+
+        return output.pos;
+    }
+
+    ZSTD_DStream* stream;
+    ZSTD_inBuffer input;
+    size_t hint = 1;
+    std::string path;
+};
+
+#endif
+
+size_t decompress( compression kind,
+                   const boost::filesystem::path& path,
+                   const char* data, size_t size,
+                   std::string& buffer ) {
+#ifdef HAVE_ZLIB
+    if( kind == compression::gzip )
+        return clean_decompressed( gzip_source( data, size, path.string() ), buffer );
+#endif
+
+#ifdef HAVE_ZSTD
+    if( kind == compression::zstd )
+        return clean_decompressed( zstd_source( data, size, path.string() ), buffer );
+#endif
+
+    /* not used when built without any decompression library */
+    (void) data; (void) size; (void) buffer;
+
+    throw std::runtime_error( "Input file '" + path.string() + "' is "
+                            + ( kind == compression::gzip ? "gzip" : "zstd" )
+                            + " compressed, which this build does not support" );
 }
 
-inline bool getline( string_view& input, string_view& line ) {
-    if( input.empty() ) return false;
+/*
+ * Read and clean the file. The file is mapped and cleaned in place if
+ * possible, and lazily if requested. Compressed files are decompressed and
+ * cleaned a block at a time into the buffer, and the mapping of the
+ * compressed file is released again. Returns false if the file can't be
+ * opened, and throws if reading it fails.
+ */
+bool read_input( const boost::filesystem::path& path, input_file& dst, bool lazy = false ) {
+    dst.mapping = MappedFile( path.string() );
 
-    auto end = std::find( input.begin(), input.end(), '\n' );
+    if( dst.mapping ) {
+        const auto* data = dst.mapping.data();
+        const auto kind = compression_of( data, dst.mapping.size() );
 
-    line = string_view( input.begin(), end );
-    input = string_view( end + 1, input.end() );
+        if( kind != compression::none ) {
+            dst.size = decompress( kind, path, data, dst.mapping.size(), dst.buffer );
+            dst.mapping = MappedFile();
+            return true;
+        }
+    }
+
+    if( dst.mapping && lazy ) return true;
+
+    if( dst.mapping ) {
+        auto* data = dst.mapping.data();
+        dst.size = lexer::clean( { data, data + dst.mapping.size() }, data ) - data;
+        dst.raw = dst.mapping.size();
+        return true;
+    }
+
+    const auto closer = []( std::FILE* f ) { std::fclose( f ); };
+    std::unique_ptr< std::FILE, decltype( closer ) > ufp(
+            std::fopen( path.string().c_str(), "rb" ),
+            closer
+            );
+
+    if( !ufp ) return false;
+
+    /*
+     * read the input file C-style. This is done for performance
+     * reasons, as streams are slow
+     */
+
+    auto* fp = ufp.get();
+    auto& buffer = dst.buffer;
+    std::fseek( fp, 0, SEEK_END );
+    buffer.resize( std::ftell( fp ) );
+    std::rewind( fp );
+    const auto readc = std::fread( &buffer[ 0 ], 1, buffer.size(), fp );
+
+    if( std::ferror( fp ) || readc != buffer.size() )
+        throw std::runtime_error( "Error when reading input file '"
+                                + path.string() + "'" );
+
+    const auto kind = compression_of( buffer.data(), buffer.size() );
+    if( kind != compression::none ) {
+        const auto compressed = std::move( buffer );
+        buffer.clear();
+        dst.size = decompress( kind, path, compressed.data(), compressed.size(), buffer );
+        return true;
+    }
+
+    buffer.resize( std::distance( &buffer[ 0 ], lexer::clean( buffer, &buffer[ 0 ] ) ) );
+    dst.size = buffer.size();
     return true;
+}
+
+/*
+ * The canonical path of an input file. Archived decks are often compressed in
+ * place, so if the file is missing, its .gz or .zst sibling is used instead.
+ * Throws filesystem_error if none of them exist.
+ */
+boost::filesystem::path resolve_input( const boost::filesystem::path& path ) {
+    boost::system::error_code ec;
+    const auto canonical = boost::filesystem::canonical( path, ec );
+    if( !ec ) return canonical;
+
+    for( const auto* ext : { ".gz", ".zst" } ) {
+        const boost::filesystem::path compressed( path.string() + ext );
+        if( boost::filesystem::exists( compressed ) )
+            return boost::filesystem::canonical( compressed );
+    }
+
+    return boost::filesystem::canonical( path );
+}
+
+/*
+ * Substitute the $ALIAS (from PATHS), if any, replace backslashes with
+ * slashes and make relative paths relative to root. Throws std::out_of_range
+ * if the alias is unknown.
+ */
+boost::filesystem::path include_path( std::string path,
+                                      const std::map< std::string, std::string >& aliases,
+                                      const boost::filesystem::path& root ) {
+    static const std::string pathKeywordPrefix("$");
+    static const std::string validPathNameCharacters("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+
+    size_t positionOfPathName = path.find(pathKeywordPrefix);
+
+    if ( positionOfPathName != std::string::npos) {
+        std::string stringStartingAtPathName = path.substr(positionOfPathName+1);
+        size_t cutOffPosition = stringStartingAtPathName.find_first_not_of(validPathNameCharacters);
+        std::string stringToFind = stringStartingAtPathName.substr(0, cutOffPosition);
+        std::string stringToReplace = aliases.at( stringToFind );
+        boost::replace_all(path, pathKeywordPrefix + stringToFind, stringToReplace);
+    }
+
+    std::replace(path.begin(), path.end(), '\\', '/');
+
+    boost::filesystem::path includeFilePath(path);
+
+    if (includeFilePath.is_relative())
+        return root / includeFilePath;
+
+    return includeFilePath;
+}
+
+/*
+ * An INCLUDE or PATHS record found by scan_includes. The alias is only set for
+ * PATHS records.
+ */
+struct include_directive {
+    std::string alias;
+    std::string path;
+};
+
+/*
+ * Cheaply find the INCLUDE and PATHS records in a cleaned input buffer, without
+ * parsing it. Only records that start on the line after the keyword are
+ * found, and records that span several lines are skipped. Missing something
+ * is harmless, it just means the file isn't prefetched.
+ */
+std::vector< include_directive > scan_includes( string_view input ) {
+    std::vector< include_directive > found;
+    std::vector< string_view > tokens;
+
+    enum { none, include, paths } state = none;
+    string_view line;
+    while( getline( input, line ) ) {
+        if( line.empty() ) continue;
+
+        if( state == none ) {
+            /* keyword lines are rare, and only INCLUDE and PATHS are interesting */
+            if( line.front() != 'I' && line.front() != 'P' ) continue;
+
+            const auto name = ParserKeyword::getDeckName( line );
+            if( name == RawConsts::include ) state = include;
+            else if( name == RawConsts::paths ) state = paths;
+            continue;
+        }
+
+        const bool terminated = line.back() == RawConsts::slash;
+        if( terminated ) line = string_view( line.begin(), line.end() - 1 );
+
+        tokens.clear();
+        lexer::tokenize( line, tokens );
+
+        if( state == include ) {
+            if( !tokens.empty() )
+                found.push_back( { "", readValueToken< std::string >( tokens[ 0 ] ) } );
+
+            state = none;
+            continue;
+        }
+
+        if( tokens.size() < 2 || !terminated ) {
+            state = none;
+            continue;
+        }
+
+        found.push_back( { readValueToken< std::string >( tokens[ 0 ] ),
+                           readValueToken< std::string >( tokens[ 1 ] ) } );
+    }
+
+    return found;
+}
+
+/*
+ * A file that has been read and cleaned ahead of time, together with its own
+ * INCLUDE and PATHS records. If anything went wrong, ok is false and the file
+ * should be loaded again in the parser thread, which reports the error
+ * properly.
+ */
+struct prefetched_file {
+    boost::filesystem::path path;
+    input_file file;
+    std::vector< include_directive > includes;
+    double seconds = 0;
+    bool ok = false;
+};
+
+prefetched_file prefetch_file( const boost::filesystem::path& path ) {
+    prefetched_file result;
+    const auto start = ParseProfile::clock::now();
+
+    try {
+        result.path = resolve_input( path );
+        result.ok = read_input( result.path, result.file );
+        if( result.ok ) result.includes = scan_includes( result.file.input() );
+    } catch( const std::exception& ) {
+        result.ok = false;
+    }
+
+    result.seconds = ParseProfile::since( start );
+    return result;
+}
+
+/*
+ * An include is tagged with the depth in the input stack of the file it was
+ * found in. Once that file is closed the parser won't ask for the include,
+ * so if it hasn't been picked up by then it never will be.
+ */
+struct queued_include {
+    std::string path;
+    size_t depth;
+};
+
+struct prefetch_entry {
+    std::future< prefetched_file > file;
+    size_t depth;
+};
+
+const std::string emptystr = "";
+
+struct file {
+    file( boost::filesystem::path p, string_view in ) :
+        input( in ), path( p )
+    {}
+
+    string_view input;
+    size_t lineNR = 0;
+    boost::filesystem::path path;
+    input_file* source = nullptr;
+};
+
+class InputStack : public std::stack< file, std::vector< file > > {
+    public:
+        void push( std::string&& input, boost::filesystem::path p = "" );
+        void push( input_file&& input, boost::filesystem::path p );
+
+        /*
+         * All the input that has been pushed. Lazy keywords refer to the
+         * input, and share it to keep it alive.
+         */
+        std::shared_ptr< const void > storage() const;
+
+    private:
+        struct input_storage {
+            std::list< std::string > strings;
+            std::list< input_file > files;
+        };
+
+        std::shared_ptr< input_storage > store = std::make_shared< input_storage >();
+        using base = std::stack< file, std::vector< file > >;
+};
+
+void InputStack::push( std::string&& input, boost::filesystem::path p ) {
+    this->store->strings.push_back( std::move( input ) );
+    this->emplace( p, this->store->strings.back() );
+}
+
+void InputStack::push( input_file&& input, boost::filesystem::path p ) {
+    this->store->files.push_back( std::move( input ) );
+    this->emplace( p, this->store->files.back().input() );
+    this->top().source = &this->store->files.back();
+}
+
+std::shared_ptr< const void > InputStack::storage() const {
+    return this->store;
+}
+
+/*
+ * The unit systems of the deck are only known when it has been parsed, so
+ * lazy keywords apply them when they are parsed. getNewDimension caches the
+ * dimensions it creates, so the unit systems are guarded.
+ */
+struct deck_units {
+    std::mutex mutex;
+    UnitSystem active;
+    UnitSystem defaults;
+};
+
+/* store the values of the items with units in SI */
+void store_si( DeckKeyword& keyword ) {
+    for( size_t i = 0; i < keyword.size(); ++i ) {
+        auto& record = keyword.getRecord( i );
+        for( size_t j = 0; j < record.size(); ++j ) {
+            auto& item = record.getItem( j );
+            if( !item.getDimensions().empty() ) item.convertToSI();
+        }
+    }
+}
+
+/*
+ * Apply the units to the keyword and store its values in SI. Only looking up
+ * the dimensions needs the lock, the conversion does not.
+ */
+void convert_to_si( const ParserKeyword& parserKeyword,
+                    deck_units& units,
+                    DeckKeyword& keyword ) {
+    if( !parserKeyword.hasDimension() ) return;
+
+    {
+        std::lock_guard< std::mutex > lock( units.mutex );
+        parserKeyword.applyUnitsToDeck( units.active, units.defaults, keyword );
+    }
+
+    store_si( keyword );
+}
+
+/*
+ * The source of a lazy keyword: the raw keyword, whose records are not even
+ * split into items yet, and everything needed to parse it later.
+ *
+ * Messages from the parse are dropped, but errors are still handled
+ * according to the parse context, which may mean that an exception is thrown
+ * when the keyword is first accessed.
+ */
+class lazy_keyword : public DeckKeyword::Source {
+    public:
+        lazy_keyword( const ParserKeyword& kw,
+                      std::shared_ptr< const RawKeyword > rawKeyword,
+                      std::shared_ptr< const ParseContext > context,
+                      std::shared_ptr< deck_units > units,
+                      bool si,
+                      std::shared_ptr< const void > input,
+                      std::shared_ptr< const void > keywords ) :
+            parserKeyword( kw ),
+            raw( std::move( rawKeyword ) ),
+            parseContext( std::move( context ) ),
+            deckUnits( std::move( units ) ),
+            storeSI( si ),
+            storage( std::move( input ) ),
+            definitions( std::move( keywords ) )
+        {}
+
+        size_t size() const override {
+            return this->raw->size();
+        }
+
+        /* parsing consumes the raw keyword, so every parse gets a copy */
+        DeckKeyword parse() const override {
+            MessageContainer messages;
+            auto keyword = this->parserKeyword.parse( *this->parseContext,
+                                                      messages,
+                                                      std::make_shared< RawKeyword >( *this->raw ) );
+
+            if( this->storeSI ) {
+                convert_to_si( this->parserKeyword, *this->deckUnits, keyword );
+            } else if( this->parserKeyword.hasDimension() ) {
+                std::lock_guard< std::mutex > lock( this->deckUnits->mutex );
+                this->parserKeyword.applyUnitsToDeck( this->deckUnits->active,
+                                                      this->deckUnits->defaults,
+                                                      keyword );
+            }
+
+            return keyword;
+        }
+
+    private:
+        const ParserKeyword& parserKeyword;
+        std::shared_ptr< const RawKeyword > raw;
+        std::shared_ptr< const ParseContext > parseContext;
+        std::shared_ptr< deck_units > deckUnits;
+        bool storeSI;
+        std::shared_ptr< const void > storage;
+        std::shared_ptr< const void > definitions;
+};
+
+/*
+ * A position in the input that the parser has read past. Used to release
+ * input that is no longer referred to by any keyword.
+ */
+struct input_mark {
+    input_file* source = nullptr;
+    const char* pos = nullptr;
+};
+
+class ParserState {
+    public:
+        ParserState( const ParseContext& );
+        ParserState( const ParseContext&, boost::filesystem::path, ParseProfile* = nullptr );
+
+        void loadString( string_view );
+        void loadFile( const boost::filesystem::path& );
+        void importFile( const boost::filesystem::path&, BinaryImport::Format,
+                         const Parser&, const RawKeyword& );
+        void openRootFile( const boost::filesystem::path& );
+
+        void handleRandomText(const string_view& );
+        boost::filesystem::path getIncludeFilePath( std::string );
+        void addPathAlias( const std::string& alias, const std::string& path );
+
+        const boost::filesystem::path& current_path() const;
+        size_t line() const;
+
+        bool done() const;
+        string_view getline();
+        void closeFile();
+
+        void setThreadCount( size_t );
+        void setOutput( std::function< void( DeckKeyword&& ) > );
+        void setLazy( std::set< std::string > eager,
+                      const std::vector< std::shared_ptr< const ParserKeyword > >& keywords );
+        void setLazyUnits();
+        void setSIStorage();
+        void setProfile( ParseProfile* );
+        void addKeyword( const ParserKeyword&, std::shared_ptr< RawKeyword > );
+        void addKeyword( DeckKeyword&& );
+        void flush();
+        MessageContainer& messages();
+        void lendTokenArena( RawKeyword& );
+        void reclaimTokenArena( RawKeyword& );
+
+    private:
+        InputStack input_stack;
+
+        /*
+         * Keywords are parsed on the thread pool (if any) and committed to
+         * the deck in input order. The pool is destroyed, and all its tasks
+         * completed, before the input they refer to.
+         */
+        using parsed_keyword = std::pair< DeckKeyword, MessageContainer >;
+        std::unique_ptr< ThreadPool > pool;
+        std::deque< std::pair< std::future< parsed_keyword >, input_mark > > pending;
+        size_t max_pending = 0;
+
+        void commit( size_t );
+
+        /*
+         * When streaming, committed keywords go to the output rather than
+         * the deck, the input is cleaned lazily and released as the keywords
+         * referring to it are committed.
+         */
+        std::function< void( DeckKeyword&& ) > output;
+
+        input_mark mark() const;
+        void emit( DeckKeyword&&, const input_mark& );
+
+        /*
+         * In lazy mode, keywords are added to the deck without being parsed,
+         * except for the eager ones, which the parser itself looks up.
+         */
+        bool lazy = false;
+        std::set< std::string > eager;
+        std::shared_ptr< const ParseContext > lazyContext;
+        std::shared_ptr< deck_units > lazyUnits;
+        std::shared_ptr< const void > lazyKeywords;
+
+        void addLazyKeyword( const ParserKeyword&, std::shared_ptr< RawKeyword > );
+
+        /*
+         * When the values are stored in SI, keywords are converted when they
+         * are parsed, with the units selected so far. The units are replaced,
+         * rather than changed, by a unit keyword, since the keywords before
+         * it may still be parsing.
+         */
+        std::shared_ptr< deck_units > siUnits;
+        int unitRank = -1;
+
+        void selectUnits( const std::string& );
+
+        /* the profile of the parse, if profiled */
+        ParseProfile* profile = nullptr;
+
+        /*
+         * The tokens of the keywords parsed in the parser thread are split
+         * into the same arena, which is handed from one keyword to the next.
+         */
+        std::vector< string_view > token_arena;
+
+        /*
+         * Included files are read and cleaned ahead of time on the thread
+         * pool. The INCLUDE paths found by scan_includes are queued, and a
+         * window of them are prefetched at a time, in roughly the order the
+         * parser will need them. loadFile picks up the prefetched file if the
+         * path it is asked for matches. Includes the parser resolved some other
+         * way are dropped when their file is closed, so they don't hold on to
+         * the window.
+         */
+        std::deque< queued_include > prefetch_queue;
+        std::vector< queued_include > unresolved;
+        std::map< boost::filesystem::path, prefetch_entry > prefetched;
+        std::map< std::string, std::string > prefetch_aliases;
+        size_t max_prefetch = 0;
+
+        void pushFile( input_file&&, const boost::filesystem::path&,
+                       const std::vector< include_directive >& );
+        void queueIncludes( const std::vector< include_directive >& );
+        void prefetch();
+        void dropAbandoned();
+
+        std::map< std::string, std::string > pathMap;
+        boost::filesystem::path rootPath;
+
+    public:
+        std::shared_ptr< RawKeyword > rawKeyword;
+        string_view nextKeyword = emptystr;
+        Deck deck;
+        /* every file the parser tried to open, in order, for the deck cache */
+        std::vector< boost::filesystem::path > inputs;
+        const ParseContext& parseContext;
+        bool unknown_keyword = false;
+};
+
+
+const boost::filesystem::path& ParserState::current_path() const {
+    return this->input_stack.top().path;
+}
+
+size_t ParserState::line() const {
+    return this->input_stack.top().lineNR;
+}
+
+bool ParserState::done() const {
+    auto& stack = const_cast< ParserState* >( this )->input_stack;
+
+    while( !stack.empty() && stack.top().input.empty() ) {
+        auto* source = stack.top().source;
+        if( source && !source->exhausted() )
+            stack.top().input = source->clean_more();
+        else
+            stack.pop();
+    }
+
+    return stack.empty();
+}
+
+string_view ParserState::getline() {
+    string_view ln;
+
+    Opm::getline( this->input_stack.top().input, ln );
+    this->input_stack.top().lineNR++;
+
+    return ln;
+}
+
+void ParserState::closeFile() {
+    this->input_stack.pop();
+}
+
+void ParserState::setThreadCount( size_t threads ) {
+    this->flush();
+    this->prefetched.clear();
+    this->prefetch_queue.clear();
+    this->unresolved.clear();
+    this->pool.reset();
+    this->max_prefetch = 0;
+
+    if( threads <= 1 ) return;
+
+    /*
+     * The calling thread is busy splitting the input into keywords, so it
+     * does not count as one of the parsing threads. Bound the number of
+     * keywords in flight so that a slow keyword doesn't let the others pile
+     * up.
+     */
+    this->pool.reset( new ThreadPool( threads - 1 ) );
+    this->max_pending = 16 * threads;
+
+    /* prefetched files are cleaned in full, which a streaming parse avoids */
+    if( this->output ) return;
+
+    this->max_prefetch = 2 * threads;
+
+    if( !this->input_stack.empty() )
+        this->queueIncludes( scan_includes( this->input_stack.top().input ) );
+}
+
+/*
+ * The directives of a file go in front of the queue, since the parser gets to
+ * them before the rest of the including file.
+ */
+void ParserState::queueIncludes( const std::vector< include_directive >& directives ) {
+    if( this->max_prefetch == 0 ) return;
+
+    const auto depth = this->input_stack.size();
+    std::vector< queued_include > includes;
+    bool new_alias = false;
+    for( const auto& directive : directives ) {
+        if( directive.alias.empty() )
+            includes.push_back( { directive.path, depth } );
+        else
+            new_alias |= this->prefetch_aliases.emplace( directive.alias, directive.path ).second;
+    }
+
+    /* paths that needed an unknown alias get another chance */
+    if( new_alias ) {
+        includes.insert( includes.end(), this->unresolved.begin(), this->unresolved.end() );
+        this->unresolved.clear();
+    }
+
+    this->prefetch_queue.insert( this->prefetch_queue.begin(),
+                                 includes.begin(), includes.end() );
+    this->prefetch();
+}
+
+/*
+ * Paths are resolved when the prefetch starts rather than when they are
+ * found, so that aliases from files included in between are known. Paths that
+ * still can't be resolved are put aside until more aliases are found, and are
+ * otherwise left for loadFile.
+ */
+void ParserState::prefetch() {
+    while( this->prefetched.size() < this->max_prefetch
+        && !this->prefetch_queue.empty() ) {
+
+        const auto include = std::move( this->prefetch_queue.front() );
+        this->prefetch_queue.pop_front();
+
+        boost::filesystem::path path;
+        try {
+            path = include_path( include.path, this->prefetch_aliases, this->rootPath );
+        } catch( const std::out_of_range& ) {
+            this->unresolved.push_back( include );
+            continue;
+        }
+
+        if( this->prefetched.count( path ) ) continue;
+
+        prefetch_entry entry;
+        entry.file = this->pool->submit( [path] { return prefetch_file( path ); } );
+        entry.depth = include.depth;
+        this->prefetched.emplace( path, std::move( entry ) );
+    }
+}
+
+/*
+ * Files are only pushed by loadFile, so dropping the includes of closed files
+ * there is enough to not mistake them for the includes of a file that is
+ * later opened at the same depth. Files that are still being read are left
+ * to the pool, which drops the result.
+ */
+void ParserState::dropAbandoned() {
+    const auto depth = this->input_stack.size();
+    const auto abandoned = [depth]( const queued_include& include ) {
+        return include.depth > depth;
+    };
+
+    for( auto itr = this->prefetched.begin(); itr != this->prefetched.end(); ) {
+        if( itr->second.depth > depth ) itr = this->prefetched.erase( itr );
+        else ++itr;
+    }
+
+    this->prefetch_queue.erase( std::remove_if( this->prefetch_queue.begin(),
+                                                this->prefetch_queue.end(),
+                                                abandoned ),
+                                this->prefetch_queue.end() );
+    this->unresolved.erase( std::remove_if( this->unresolved.begin(),
+                                            this->unresolved.end(),
+                                            abandoned ),
+                            this->unresolved.end() );
+}
+
+void ParserState::setOutput( std::function< void( DeckKeyword&& ) > out ) {
+    this->output = std::move( out );
+}
+
+/*
+ * The lazy keywords may be parsed after the parser is gone, so they share the
+ * keywords that were added to it. The default keywords are never destroyed.
+ */
+void ParserState::setLazy( std::set< std::string > eagerKeywords,
+                           const std::vector< std::shared_ptr< const ParserKeyword > >& keywords ) {
+    this->lazy = true;
+    this->eager = std::move( eagerKeywords );
+    this->lazyKeywords = std::make_shared< const std::vector< std::shared_ptr< const ParserKeyword > > >( keywords );
+    this->lazyContext = std::make_shared< ParseContext >( this->parseContext );
+    this->lazyUnits = std::make_shared< deck_units >();
+}
+
+void ParserState::setLazyUnits() {
+    if( !this->lazy ) return;
+
+    std::lock_guard< std::mutex > lock( this->lazyUnits->mutex );
+    this->lazyUnits->active = this->deck.getActiveUnitSystem();
+    this->lazyUnits->defaults = this->deck.getDefaultUnitSystem();
+}
+
+void ParserState::setSIStorage() {
+    this->siUnits = std::make_shared< deck_units >();
+    this->siUnits->active = this->deck.getActiveUnitSystem();
+    this->siUnits->defaults = this->deck.getDefaultUnitSystem();
+}
+
+/*
+ * With several unit keywords, the preference is the same as when the units
+ * are applied to the whole deck: metric over field over lab.
+ */
+void ParserState::selectUnits( const std::string& name ) {
+    static const std::string ranked[] = { "LAB", "FIELD", "METRIC" };
+
+    const auto itr = std::find( std::begin( ranked ), std::end( ranked ), name );
+    const int rank = itr - std::begin( ranked );
+    if( itr == std::end( ranked ) || rank <= this->unitRank ) return;
+
+    auto units = std::make_shared< deck_units >();
+    if( rank == 0 ) units->active = UnitSystem::newLAB();
+    if( rank == 1 ) units->active = UnitSystem::newFIELD();
+    if( rank == 2 ) units->active = UnitSystem::newMETRIC();
+    units->defaults = this->siUnits->defaults;
+
+    this->siUnits = std::move( units );
+    this->unitRank = rank;
+}
+
+void ParserState::setProfile( ParseProfile* p ) {
+    this->profile = p;
+}
+
+/*
+ * Parse the keyword, and if the parse is profiled, add the keyword to the
+ * profile. This is called from the thread that parses the keyword.
+ */
+DeckKeyword parse_keyword( const ParserKeyword& parserKeyword,
+                           const ParseContext& context,
+                           MessageContainer& messages,
+                           std::shared_ptr< RawKeyword > rawKeyword,
+                           ParseProfile* profile,
+                           deck_units* units ) {
+    if( !profile ) {
+        auto keyword = parserKeyword.parse( context, messages, rawKeyword );
+        if( units ) convert_to_si( parserKeyword, *units, keyword );
+        return keyword;
+    }
+
+    ParseProfile::Entry sample;
+    sample.name = rawKeyword->getKeywordName();
+    sample.keywords = 1;
+    sample.bytes = rawKeyword->getByteSize();
+
+    auto keyword = [&] {
+        ParseProfile::Scope scope( sample );
+        auto kw = parserKeyword.parse( context, messages, rawKeyword );
+        if( units ) convert_to_si( parserKeyword, *units, kw );
+        return kw;
+    }();
+
+    sample.records = keyword.size();
+    for( const auto& record : keyword ) sample.items += record.size();
+
+    profile->addKeyword( rawKeyword->getFilename(), sample );
+    return keyword;
+}
+
+void ParserState::addKeyword( const ParserKeyword& parserKeyword,
+                              std::shared_ptr< RawKeyword > raw ) {
+    if( this->siUnits ) this->selectUnits( raw->getKeywordName() );
+
+    if( this->lazy && raw->isFinished()
+        && !this->eager.count( raw->getKeywordName() ) ) {
+        this->addLazyKeyword( parserKeyword, std::move( raw ) );
+        return;
+    }
+
+    if( !this->pool ) {
+        this->emit( parse_keyword( parserKeyword,
+                                   this->parseContext,
+                                   this->deck.getMessageContainer(),
+                                   raw,
+                                   this->profile,
+                                   this->siUnits.get() ),
+                    this->mark() );
+        this->reclaimTokenArena( *raw );
+        return;
+    }
 
-    /* we know that we always append a newline onto the input string, so we can
-     * safely assume that end+1 will either be end-of-input (i.e. empty range)
-     * or the start of the next line
-     */
+    const auto* kw = &parserKeyword;
+    const auto& context = this->parseContext;
+    auto* prof = this->profile;
+    auto units = this->siUnits;
+    auto parsed = this->pool->submit( [kw, &context, raw, prof, units] {
+        MessageContainer messages;
+        auto keyword = parse_keyword( *kw, context, messages, raw, prof, units.get() );
+        return std::make_pair( std::move( keyword ), std::move( messages ) );
+    } );
+
+    this->pending.emplace_back( std::move( parsed ), this->mark() );
+    this->commit( this->max_pending );
 }
 
 /*
- * Read the input file and remove everything that isn't interesting data,
- * including stripping comments, removing leading/trailing whitespaces and
- * everything after (terminating) slashes. Manually copying into the string for
- * performance.
+ * Lazy keywords are already done, but still have to be committed in order
+ * with the pending keywords.
  */
-inline std::string clean( const std::string& str ) {
-    std::string dst;
-    dst.resize( str.size() );
-
-    string_view input( str ), line;
-    auto dsti = dst.begin();
-    while( getline( input, line ) ) {
-        line = trim( strip_slash( strip_comments( line ) ) );
+void ParserState::addLazyKeyword( const ParserKeyword& parserKeyword,
+                                  std::shared_ptr< RawKeyword > raw ) {
+    DeckKeyword keyword( raw->getKeywordName(),
+                         std::make_shared< lazy_keyword >( parserKeyword,
+                                                           raw,
+                                                           this->lazyContext,
+                                                           this->siUnits ? this->siUnits
+                                                                         : this->lazyUnits,
+                                                           bool( this->siUnits ),
+                                                           this->input_stack.storage(),
+                                                           this->lazyKeywords ) );
+
+    keyword.setLocation( raw->getFilename(), raw->getLineNR() );
+    keyword.setDataKeyword( parserKeyword.isDataKeyword() );
+
+    if( this->profile ) {
+        ParseProfile::Entry sample;
+        sample.name = raw->getKeywordName();
+        sample.keywords = 1;
+        sample.bytes = raw->getByteSize();
+        this->profile->addKeyword( raw->getFilename(), sample );
+    }
 
-        std::copy( line.begin(), line.end(), dsti );
-        dsti += std::distance( line.begin(), line.end() );
-        *dsti++ = '\n';
+    if( !this->pool ) {
+        this->emit( std::move( keyword ), this->mark() );
+        return;
     }
 
-    dst.resize( std::distance( dst.begin(), dsti ) );
-    return dst;
+    std::promise< parsed_keyword > done;
+    done.set_value( std::make_pair( std::move( keyword ), MessageContainer() ) );
+    this->pending.emplace_back( done.get_future(), this->mark() );
+    this->commit( this->max_pending );
 }
 
-const std::string emptystr = "";
-
-struct file {
-    file( boost::filesystem::path p, const std::string& in ) :
-        input( in ), path( p )
-    {}
-
-    string_view input;
-    size_t lineNR = 0;
-    boost::filesystem::path path;
-};
-
-class InputStack : public std::stack< file, std::vector< file > > {
-    public:
-        void push( std::string&& input, boost::filesystem::path p = "" );
-
-    private:
-        std::list< std::string > string_storage;
-        using base = std::stack< file, std::vector< file > >;
-};
-
-void InputStack::push( std::string&& input, boost::filesystem::path p ) {
-    this->string_storage.push_back( std::move( input ) );
-    this->emplace( p, this->string_storage.back() );
+void ParserState::lendTokenArena( RawKeyword& raw ) {
+    raw.setTokenArena( std::move( this->token_arena ) );
+    this->token_arena.clear();
 }
 
-class ParserState {
-    public:
-        ParserState( const ParseContext& );
-        ParserState( const ParseContext&, boost::filesystem::path );
-
-        void loadString( const std::string& );
-        void loadFile( const boost::filesystem::path& );
-        void openRootFile( const boost::filesystem::path& );
-
-        void handleRandomText(const string_view& ) const;
-        boost::filesystem::path getIncludeFilePath( std::string ) const;
-        void addPathAlias( const std::string& alias, const std::string& path );
-
-        const boost::filesystem::path& current_path() const;
-        size_t line() const;
+/*
+ * Keywords that are done with their tokens hand the arena back, so the next
+ * raw keyword can reuse its capacity.
+ */
+void ParserState::reclaimTokenArena( RawKeyword& raw ) {
+    this->token_arena = raw.releaseTokenArena();
+}
 
-        bool done() const;
-        string_view getline();
-        void closeFile();
+void ParserState::addKeyword( DeckKeyword&& keyword ) {
+    this->flush();
+    this->emit( std::move( keyword ), this->mark() );
+}
 
-    private:
-        InputStack input_stack;
+/*
+ * The keyword that was just read, and all the keywords before it, end before
+ * the current position. The header of the next keyword may already have been
+ * read, though.
+ */
+input_mark ParserState::mark() const {
+    if( this->input_stack.empty() ) return {};
 
-        std::map< std::string, std::string > pathMap;
-        boost::filesystem::path rootPath;
+    const auto& top = this->input_stack.top();
+    input_mark m;
+    m.source = top.source;
+    m.pos = this->nextKeyword.length() > 0
+          ? this->nextKeyword.begin()
+          : top.input.begin();
 
-    public:
-        std::shared_ptr< RawKeyword > rawKeyword;
-        string_view nextKeyword = emptystr;
-        Deck deck;
-        const ParseContext& parseContext;
-        bool unknown_keyword = false;
-};
+    return m;
+}
 
+void ParserState::emit( DeckKeyword&& keyword, const input_mark& m ) {
+    if( !this->output ) {
+        this->deck.addKeyword( std::move( keyword ) );
+        return;
+    }
 
-const boost::filesystem::path& ParserState::current_path() const {
-    return this->input_stack.top().path;
+    this->output( std::move( keyword ) );
+    if( m.source ) m.source->release( m.pos );
 }
 
-size_t ParserState::line() const {
-    return this->input_stack.top().lineNR;
-}
+/*
+ * Commit the parsed keywords, in order, until at most keep keywords are
+ * pending. Keywords that are already parsed are committed regardless. Errors
+ * from the parsing are rethrown here, which is the same order they would have
+ * been thrown in by a serial parse.
+ */
+void ParserState::commit( size_t keep ) {
+    while( !this->pending.empty() ) {
+        auto& front = this->pending.front().first;
 
-bool ParserState::done() const {
+        if( this->pending.size() <= keep
+            && front.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+            return;
 
-    while( !this->input_stack.empty() &&
-            this->input_stack.top().input.empty() )
-        const_cast< ParserState* >( this )->input_stack.pop();
+        this->pool->wait( front );
+        auto result = front.get();
+        const auto m = this->pending.front().second;
+        this->pending.pop_front();
 
-    return this->input_stack.empty();
+        this->deck.getMessageContainer().appendMessages( result.second );
+        this->emit( std::move( result.first ), m );
+    }
 }
 
-string_view ParserState::getline() {
-    string_view ln;
-
-    Opm::getline( this->input_stack.top().input, ln );
-    this->input_stack.top().lineNR++;
-
-    return ln;
+void ParserState::flush() {
+    this->commit( 0 );
 }
 
-void ParserState::closeFile() {
-    this->input_stack.pop();
+/*
+ * All messages from the serial pass go through here, so that they end up in
+ * the same order as the messages from the keywords that are still pending.
+ */
+MessageContainer& ParserState::messages() {
+    this->flush();
+    return this->deck.getMessageContainer();
 }
 
 ParserState::ParserState(const ParseContext& __parseContext) :
@@ -271,59 +1312,144 @@ ParserState::ParserState(const ParseContext& __parseContext) :
 {}
 
 ParserState::ParserState( const ParseContext& context,
-                          boost::filesystem::path p ) :
+                          boost::filesystem::path p,
+                          ParseProfile* prof ) :
+    profile( prof ),
     rootPath( boost::filesystem::canonical( p ).parent_path() ),
     parseContext( context )
 {
     openRootFile( p );
 }
 
-void ParserState::loadString(const std::string& input) {
-    this->input_stack.push( clean( input + "\n" ) );
+void ParserState::loadString( string_view input ) {
+    this->input_stack.push( clean( input ) );
+
+    if( this->max_prefetch > 0 )
+        this->queueIncludes( scan_includes( this->input_stack.top().input ) );
 }
 
 void ParserState::loadFile(const boost::filesystem::path& inputFile) {
 
+    if( this->max_prefetch > 0 )
+        this->dropAbandoned();
+
+    const auto pre = this->prefetched.find( inputFile );
+    if( pre != this->prefetched.end() ) {
+        auto fut = std::move( pre->second.file );
+        this->prefetched.erase( pre );
+
+        this->pool->wait( fut );
+        auto result = fut.get();
+        if( result.ok ) {
+            if( this->profile ) this->profile->addRead( result.path.string(), result.seconds );
+            this->pushFile( std::move( result.file ), result.path, result.includes );
+            return;
+        }
+    }
+
+    const auto start = ParseProfile::clock::now();
+
     boost::filesystem::path inputFileCanonical;
     try {
-        inputFileCanonical = boost::filesystem::canonical(inputFile);
+        inputFileCanonical = resolve_input( inputFile );
     } catch (boost::filesystem::filesystem_error fs_error) {
+        this->inputs.push_back( inputFile );
         std::string msg = "Could not open file: " + inputFile.string();
-        parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , deck.getMessageContainer() , msg);
+        parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , this->messages() , msg);
         return;
     }
 
-    const auto closer = []( std::FILE* f ) { std::fclose( f ); };
-    std::unique_ptr< std::FILE, decltype( closer ) > ufp(
-            std::fopen( inputFileCanonical.string().c_str(), "rb" ),
-            closer
-            );
+    input_file file;
 
     // make sure the file we'd like to parse is readable
-    if( !ufp ) {
+    if( !read_input( inputFileCanonical, file, bool( this->output ) ) ) {
+        this->inputs.push_back( inputFileCanonical );
         std::string msg = "Could not read from file: " + inputFile.string();
-        parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , deck.getMessageContainer() , msg);
+        parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , this->messages() , msg);
         return;
     }
 
-    /*
-     * read the input file C-style. This is done for performance
-     * reasons, as streams are slow
-     */
+    const auto includes = this->max_prefetch > 0
+                        ? scan_includes( file.input() )
+                        : std::vector< include_directive >();
 
-    auto* fp = ufp.get();
-    std::string buffer;
-    std::fseek( fp, 0, SEEK_END );
-    buffer.resize( std::ftell( fp ) + 1 );
-    std::rewind( fp );
-    const auto readc = std::fread( &buffer[ 0 ], 1, buffer.size() - 1, fp );
-    buffer.back() = '\n';
+    if( this->profile )
+        this->profile->addRead( inputFileCanonical.string(), ParseProfile::since( start ) );
 
-    if( std::ferror( fp ) || readc != buffer.size() - 1 )
-        throw std::runtime_error( "Error when reading input file '"
-                                + inputFileCanonical.string() + "'" );
+    this->pushFile( std::move( file ), inputFileCanonical, includes );
+}
+
+/*
+ * The arrays of an IMPORT file become data keywords, as if they had been
+ * written in the deck in place of the IMPORT. The values are converted
+ * straight from the mapped file into the deck item.
+ */
+void ParserState::importFile( const boost::filesystem::path& inputFile,
+                              BinaryImport::Format format,
+                              const Parser& parser,
+                              const RawKeyword& importKeyword ) {
+
+    boost::filesystem::path inputFileCanonical;
+    try {
+        inputFileCanonical = boost::filesystem::canonical(inputFile);
+    } catch (const boost::filesystem::filesystem_error&) {
+        this->inputs.push_back( inputFile );
+        std::string msg = "Could not open file: " + inputFile.string();
+        parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , this->messages() , msg);
+        return;
+    }
+
+    this->inputs.push_back( inputFileCanonical );
+    const auto start = ParseProfile::clock::now();
+    BinaryImport file( inputFileCanonical, format );
+
+    while( file.next() ) {
+        if( !parser.isRecognizedKeyword( file.name() ) ) {
+            std::string msg = "Keyword " + file.name() + " in IMPORT file "
+                            + inputFile.string() + " not recognized.";
+            parseContext.handleError( ParseContext::PARSE_UNKNOWN_KEYWORD, this->messages(), msg );
+            continue;
+        }
+
+        const auto* parserKeyword = parser.getParserKeywordFromDeckName( file.name() );
+        if( !parserKeyword->isDataKeyword() ) {
+            std::string msg = "Keyword " + file.name() + " in IMPORT file "
+                            + inputFile.string() + " is not a data keyword, and is skipped.";
+            parseContext.handleError( ParseContext::PARSE_IMPORT_NON_DATA, this->messages(), msg );
+            continue;
+        }
+
+        const auto& parserItem = parserKeyword->getRecord( 0 ).get( 0 );
+        std::vector< DeckItem > items;
+
+        if( parserItem.getType() == type_tag::integer ) {
+            items.emplace_back( parserItem.name(), int(), 0 );
+            items.back().push_back( file.getIntData() );
+        } else {
+            items.emplace_back( parserItem.name(), double(), 0 );
+            items.back().push_back( file.getDoubleData() );
+        }
+
+        DeckKeyword keyword( file.name() );
+        keyword.setLocation( importKeyword.getFilename(), importKeyword.getLineNR() );
+        keyword.setDataKeyword( true );
+        keyword.addRecord( DeckRecord( std::move( items ) ) );
+
+        /* imported keywords are not parsed, so they are not stored in SI yet */
+        if( this->siUnits ) convert_to_si( *parserKeyword, *this->siUnits, keyword );
+        this->addKeyword( std::move( keyword ) );
+    }
+
+    if( this->profile )
+        this->profile->addRead( inputFileCanonical.string(), ParseProfile::since( start ) );
+}
 
-    this->input_stack.push( clean( buffer ), inputFileCanonical );
+void ParserState::pushFile( input_file&& file,
+                            const boost::filesystem::path& path,
+                            const std::vector< include_directive >& includes ) {
+    this->inputs.push_back( path );
+    this->input_stack.push( std::move( file ), path );
+    this->queueIncludes( includes );
 }
 
 /*
@@ -332,7 +1458,7 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
  * of the data section of any keyword.
  */
 
-void ParserState::handleRandomText(const string_view& keywordString ) const {
+void ParserState::handleRandomText(const string_view& keywordString ) {
     std::string errorKey;
     std::stringstream msg;
     std::string trimmedCopy = keywordString.string();
@@ -349,7 +1475,7 @@ void ParserState::handleRandomText(const string_view& keywordString ) const {
             << this->current_path()
             << ":" << this->line();
     }
-    parseContext.handleError( errorKey , deck.getMessageContainer() , msg.str() );
+    parseContext.handleError( errorKey , this->messages() , msg.str() );
 }
 
 void ParserState::openRootFile( const boost::filesystem::path& inputFile) {
@@ -359,31 +1485,12 @@ void ParserState::openRootFile( const boost::filesystem::path& inputFile) {
     rootPath = inputFileCanonical.parent_path();
 }
 
-boost::filesystem::path ParserState::getIncludeFilePath( std::string path ) const {
-    static const std::string pathKeywordPrefix("$");
-    static const std::string validPathNameCharacters("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
-
-    size_t positionOfPathName = path.find(pathKeywordPrefix);
-
-    if ( positionOfPathName != std::string::npos) {
-        std::string stringStartingAtPathName = path.substr(positionOfPathName+1);
-        size_t cutOffPosition = stringStartingAtPathName.find_first_not_of(validPathNameCharacters);
-        std::string stringToFind = stringStartingAtPathName.substr(0, cutOffPosition);
-        std::string stringToReplace = this->pathMap.at( stringToFind );
-        boost::replace_all(path, pathKeywordPrefix + stringToFind, stringToReplace);
-    }
+boost::filesystem::path ParserState::getIncludeFilePath( std::string path ) {
+    const auto includeFilePath = include_path( path, this->pathMap, this->rootPath );
 
     // Check if there are any backslashes in the path...
-    if (path.find('\\') != std::string::npos) {
-        // ... if so, replace with slashes and create a warning.
-        std::replace(path.begin(), path.end(), '\\', '/');
-        deck.getMessageContainer().warning("Replaced one or more backslash with a slash in an INCLUDE path.");
-    }
-
-    boost::filesystem::path includeFilePath(path);
-
-    if (includeFilePath.is_relative())
-        return this->rootPath / includeFilePath;
+    if (path.find('\\') != std::string::npos)
+        this->messages().warning("Replaced one or more backslash with a slash in an INCLUDE path.");
 
     return includeFilePath;
 }
@@ -392,13 +1499,13 @@ void ParserState::addPathAlias( const std::string& alias, const std::string& pat
     this->pathMap.emplace( alias, path );
 }
 
-std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserState& parserState, const Parser& parser ) {
+std::shared_ptr< RawKeyword > newRawKeyword( const string_view& kw, ParserState& parserState, const Parser& parser ) {
     auto keywordString = ParserKeyword::getDeckName( kw );
 
     if( !parser.isRecognizedKeyword( keywordString ) ) {
         if( ParserKeyword::validDeckName( keywordString ) ) {
             std::string msg = "Keyword " + keywordString + " not recognized.";
-            auto& msgContainer = parserState.deck.getMessageContainer();
+            auto& msgContainer = parserState.messages();
             parserState.parseContext.handleError( ParseContext::PARSE_UNKNOWN_KEYWORD, msgContainer, msg );
             parserState.unknown_keyword = true;
             return {};
@@ -433,6 +1540,9 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
                                                 parserKeyword->isTableCollection() );
     }
 
+    /* the size is defined by a keyword which may still be pending */
+    parserState.flush();
+
     const auto& sizeKeyword = parserKeyword->getSizeDefinitionPair();
     const auto& deck = parserState.deck;
 
@@ -449,7 +1559,7 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
 
     std::string msg = "Expected the kewyord: " + sizeKeyword.first
                     + " to infer the number of records in: " + keywordString;
-    auto& msgContainer = parserState.deck.getMessageContainer();
+    auto& msgContainer = parserState.messages();
     parserState.parseContext.handleError(ParseContext::PARSE_MISSING_DIMS_KEYWORD , msgContainer, msg );
 
     const auto* keyword = parser.getKeyword( sizeKeyword.first );
@@ -464,6 +1574,12 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
                                             parserKeyword->isTableCollection() );
 }
 
+std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserState& parserState, const Parser& parser ) {
+    auto rawKeyword = newRawKeyword( kw, parserState, parser );
+    if( rawKeyword ) parserState.lendTokenArena( *rawKeyword );
+    return rawKeyword;
+}
+
 bool tryParseKeyword( ParserState& parserState, const Parser& parser ) {
     if (parserState.nextKeyword.length() > 0) {
         parserState.rawKeyword = createRawKeyword( parserState.nextKeyword, parserState, parser );
@@ -517,7 +1633,7 @@ bool tryParseKeyword( ParserState& parserState, const Parser& parser ) {
     return false;
 }
 
-bool parseState( ParserState& parserState, const Parser& parser ) {
+bool parseInput( ParserState& parserState, const Parser& parser ) {
 
     while( !parserState.done() ) {
 
@@ -542,6 +1658,7 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
                 parserState.addPathAlias( pathName, pathValue );
             }
 
+            parserState.reclaimTokenArena( *parserState.rawKeyword );
             continue;
         }
 
@@ -550,21 +1667,37 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
             std::string includeFileAsString = readValueToken<std::string>(firstRecord.getItem(0));
             boost::filesystem::path includeFile = parserState.getIncludeFilePath( includeFileAsString );
 
+            parserState.reclaimTokenArena( *parserState.rawKeyword );
             parserState.loadFile( includeFile );
             continue;
         }
 
+        if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::import) {
+            const auto* parserKeyword = parser.getParserKeywordFromDeckName( Opm::RawConsts::import );
+            const auto importKeyword = parserKeyword->parse( parserState.parseContext,
+                                                             parserState.messages(),
+                                                             parserState.rawKeyword );
+            const auto& record = importKeyword.getRecord( 0 );
+            const auto format = BinaryImport::formatFromString( record.getItem( "FORMAT" ).getTrimmedString( 0 ) );
+            const auto importFile = parserState.getIncludeFilePath( record.getItem( "FILE" ).getTrimmedString( 0 ) );
+
+            parserState.importFile( importFile, format, parser, *parserState.rawKeyword );
+            parserState.reclaimTokenArena( *parserState.rawKeyword );
+            continue;
+        }
+
         if( parser.isRecognizedKeyword( parserState.rawKeyword->getKeywordName() ) ) {
             const auto& kwname = parserState.rawKeyword->getKeywordName();
             const auto* parserKeyword = parser.getParserKeywordFromDeckName( kwname );
-            parserState.deck.addKeyword( parserKeyword->parse( parserState.parseContext, parserState.deck.getMessageContainer(), parserState.rawKeyword ) );
+            parserState.addKeyword( *parserKeyword, parserState.rawKeyword );
         } else {
             DeckKeyword deckKeyword( parserState.rawKeyword->getKeywordName(), false );
             const std::string msg = "The keyword " + parserState.rawKeyword->getKeywordName() + " is not recognized";
             deckKeyword.setLocation( parserState.rawKeyword->getFilename(),
                     parserState.rawKeyword->getLineNR());
-            parserState.deck.addKeyword( std::move( deckKeyword ) );
-            parserState.deck.getMessageContainer().warning(
+            parserState.reclaimTokenArena( *parserState.rawKeyword );
+            parserState.addKeyword( std::move( deckKeyword ) );
+            parserState.messages().warning(
                 parserState.current_path().string(), msg, parserState.line() );
         }
     }
@@ -572,6 +1705,23 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     return true;
 }
 
+/*
+ * Keywords may still be pending on the thread pool when the input is done, or
+ * when the serial pass fails. An error in a pending keyword comes earlier in
+ * the input, and takes precedence.
+ */
+bool parseState( ParserState& parserState, const Parser& parser ) {
+    try {
+        parseInput( parserState, parser );
+    } catch( ... ) {
+        parserState.flush();
+        throw;
+    }
+
+    parserState.flush();
+    return true;
+}
+
 }
 
 
@@ -641,34 +1791,226 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         return parse(deck, context).getInputGrid();
     }
 
+    static void setActiveUnits( Deck& deck ) {
+        /*
+         * If multiple unit systems are requested, metric is preferred over
+         * lab, and field over metric, for as long as we have no easy way of
+         * figuring out which was requested last.
+         */
+        if( deck.hasKeyword( "LAB" ) )
+            deck.getActiveUnitSystem() = UnitSystem::newLAB();
+        if( deck.hasKeyword( "FIELD" ) )
+            deck.getActiveUnitSystem() = UnitSystem::newFIELD();
+        if( deck.hasKeyword( "METRIC" ) )
+            deck.getActiveUnitSystem() = UnitSystem::newMETRIC();
+    }
+
     Deck Parser::parseFile(const std::string &dataFileName, const ParseContext& parseContext) const {
-        ParserState parserState( parseContext, dataFileName );
+        std::unique_ptr< DeckCache > cache;
+        if( !this->m_cacheDirectory.empty() ) {
+            cache.reset( new DeckCache( this->m_cacheDirectory, *this, parseContext ) );
+
+            Deck deck;
+            if( cache->load( dataFileName, deck ) ) {
+                deck.setDataFile( dataFileName );
+                if( this->m_siStorage )
+                    for( auto& keyword : deck ) store_si( keyword );
+                return deck;
+            }
+        }
+
+        const auto start = ParseProfile::clock::now();
+        std::shared_ptr< ParseProfile > profile;
+        if( this->m_profiling ) profile = std::make_shared< ParseProfile >();
+
+        ParserState parserState( parseContext, dataFileName, profile.get() );
+        parserState.setThreadCount( this->m_threads );
+        if( this->m_lazy ) parserState.setLazy( this->getSizeKeywords(), this->keyword_storage );
+        if( this->m_siStorage ) parserState.setSIStorage();
+
         parseState( parserState, *this );
-        applyUnitsToDeck( parserState.deck );
+        /* keywords stored in SI already have their units */
+        if( this->m_siStorage ) setActiveUnits( parserState.deck );
+        else applyUnitsToDeck( parserState.deck, profile.get() );
+        parserState.setLazyUnits();
+
+        if( profile ) {
+            profile->setTotalSeconds( ParseProfile::since( start ) );
+            parserState.deck.setParseProfile( profile );
+        }
+
+        /* writing the cache would parse all the lazy keywords */
+        if( cache && !this->m_lazy )
+            cache->store( dataFileName, parserState.inputs, parserState.deck );
 
         return std::move( parserState.deck );
     }
 
+    MessageContainer Parser::parseFile( const std::string& dataFileName,
+                                        const ParseContext& parseContext,
+                                        std::function< void( const DeckKeyword& ) > visitor ) const {
+        auto retained = this->getSizeKeywords();
+        retained.insert( { "LAB", "FIELD", "METRIC" } );
+
+        ParserState parserState( parseContext );
+        auto& deck = parserState.deck;
+
+        parserState.setOutput( [&]( DeckKeyword&& keyword ) {
+            if( !this->m_siStorage && this->isRecognizedKeyword( keyword.name() ) ) {
+                const auto* parserKeyword = this->getParserKeywordFromDeckName( keyword.name() );
+                if( parserKeyword->hasDimension() )
+                    parserKeyword->applyUnitsToDeck( deck, keyword );
+            }
+
+            visitor( keyword );
+
+            if( !retained.count( keyword.name() ) ) return;
+
+            deck.addKeyword( std::move( keyword ) );
+            setActiveUnits( deck );
+        } );
+
+        if( this->m_siStorage ) parserState.setSIStorage();
+        parserState.setThreadCount( this->m_threads );
+        parserState.openRootFile( dataFileName );
+        parseState( parserState, *this );
+
+        return deck.getMessageContainer();
+    }
+
     Deck Parser::parseString(const std::string &data, const ParseContext& parseContext) const {
+        return this->parseBuffer( data, parseContext );
+    }
+
+    Deck Parser::parseBuffer(string_view data, const ParseContext& parseContext) const {
+        const auto start = ParseProfile::clock::now();
+        std::shared_ptr< ParseProfile > profile;
+        if( this->m_profiling ) profile = std::make_shared< ParseProfile >();
+
         ParserState parserState( parseContext );
+        parserState.setProfile( profile.get() );
+        parserState.setThreadCount( this->m_threads );
+        if( this->m_lazy ) parserState.setLazy( this->getSizeKeywords(), this->keyword_storage );
+        if( this->m_siStorage ) parserState.setSIStorage();
         parserState.loadString( data );
 
         parseState( parserState, *this );
-        applyUnitsToDeck( parserState.deck );
+        /* keywords stored in SI already have their units */
+        if( this->m_siStorage ) setActiveUnits( parserState.deck );
+        else applyUnitsToDeck( parserState.deck, profile.get() );
+        parserState.setLazyUnits();
+
+        if( profile ) {
+            profile->setTotalSeconds( ParseProfile::since( start ) );
+            parserState.deck.setParseProfile( profile );
+        }
 
         return std::move( parserState.deck );
     }
 
+    void Parser::setThreadCount( size_t threads ) {
+        this->m_threads = std::max( threads, size_t( 1 ) );
+    }
+
+    size_t Parser::getThreadCount() const {
+        return this->m_threads;
+    }
+
+    void Parser::setLazy( bool lazy ) {
+        this->m_lazy = lazy;
+    }
+
+    bool Parser::isLazy() const {
+        return this->m_lazy;
+    }
+
+    void Parser::setCacheDirectory( const std::string& directory ) {
+        this->m_cacheDirectory = directory;
+    }
+
+    const std::string& Parser::getCacheDirectory() const {
+        return this->m_cacheDirectory;
+    }
+
+    void Parser::setProfiling( bool profiling ) {
+        this->m_profiling = profiling;
+    }
+
+    bool Parser::isProfiling() const {
+        return this->m_profiling;
+    }
+
+    void Parser::setSIStorage( bool si ) {
+        this->m_siStorage = si;
+    }
+
+    bool Parser::isSIStorage() const {
+        return this->m_siStorage;
+    }
+
+    /* the keywords that give the size of other keywords */
+    std::set< std::string > Parser::getSizeKeywords() const {
+        std::set< std::string > names;
+        for( const auto& keyword : this->keyword_storage ) {
+            if( keyword->getSizeType() == OTHER_KEYWORD_IN_DECK )
+                names.insert( keyword->getSizeDefinitionPair().first );
+        }
+
+        /* the default keywords are not built to find out */
+        if( m_defaults ) {
+            for( size_t i = 0; i < m_defaults->size(); ++i ) {
+                const auto* sizeKeyword = m_defaults->descriptor( i ).sizeKeyword;
+                if( sizeKeyword ) names.insert( sizeKeyword );
+            }
+        }
+
+        return names;
+    }
+
     size_t Parser::size() const {
-        return m_deckParserKeywords.size();
+        if( !m_defaults ) return m_deckParserKeywords.size();
+        return m_keywordHash->size() + m_unhashedNames;
     }
 
     const ParserKeyword* Parser::matchingKeyword(const string_view& name) const {
-        for (auto iter = m_wildCardKeywords.begin(); iter != m_wildCardKeywords.end(); ++iter) {
-            if (iter->second->matches(name))
-                return iter->second;
+        return m_wildCardTrie.match( name );
+    }
+
+    const ParserKeyword* Parser::findDeckName(const string_view& name) const {
+        if( m_keywordHash ) {
+            const auto slot = m_keywordHash->find( name );
+            if( slot != KeywordHash::npos ) {
+                if( !m_hashedKeywords.empty() && m_hashedKeywords[ slot ] )
+                    return m_hashedKeywords[ slot ];
+
+                return &m_defaults->getSlot( slot );
+            }
         }
-        return nullptr;
+
+        if( m_unhashedNames == 0 )
+            return nullptr;
+
+        const auto candidate = m_deckParserKeywords.find( name );
+        if( candidate == m_deckParserKeywords.end() ) return nullptr;
+        return candidate->second;
+    }
+
+    /*
+     * Only the registry is referred to, so this is cheap: the default
+     * keywords are built when they are first looked up.
+     */
+    void Parser::setDefaultKeywords(const KeywordRegistry& registry) {
+        m_defaults = &registry;
+        m_keywordHash = &registry.hash();
+        m_hashedKeywords.clear();
+        m_unhashedNames = m_deckParserKeywords.size();
+
+        for( const auto* keyword : registry.wildcards() )
+            m_wildCardKeywords.emplace( string_view( keyword->getName() ), keyword );
+
+        m_wildCardTrie = WildcardTrie();
+        for( const auto& keyword : m_wildCardKeywords )
+            m_wildCardTrie.insert( keyword.second );
     }
 
     bool Parser::hasWildCardKeyword(const std::string& internalKeywordName) const {
@@ -679,7 +2021,7 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         if( !ParserKeyword::validDeckName( name ) )
             return false;
 
-        if( m_deckParserKeywords.count( name ) )
+        if( findDeckName( name ) )
             return true;
 
         return bool( matchingKeyword( name ) );
@@ -712,11 +2054,26 @@ void Parser::addParserKeyword( std::unique_ptr< const ParserKeyword >&& parserKe
             nameIt != ptr->deckNamesEnd();
             ++nameIt)
     {
-        m_deckParserKeywords[ *nameIt ] = ptr;
+        const auto inserted = m_deckParserKeywords.emplace( string_view( *nameIt ), ptr );
+        if( !inserted.second )
+            inserted.first->second = ptr;
+
+        const auto slot = m_keywordHash ? m_keywordHash->find( *nameIt ) : KeywordHash::npos;
+        if( slot != KeywordHash::npos ) {
+            m_hashedKeywords.resize( m_keywordHash->size(), nullptr );
+            m_hashedKeywords[ slot ] = ptr;
+        }
+        else if( inserted.second )
+            ++m_unhashedNames;
     }
 
     if (ptr->hasMatchRegex()) {
         m_wildCardKeywords[ name ] = ptr;
+
+        /* the trie tries the keywords in name order, like the map */
+        m_wildCardTrie = WildcardTrie();
+        for( const auto& keyword : m_wildCardKeywords )
+            m_wildCardTrie.insert( keyword.second );
     }
 
 }
@@ -727,8 +2084,7 @@ void Parser::addParserKeyword(const Json::JsonObject& jsonKeyword) {
 }
 
 bool Parser::hasKeyword( const std::string& name ) const {
-    return this->m_deckParserKeywords.find( string_view( name ) )
-        != this->m_deckParserKeywords.end();
+    return this->findDeckName( string_view( name ) ) != nullptr;
 }
 
 const ParserKeyword* Parser::getKeyword( const std::string& name ) const {
@@ -736,9 +2092,9 @@ const ParserKeyword* Parser::getKeyword( const std::string& name ) const {
 }
 
 const ParserKeyword* Parser::getParserKeywordFromDeckName(const string_view& name ) const {
-    auto candidate = m_deckParserKeywords.find( name );
+    const auto* candidate = findDeckName( name );
 
-    if( candidate != m_deckParserKeywords.end() ) return candidate->second;
+    if( candidate ) return candidate;
 
     const auto* wildCardKeyword = matchingKeyword( name );
 
@@ -753,6 +2109,14 @@ std::vector<std::string> Parser::getAllDeckNames () const {
     for (auto iterator = m_deckParserKeywords.begin(); iterator != m_deckParserKeywords.end(); iterator++) {
         keywords.push_back(iterator->first.string());
     }
+
+    if (m_keywordHash) {
+        for (const auto& name : m_keywordHash->names())
+            keywords.push_back(name.string());
+
+        std::sort( keywords.begin(), keywords.end() );
+        keywords.erase( std::unique( keywords.begin(), keywords.end() ), keywords.end() );
+    }
     for (auto iterator = m_wildCardKeywords.begin(); iterator != m_wildCardKeywords.end(); iterator++) {
         keywords.push_back(iterator->first.string());
     }
@@ -804,26 +2168,31 @@ std::vector<std::string> Parser::getAllDeckNames () const {
 
 
     void Parser::applyUnitsToDeck(Deck& deck) const {
-        /*
-         * If multiple unit systems are requested, metric is preferred over
-         * lab, and field over metric, for as long as we have no easy way of
-         * figuring out which was requested last.
-         */
-        if( deck.hasKeyword( "LAB" ) )
-            deck.getActiveUnitSystem() = UnitSystem::newLAB();
-        if( deck.hasKeyword( "FIELD" ) )
-            deck.getActiveUnitSystem() = UnitSystem::newFIELD();
-        if( deck.hasKeyword( "METRIC" ) )
-            deck.getActiveUnitSystem() = UnitSystem::newMETRIC();
+        this->applyUnitsToDeck( deck, nullptr );
+    }
+
+    void Parser::applyUnitsToDeck(Deck& deck, ParseProfile* profile) const {
+        setActiveUnits( deck );
 
         for( auto& deckKeyword : deck ) {
 
+            /* lazy keywords get their units when they are parsed */
+            if( deckKeyword.isLazy() ) continue;
             if( !isRecognizedKeyword( deckKeyword.name() ) ) continue;
 
             const auto* parserKeyword = getParserKeywordFromDeckName( deckKeyword.name() );
             if( !parserKeyword->hasDimension() ) continue;
 
+            if( !profile ) {
+                parserKeyword->applyUnitsToDeck(deck , deckKeyword);
+                continue;
+            }
+
+            const auto start = ParseProfile::clock::now();
             parserKeyword->applyUnitsToDeck(deck , deckKeyword);
+            profile->addUnits( deckKeyword.name(),
+                               deckKeyword.getFileName(),
+                               ParseProfile::since( start ) );
         }
     }
 
@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <future>
 #include <ostream>
 #include <sstream>
 
@@ -28,6 +29,7 @@
 #include <opm/parser/eclipse/Parser/ParserEnums.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/StarToken.hpp>
+#include <opm/parser/eclipse/Utility/ThreadPool.hpp>
 
 
 namespace Opm {
@@ -269,6 +271,10 @@ void ParserItem::push_backDimension( const std::string& dim ) {
         return m_sizeType;
     }
 
+    type_tag ParserItem::getType() const {
+        return this->type;
+    }
+
     bool ParserItem::scalar() const {
         return this->m_sizeType == item_size::SINGLE;
     }
@@ -325,71 +331,259 @@ std::string ParserItem::createCode() const {
     stream << "ParserItem item(\"" << this->name()
            << "\", ParserItem::item_size::" << this->sizeType();
 
-       if( m_defaultSet ) {
-           stream << ", ";
-           switch( this->type ) {
-               case type_tag::integer:
-                   stream << this->getDefault< int >();
-                   break;
-
-               case type_tag::fdouble:
-                   stream << "double( "
-                          << boost::lexical_cast< std::string >
-                                ( this->getDefault< double >() )
-                          << " )";
-                   break;
-
-               case type_tag::string:
-                   stream << "\"" << this->getDefault< std::string >() << "\"";
-                   break;
-
-               default:
-                   throw std::logic_error( "Item of unknown type." );
-           }
-        }
+    if( m_defaultSet )
+        stream << ", " << this->defaultCode();
 
     stream << " ); item.setType( " << tag_name( this->type ) << "() );";
     return stream.str();
 }
 
+std::string ParserItem::createScanCode( const std::string& name,
+                                        const std::string& record ) const {
+    if( !this->scalar() )
+        throw std::logic_error( "Only items of size SINGLE have scan code" );
+
+    std::stringstream stream;
+    stream << "ParserItem::scanSingle< " << tag_name( this->type ) << " >( "
+           << name << ", " << record;
+
+    if( m_defaultSet )
+        stream << ", " << this->defaultCode();
+
+    stream << " )";
+    return stream.str();
+}
+
+std::string ParserItem::defaultCode() const {
+    switch( this->type ) {
+        case type_tag::integer:
+            return std::to_string( this->getDefault< int >() );
+
+        case type_tag::fdouble:
+            return "double( "
+                 + boost::lexical_cast< std::string >( this->getDefault< double >() )
+                 + " )";
+
+        case type_tag::string:
+            return "std::string( \"" + this->getDefault< std::string >() + "\" )";
+
+        default:
+            throw std::logic_error( "Item of unknown type." );
+    }
+}
+
 namespace {
 
-template< typename T >
-DeckItem scan_item( const ParserItem& p, RawRecord& record ) {
-    DeckItem item( p.name(), T(), record.size() );
+/*
+ * Convert the leading run of plain numbers in [first, last) in one go. Star
+ * tokens and malformed numbers are left to be handled, and reported, one at a
+ * time.
+ */
+template< typename T, typename Itr >
+Itr read_values( Itr first, Itr last, std::vector< T >& dst ) {
+    return readValueTokens( first, last, dst );
+}
 
-    if( p.sizeType() == ParserItem::item_size::ALL ) {
-        while( record.size() > 0 ) {
-            auto token = record.pop_front();
+/* strings are not bulk-converted - "3*X" is a plain string */
+template< typename Itr >
+Itr read_values( Itr first, Itr, std::vector< std::string >& ) {
+    return first;
+}
+
+/*
+ * The values are kept run-length encoded as they are scanned, so N*value and
+ * N* tokens are never expanded - see DeckItem.
+ */
+template< typename T >
+struct item_values {
+    std::vector< T > values;
+    std::vector< DeckItem::run > runs;
 
-            std::string countString;
-            std::string valueString;
+    size_t size() const {
+        return this->runs.empty() ? 0 : this->runs.back().end;
+    }
 
-            if( !isStarToken( token, countString, valueString ) ) {
-                item.push_back( readValueToken< T >( token ) );
-                continue;
+    /* the values from offset and onwards that are not yet in a run */
+    void add_literals( size_t offset, bool defaulted ) {
+        const auto count = this->values.size() - offset;
+        if( count == 0 ) return;
+
+        if( !this->runs.empty() ) {
+            auto& last = this->runs.back();
+            if( !last.repeated && last.defaulted == defaulted
+                && last.offset + (last.end - last.begin) == offset ) {
+                last.end += count;
+                return;
             }
+        }
 
-            StarToken st(token, countString, valueString);
+        const auto begin = this->size();
+        this->runs.push_back( { begin, begin + count, offset, false, defaulted } );
+    }
 
-            if( st.hasValue() ) {
-                item.push_back( readValueToken< T >( st.valueString() ), st.count() );
-                continue;
-            }
+    void add_repeated( T x, size_t count, bool defaulted ) {
+        if( count == 0 ) return;
+
+        const auto begin = this->size();
+        this->runs.push_back( { begin, begin + count, this->values.size(), true, defaulted } );
+        this->values.push_back( std::move( x ) );
+    }
+};
+
+template< typename T >
+void scan_tokens( const ParserItem& p,
+                  RawRecord::const_iterator first,
+                  RawRecord::const_iterator last,
+                  item_values< T >& dst ) {
+
+    auto& values = dst.values;
+
+    while( first != last ) {
+        const auto offset = values.size();
+        first = read_values( first, last, values );
+        dst.add_literals( offset, false );
+        if( first == last ) break;
+
+        const auto token = *first++;
+
+        std::string countString;
+        std::string valueString;
+
+        if( !isStarToken( token, countString, valueString ) ) {
+            values.push_back( readValueToken< T >( token ) );
+            dst.add_literals( values.size() - 1, false );
+            continue;
+        }
 
-            auto value = p.getDefault< T >();
-            for (size_t i=0; i < st.count(); i++)
-                item.push_backDefault( value );
+        StarToken st(token, countString, valueString);
+
+        if( st.hasValue() ) {
+            dst.add_repeated( readValueToken< T >( st.valueString() ), st.count(), false );
+            continue;
         }
 
+        dst.add_repeated( p.getDefault< T >(), st.count(), true );
+    }
+}
+
+/*
+ * Items with a huge number of values, like the grid properties of large
+ * models, are converted in chunks on the thread pool when the keyword is
+ * parsed by one. The chunks are split at token boundaries, and since a star
+ * token can expand to any number of values, the chunks are placed in the item
+ * by the prefix sum of their sizes.
+ */
+const size_t chunk_size = 1 << 16;
+
+template< typename T >
+item_values< T > scan_tokens( const ParserItem& p,
+                              const RawRecord& record,
+                              ThreadPool& pool ) {
+
+    const auto num_chunks = ( record.size() + chunk_size - 1 ) / chunk_size;
+
+    std::vector< std::future< item_values< T > > > futures;
+    for( size_t i = 0; i < num_chunks; ++i ) {
+        const auto first = record.begin() + i * chunk_size;
+        const auto last = i + 1 == num_chunks ? record.end() : first + chunk_size;
+
+        futures.push_back( pool.submit( [&p, first, last] {
+            item_values< T > chunk;
+            scan_tokens( p, first, last, chunk );
+            return chunk;
+        } ) );
+    }
+
+    /*
+     * all chunks must be done with the record before an error is passed on,
+     * and the first error in the input is the one that's reported
+     */
+    for( auto& fut : futures ) pool.wait( fut );
+
+    std::vector< item_values< T > > chunks;
+    for( auto& fut : futures ) chunks.push_back( fut.get() );
+
+    std::vector< size_t > offsets( num_chunks + 1, 0 );
+    for( size_t i = 0; i < num_chunks; ++i )
+        offsets[ i + 1 ] = offsets[ i ] + chunks[ i ].values.size();
+
+    item_values< T > result;
+    result.values.resize( offsets.back() );
+
+    std::vector< std::future< void > > copies;
+    for( size_t i = 0; i < num_chunks; ++i ) {
+        auto* src = &chunks[ i ].values;
+        auto dst = result.values.begin() + offsets[ i ];
+        copies.push_back( pool.submit( [src, dst] {
+            std::move( src->begin(), src->end(), dst );
+        } ) );
+    }
+
+    /* there are few runs compared to values, so they are shifted in place */
+    for( size_t i = 0; i < num_chunks; ++i ) {
+        const auto begin = result.size();
+        for( auto r : chunks[ i ].runs ) {
+            r.begin += begin;
+            r.end += begin;
+            r.offset += offsets[ i ];
+            result.runs.push_back( r );
+        }
+    }
+
+    for( auto& copy : copies ) pool.wait( copy );
+    return result;
+}
+
+/*
+ * The name is interned once by the parser item, rather than for every deck
+ * item that is scanned.
+ */
+template< typename T >
+DeckItem scan_item( const ParserItem& p, InternedString name, RawRecord& record ) {
+    if( p.sizeType() == ParserItem::item_size::ALL ) {
+        auto* pool = ThreadPool::current();
+
+        item_values< T > values;
+        if( pool && record.size() > 2 * chunk_size )
+            values = scan_tokens< T >( p, record, *pool );
+        else
+            scan_tokens( p, record.begin(), record.end(), values );
+
+        record.pop_front( record.size() );
+
+        DeckItem item( name, T(), 0 );
+        item.push_back( std::move( values.values ), std::move( values.runs ) );
         return item;
     }
 
+    if( p.hasDefault() )
+        return ParserItem::scanSingle< T >( name, record, p.getDefault< T >() );
+
+    return ParserItem::scanSingle< T >( name, record );
+}
+
+}
+
+
+template< typename T >
+DeckItem ParserItem::scanSingle( InternedString name, RawRecord& record ) {
+    return scanSingle< T >( name, record, static_cast< const T* >( nullptr ) );
+}
+
+template< typename T >
+DeckItem ParserItem::scanSingle( InternedString name, RawRecord& record, const T& defaultValue ) {
+    return scanSingle< T >( name, record, &defaultValue );
+}
+
+template< typename T >
+DeckItem ParserItem::scanSingle( InternedString name, RawRecord& record, const T* defaultValue ) {
+    DeckItem item( name, T() );
+
     if( record.size() == 0 ) {
         // if the record was ended prematurely,
-        if( p.hasDefault() ) {
+        if( defaultValue ) {
             // use the default value for the item, if there is one...
-            item.push_backDefault( p.getDefault< T >() );
+            item.push_backDefault( *defaultValue );
         } else {
             // ... otherwise indicate that the deck item should throw once the
             // item's data is accessed.
@@ -413,8 +607,8 @@ DeckItem scan_item( const ParserItem& p, RawRecord& record ) {
 
     if( st.hasValue() )
         item.push_back(readValueToken< T >( st.valueString() ) );
-    else if( p.hasDefault() )
-        item.push_backDefault( p.getDefault< T >() );
+    else if( defaultValue )
+        item.push_backDefault( *defaultValue );
     else
         item.push_backDummyDefault();
 
@@ -433,31 +627,35 @@ DeckItem scan_item( const ParserItem& p, RawRecord& record ) {
     return item;
 }
 
-}
-
-
 /// Scans the records data according to the ParserItems definition.
 /// returns a DeckItem object.
 /// NOTE: data are popped from the records deque!
 DeckItem ParserItem::scan( RawRecord& record ) const {
     switch( this->type ) {
         case type_tag::integer:
-            return scan_item< int >( *this, record );
+            return scan_item< int >( *this, this->m_name, record );
         case type_tag::fdouble:
-            return scan_item< double >( *this, record );
+            return scan_item< double >( *this, this->m_name, record );
         case type_tag::string:
-            return scan_item< std::string >( *this, record );
+            return scan_item< std::string >( *this, this->m_name, record );
         default:
             throw std::logic_error( "Fatal error; should not be reachable" );
     }
 }
 
-std::ostream& ParserItem::inlineClass( std::ostream& stream, const std::string& indent ) const {
+/*
+ * The index is the position of the item in its record, which the typed
+ * DeckRecord::getItem< Item >() looks at before searching by name.
+ */
+std::ostream& ParserItem::inlineClass( std::ostream& stream,
+                                       const std::string& indent,
+                                       size_t index ) const {
     std::string local_indent = indent + "    ";
 
     stream << indent << "class " << this->className() << " {" << std::endl
            << indent << "public:" << std::endl
-           << local_indent << "static const std::string itemName;" << std::endl;
+           << local_indent << "static const std::string itemName;" << std::endl
+           << local_indent << "static constexpr size_t itemIndex = " << index << ";" << std::endl;
 
     if( this->hasDefault() ) {
         stream << local_indent << "static const "
@@ -476,6 +674,9 @@ std::string ParserItem::inlineClassInit(const std::string& parentClass,
        << "::" << this->className()
        << "::itemName = \"" << this->name()
        << "\";" << std::endl;
+    ss << "constexpr size_t " << parentClass
+       << "::" << this->className()
+       << "::itemIndex;" << std::endl;
 
     if( !this->hasDefault() ) return ss.str();
 
@@ -561,4 +762,12 @@ template const int& ParserItem::getDefault() const;
 template const double& ParserItem::getDefault() const;
 template const std::string& ParserItem::getDefault() const;
 
+template DeckItem ParserItem::scanSingle< int >( InternedString, RawRecord& );
+template DeckItem ParserItem::scanSingle< double >( InternedString, RawRecord& );
+template DeckItem ParserItem::scanSingle< std::string >( InternedString, RawRecord& );
+
+template DeckItem ParserItem::scanSingle( InternedString, RawRecord&, const int& );
+template DeckItem ParserItem::scanSingle( InternedString, RawRecord&, const double& );
+template DeckItem ParserItem::scanSingle( InternedString, RawRecord&, const std::string& );
+
 }
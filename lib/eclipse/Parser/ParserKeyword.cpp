@@ -25,8 +25,10 @@
 
 #include <opm/json/JsonObject.hpp>
 
+#include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Parser/ParseProfile.hpp>
 #include <opm/parser/eclipse/Parser/ParserConst.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
@@ -37,6 +39,49 @@
 
 namespace Opm {
 
+namespace {
+
+    /*
+     * Records of single items, which is most of the records in the schedule
+     * section, are scanned by a function with the item types, names and
+     * defaults compiled in, instead of looping over the item definitions.
+     */
+    bool scannable( const ParserRecord& record ) {
+        return !record.isDataRecord()
+            && record.size() > 0
+            && std::all_of( record.begin(), record.end(),
+                            []( const ParserItem& item ) { return item.scalar(); } );
+    }
+
+    std::string scannerName( const std::string& className, size_t recordIndex ) {
+        return "scan_" + className + "_" + std::to_string( recordIndex );
+    }
+
+    std::string createScanner( const ParserRecord& record, const std::string& name ) {
+        std::stringstream ss;
+        ss << "std::vector< DeckItem > " << name << "( RawRecord& record ) {" << std::endl;
+
+        ss << "    static const InternedString names[] = {";
+        for( const auto& item : record )
+            ss << " \"" << item.name() << "\",";
+        ss << " };" << std::endl;
+
+        ss << "    std::vector< DeckItem > items;" << std::endl
+           << "    items.reserve( " << record.size() << " );" << std::endl;
+
+        size_t index = 0;
+        for( const auto& item : record ) {
+            const auto itemName = "names[ " + std::to_string( index++ ) + " ]";
+            ss << "    items.push_back( " << item.createScanCode( itemName, "record" ) << " );" << std::endl;
+        }
+
+        ss << "    return items;" << std::endl
+           << "}" << std::endl;
+        return ss.str();
+    }
+
+}
+
     void ParserKeyword::setSizeType( ParserKeywordSizeEnum sizeType ) {
         m_keywordSizeType = sizeType;
     }
@@ -481,13 +526,20 @@ void set_dimensions( ParserItem& item,
         keyword.setLocation( rawKeyword->getFilename(), rawKeyword->getLineNR() );
         keyword.setDataKeyword( isDataKeyword() );
 
+        auto* sample = ParseProfile::current();
+
         size_t record_nr = 0;
         for( auto& rawRecord : *rawKeyword ) {
             if( m_records.size() == 0 && rawRecord.size() > 0 )
                 throw std::invalid_argument("Missing item information " + rawKeyword->getKeywordName());
 
+            const auto start = sample ? ParseProfile::clock::now()
+                                      : ParseProfile::clock::time_point();
+
             keyword.addRecord( getRecord( record_nr ).parse( parseContext, msgContainer, rawRecord ) );
             record_nr++;
+
+            if( sample ) sample->recordSeconds += ParseProfile::since( start );
         }
 
         return keyword;
@@ -523,6 +575,10 @@ void set_dimensions( ParserItem& item,
         return !m_matchRegexString.empty();
     }
 
+    const std::string& ParserKeyword::getMatchRegex() const {
+        return m_matchRegexString;
+    }
+
     void ParserKeyword::setMatchRegex(const std::string& deckNameRegexp) {
         try {
             m_matchRegex = boost::regex(deckNameRegexp);
@@ -561,9 +617,10 @@ void set_dimensions( ParserItem& item,
             ss << local_indent << "static const std::string keywordName;" << std::endl;
             if (m_records.size() > 0 ) {
                 for( const auto& record : *this ) {
+                    size_t index = 0;
                     for( const auto& item : record ) {
                         ss << std::endl;
-                        item.inlineClass(ss , local_indent );
+                        item.inlineClass(ss , local_indent, index++ );
                     }
                 }
             }
@@ -583,6 +640,17 @@ void set_dimensions( ParserItem& item,
         const std::string lhs = "keyword";
         const std::string indent = "  ";
 
+        {
+            size_t recordIndex = 0;
+            for( const auto& record : *this ) {
+                if( scannable( record ) )
+                    ss << "namespace {" << std::endl
+                       << createScanner( record, scannerName( className(), recordIndex ) )
+                       << "}" << std::endl << std::endl;
+                ++recordIndex;
+            }
+        }
+
         ss << className() << "::" << className() << "( ) : ParserKeyword(\"" << m_name << "\") {" << std::endl;
         {
             const std::string sizeString(ParserKeywordSizeEnum2String(m_keywordSizeType));
@@ -631,6 +699,7 @@ void set_dimensions( ParserItem& item,
 
         {
             if (m_records.size() > 0 ) {
+                size_t recordIndex = 0;
                 for( const auto& record : *this ) {
                     const std::string local_indent = indent + "   ";
                     ss << indent << "{" << std::endl;
@@ -654,6 +723,11 @@ void set_dimensions( ParserItem& item,
                         ss << local_indent << "}" << std::endl;
                     }
 
+                    if( scannable( record ) )
+                        ss << local_indent << "record.setScanner( &"
+                           << scannerName( className(), recordIndex ) << " );" << std::endl;
+                    ++recordIndex;
+
                     if (record.isDataRecord())
                         ss << local_indent << "addDataRecord( record );" << std::endl;
                     else
@@ -677,10 +751,14 @@ void set_dimensions( ParserItem& item,
 
 
     void ParserKeyword::applyUnitsToDeck( Deck& deck, DeckKeyword& deckKeyword) const {
+        this->applyUnitsToDeck( deck.getActiveUnitSystem(), deck.getDefaultUnitSystem(), deckKeyword );
+    }
+
+    void ParserKeyword::applyUnitsToDeck( UnitSystem& active, UnitSystem& defaults, DeckKeyword& deckKeyword) const {
         for (size_t index = 0; index < deckKeyword.size(); index++) {
             const auto& parserRecord = this->getRecord( index );
             auto& deckRecord = deckKeyword.getRecord( index );
-            parserRecord.applyUnitsToDeck( deck, deckRecord );
+            parserRecord.applyUnitsToDeck( active, defaults, deckRecord );
         }
     }
 
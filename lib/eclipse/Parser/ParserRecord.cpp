@@ -59,6 +59,7 @@ namespace {
             throw std::invalid_argument("Itemname: " + item.name() + " already exists.");
 
         this->m_items.push_back( std::move( item ) );
+        this->m_scanner = nullptr;
     }
 
     void ParserRecord::addDataItem( ParserItem item ) {
@@ -89,14 +90,20 @@ namespace {
 
 
     void ParserRecord::applyUnitsToDeck( Deck& deck, DeckRecord& deckRecord ) const {
+        this->applyUnitsToDeck( deck.getActiveUnitSystem(), deck.getDefaultUnitSystem(), deckRecord );
+    }
+
+    void ParserRecord::applyUnitsToDeck( UnitSystem& active, UnitSystem& defaults, DeckRecord& deckRecord ) const {
         for( const auto& item : *this ) {
             if( !item.hasDimension() ) continue;
 
             auto& deckItem = deckRecord.getItem( item.name() );
+            /* converted when it was parsed */
+            if( deckItem.storesSI() ) continue;
 
             for (size_t idim = 0; idim < item.numDimensions(); idim++) {
-                auto activeDimension  = deck.getActiveUnitSystem().getNewDimension( item.getDimension(idim) );
-                auto defaultDimension = deck.getDefaultUnitSystem().getNewDimension( item.getDimension(idim) );
+                auto activeDimension  = active.getNewDimension( item.getDimension(idim) );
+                auto defaultDimension = defaults.getNewDimension( item.getDimension(idim) );
                 deckItem.push_backDimension( activeDimension , defaultDimension );
             }
         }
@@ -126,9 +133,13 @@ namespace {
 
     DeckRecord ParserRecord::parse(const ParseContext& parseContext , MessageContainer& msgContainer, RawRecord& rawRecord ) const {
         std::vector< DeckItem > items;
-        items.reserve( this->size() + 20 );
-        for( const auto& parserItem : *this )
-            items.emplace_back( parserItem.scan( rawRecord ) );
+        if( this->m_scanner ) {
+            items = this->m_scanner( rawRecord );
+        } else {
+            items.reserve( this->size() + 20 );
+            for( const auto& parserItem : *this )
+                items.emplace_back( parserItem.scan( rawRecord ) );
+        }
 
         if (rawRecord.size() > 0) {
             std::string msg = "The RawRecord for keyword \""  + rawRecord.getKeywordName() + "\" in file\"" + rawRecord.getFileName() + "\" contained " +
@@ -140,6 +151,14 @@ namespace {
         return { std::move( items ) };
     }
 
+    void ParserRecord::setScanner( item_scanner scanner ) {
+        this->m_scanner = scanner;
+    }
+
+    bool ParserRecord::hasScanner() const {
+        return this->m_scanner != nullptr;
+    }
+
     bool ParserRecord::equal(const ParserRecord& other) const {
         bool equal_ = true;
         if (size() == other.size()) {
@@ -0,0 +1,183 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cctype>
+#include <limits>
+
+#include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+#include <opm/parser/eclipse/Parser/WildcardTrie.hpp>
+
+namespace Opm {
+
+namespace {
+
+using range = std::pair< size_t, size_t >;
+
+/* the position of the ')' that closes the group opened at pos */
+size_t group_end( const std::string& re, size_t pos, size_t end ) {
+    int depth = 0;
+    for( ; pos < end; ++pos ) {
+        switch( re[ pos ] ) {
+            case '\\': ++pos; break;
+            case '[':
+                while( pos < end && re[ pos ] != ']' ) ++pos;
+                break;
+            case '(': ++depth; break;
+            case ')': if( --depth == 0 ) return pos; break;
+            default: break;
+        }
+    }
+
+    return end;
+}
+
+/* the alternatives of the expression in [begin, end), split at '|' */
+std::vector< range > alternatives( const std::string& re, size_t begin, size_t end ) {
+    std::vector< range > alts;
+    auto start = begin;
+    for( auto pos = begin; pos < end; ++pos ) {
+        switch( re[ pos ] ) {
+            case '\\': ++pos; break;
+            case '[':
+                while( pos < end && re[ pos ] != ']' ) ++pos;
+                break;
+            case '(': pos = group_end( re, pos, end ); break;
+            case '|':
+                alts.emplace_back( start, pos );
+                start = pos + 1;
+                break;
+            default: break;
+        }
+    }
+
+    alts.emplace_back( start, end );
+    return alts;
+}
+
+bool optional( const std::string& re, size_t pos, size_t end ) {
+    return pos < end && ( re[ pos ] == '?' || re[ pos ] == '*' || re[ pos ] == '{' );
+}
+
+std::vector< std::string > alt_prefixes( const std::string& re, range alt ) {
+    std::string literal;
+    auto pos = alt.first;
+    if( pos < alt.second && re[ pos ] == '^' ) ++pos;
+
+    while( pos < alt.second ) {
+        const auto c = re[ pos ];
+        if( !std::isalnum( (unsigned char)c ) && c != '_' && c != '-' ) break;
+        literal.push_back( c );
+        ++pos;
+    }
+
+    /* a quantifier makes the last character, or the group, optional */
+    if( optional( re, pos, alt.second ) ) {
+        if( !literal.empty() ) literal.pop_back();
+        return { literal };
+    }
+
+    if( pos == alt.second || re[ pos ] != '(' )
+        return { literal };
+
+    const auto close = group_end( re, pos, alt.second );
+    if( close == alt.second || optional( re, close + 1, alt.second ) )
+        return { literal };
+
+    std::vector< std::string > result;
+    for( const auto& inner : alternatives( re, pos + 1, close ) ) {
+        for( const auto& prefix : alt_prefixes( re, inner ) )
+            result.push_back( literal + prefix );
+    }
+
+    return result;
+}
+
+}
+
+WildcardTrie::WildcardTrie() : nodes( 1 ) {}
+
+std::vector< std::string > WildcardTrie::prefixes( const std::string& regex ) {
+    std::vector< std::string > result;
+    for( const auto& alt : alternatives( regex, 0, regex.size() ) ) {
+        for( auto& prefix : alt_prefixes( regex, alt ) )
+            result.push_back( std::move( prefix ) );
+    }
+
+    return result;
+}
+
+void WildcardTrie::insert( const ParserKeyword* keyword ) {
+    const auto ordinal = this->count++;
+
+    for( const auto& prefix : WildcardTrie::prefixes( keyword->getMatchRegex() ) ) {
+        size_t current = 0;
+        for( const auto c : prefix ) {
+            size_t next = 0;
+            for( const auto& child : this->nodes[ current ].children ) {
+                if( child.first == c ) next = child.second;
+            }
+
+            if( next == 0 ) {
+                next = this->nodes.size();
+                this->nodes[ current ].children.emplace_back( c, next );
+                this->nodes.emplace_back();
+            }
+
+            current = next;
+        }
+
+        auto& keywords = this->nodes[ current ].keywords;
+        if( keywords.empty() || keywords.back().first != ordinal )
+            keywords.emplace_back( ordinal, keyword );
+    }
+}
+
+const ParserKeyword* WildcardTrie::match( const string_view& name ) const {
+    auto best = std::numeric_limits< size_t >::max();
+    const ParserKeyword* keyword = nullptr;
+
+    const auto try_node = [&]( const node& n ) {
+        for( const auto& candidate : n.keywords ) {
+            if( candidate.first >= best ) continue;
+            if( !candidate.second->matches( name ) ) continue;
+
+            best = candidate.first;
+            keyword = candidate.second;
+        }
+    };
+
+    size_t current = 0;
+    try_node( this->nodes[ current ] );
+
+    for( const auto c : name ) {
+        size_t next = 0;
+        for( const auto& child : this->nodes[ current ].children ) {
+            if( child.first == c ) next = child.second;
+        }
+
+        if( next == 0 ) break;
+
+        current = next;
+        try_node( this->nodes[ current ] );
+    }
+
+    return keyword;
+}
+
+}
@@ -0,0 +1,286 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined( __AVX2__ )
+    #include <immintrin.h>
+    #define OPM_LEXER_AVX2
+#elif defined( __SSE2__ ) || defined( _M_X64 ) \
+   || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+    #include <emmintrin.h>
+    #define OPM_LEXER_SSE2
+#endif
+
+#if defined( _MSC_VER ) && ( defined( OPM_LEXER_AVX2 ) || defined( OPM_LEXER_SSE2 ) )
+    #include <intrin.h>
+#endif
+
+#include <opm/parser/eclipse/RawDeck/Lexer.hpp>
+#include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
+
+namespace Opm {
+namespace lexer {
+
+namespace {
+
+const RawConsts::is_separator is_separator {};
+
+struct is_special {
+    bool operator()( char ch ) const {
+        return ch == '\n' || ch == '-' || ch == '/' || RawConsts::is_quote()( ch );
+    }
+};
+
+struct is_either {
+    char fst, snd;
+    bool operator()( char ch ) const { return ch == fst || ch == snd; }
+};
+
+#if defined( OPM_LEXER_AVX2 ) || defined( OPM_LEXER_SSE2 )
+
+/*
+ * The vectorised kernels all work the same way: a block of the input is
+ * classified into a bitmask, with bit n set if character n matched. The first
+ * match in the block is then the number of trailing zeros of the mask.
+ */
+constexpr std::ptrdiff_t block_size = 32;
+
+inline int first_bit( std::uint32_t mask ) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward( &index, mask );
+    return int( index );
+#else
+    return __builtin_ctz( mask );
+#endif
+}
+
+#ifdef OPM_LEXER_AVX2
+
+using vec = __m256i;
+
+inline vec load( const char* p ) {
+    return _mm256_loadu_si256( reinterpret_cast< const vec* >( p ) );
+}
+
+inline vec splat( char ch ) { return _mm256_set1_epi8( ch ); }
+inline vec eq( vec lhs, vec rhs ) { return _mm256_cmpeq_epi8( lhs, rhs ); }
+inline vec or_( vec lhs, vec rhs ) { return _mm256_or_si256( lhs, rhs ); }
+inline vec and_( vec lhs, vec rhs ) { return _mm256_and_si256( lhs, rhs ); }
+inline vec sub( vec lhs, vec rhs ) { return _mm256_sub_epi8( lhs, rhs ); }
+inline vec min_u8( vec lhs, vec rhs ) { return _mm256_min_epu8( lhs, rhs ); }
+
+template< typename Classify >
+inline std::uint32_t block_mask( const char* p, Classify classify ) {
+    return std::uint32_t( _mm256_movemask_epi8( classify( load( p ) ) ) );
+}
+
+#else
+
+using vec = __m128i;
+
+inline vec load( const char* p ) {
+    return _mm_loadu_si128( reinterpret_cast< const vec* >( p ) );
+}
+
+inline vec splat( char ch ) { return _mm_set1_epi8( ch ); }
+inline vec eq( vec lhs, vec rhs ) { return _mm_cmpeq_epi8( lhs, rhs ); }
+inline vec or_( vec lhs, vec rhs ) { return _mm_or_si128( lhs, rhs ); }
+inline vec and_( vec lhs, vec rhs ) { return _mm_and_si128( lhs, rhs ); }
+inline vec sub( vec lhs, vec rhs ) { return _mm_sub_epi8( lhs, rhs ); }
+inline vec min_u8( vec lhs, vec rhs ) { return _mm_min_epu8( lhs, rhs ); }
+
+/* SSE2 registers are 16 bytes wide, so a block is two registers */
+template< typename Classify >
+inline std::uint32_t block_mask( const char* p, Classify classify ) {
+    const auto lo = std::uint32_t( _mm_movemask_epi8( classify( load( p ) ) ) );
+    const auto hi = std::uint32_t( _mm_movemask_epi8( classify( load( p + 16 ) ) ) );
+    return lo | ( hi << 16 );
+}
+
+#endif
+
+/* non-ascii characters are classified by their 7 lower bits, as in RawConsts */
+inline vec ascii( vec v ) { return and_( v, splat( 0x7f ) ); }
+
+struct separators {
+    vec operator()( vec v ) const {
+        v = ascii( v );
+        /* \t, \n, \v, \f and \r are the contiguous range [9, 13] */
+        const auto ctrl = sub( v, splat( 9 ) );
+        return or_( or_( eq( v, splat( ' ' ) ), eq( v, splat( ',' ) ) ),
+                    eq( min_u8( ctrl, splat( 4 ) ), ctrl ) );
+    }
+};
+
+struct specials {
+    vec operator()( vec v ) const {
+        const auto masked = ascii( v );
+        return or_( or_( or_( eq( v, splat( '\n' ) ), eq( v, splat( '-' ) ) ),
+                         or_( eq( v, splat( '/' ) ), eq( masked, splat( '"' ) ) ) ),
+                    eq( masked, splat( '\'' ) ) );
+    }
+};
+
+struct either {
+    vec fst, snd;
+    vec operator()( vec v ) const { return or_( eq( v, fst ), eq( v, snd ) ); }
+};
+
+template< typename Classify, typename Pred >
+inline const char* find( const char* begin, const char* end,
+                         Classify classify, Pred pred,
+                         std::uint32_t flip = 0 ) {
+    while( end - begin >= block_size ) {
+        const auto mask = block_mask( begin, classify ) ^ flip;
+        if( mask ) return begin + first_bit( mask );
+        begin += block_size;
+    }
+
+    return std::find_if( begin, end, pred );
+}
+
+#endif
+
+}
+
+const char* find_special( const char* begin, const char* end ) {
+#if defined( OPM_LEXER_AVX2 ) || defined( OPM_LEXER_SSE2 )
+    return find( begin, end, specials(), is_special() );
+#else
+    return std::find_if( begin, end, is_special() );
+#endif
+}
+
+const char* find_separator( const char* begin, const char* end ) {
+#if defined( OPM_LEXER_AVX2 ) || defined( OPM_LEXER_SSE2 )
+    return find( begin, end, separators(), is_separator );
+#else
+    return std::find_if( begin, end, is_separator );
+#endif
+}
+
+const char* skip_separators( const char* begin, const char* end ) {
+    /*
+     * Most tokens are preceeded by a single space, so check the first
+     * character before setting up the block scan.
+     */
+    if( begin == end || !is_separator( *begin ) ) return begin;
+    ++begin;
+
+#if defined( OPM_LEXER_AVX2 ) || defined( OPM_LEXER_SSE2 )
+    return find( begin, end, separators(),
+                 []( char ch ) { return !is_separator( ch ); },
+                 0xFFFFFFFF );
+#else
+    return std::find_if_not( begin, end, is_separator );
+#endif
+}
+
+namespace {
+
+inline const char* find_either( const char* begin, const char* end,
+                                char fst, char snd ) {
+#if defined( OPM_LEXER_AVX2 ) || defined( OPM_LEXER_SSE2 )
+    return find( begin, end, either{ splat( fst ), splat( snd ) },
+                 is_either{ fst, snd } );
+#else
+    return std::find_if( begin, end, is_either{ fst, snd } );
+#endif
+}
+
+inline const char* find_newline( const char* begin, const char* end ) {
+    const void* nl = std::memchr( begin, '\n', end - begin );
+    return nl ? static_cast< const char* >( nl ) : end;
+}
+
+}
+
+char* clean( string_view input, char* dst ) {
+    const auto* current = input.begin();
+    const auto* end = input.end();
+
+    while( current != end ) {
+        /*
+         * Scan the line for the first character that may end the interesting
+         * part of it. Quoted strings are skipped, so that comment markers and
+         * slashes in them are kept. A quote that isn't closed on this line
+         * keeps the rest of it, comments and slashes included.
+         */
+        const char* data_end = end;
+        const char* line_end = end;
+
+        auto pos = current;
+        while( (pos = find_special( pos, end )) != end ) {
+            const char ch = *pos;
+
+            if( ch == '\n' ) {
+                data_end = line_end = pos;
+                break;
+            }
+
+            if( ch == '-' ) {
+                if( pos + 1 == end || *(pos + 1) != '-' ) {
+                    ++pos;
+                    continue;
+                }
+
+                data_end = pos;
+                line_end = find_newline( pos, end );
+                break;
+            }
+
+            if( ch == RawConsts::slash ) {
+                /* we want to preserve terminating slashes */
+                data_end = pos + 1;
+                line_end = find_newline( data_end, end );
+                break;
+            }
+
+            const auto* qend = find_either( pos + 1, end, ch, '\n' );
+            if( qend == end || *qend == '\n' ) {
+                data_end = line_end = qend;
+                break;
+            }
+
+            pos = qend + 1;
+        }
+
+        const auto* first = skip_separators( current, data_end );
+        auto last = data_end;
+        while( last != first && is_separator( *(last - 1) ) ) --last;
+
+        std::memmove( dst, first, last - first );
+        dst += last - first;
+
+        /* only terminate lines that were terminated in the input */
+        if( line_end == end ) break;
+
+        *dst++ = '\n';
+        current = line_end + 1;
+    }
+
+    return dst;
+}
+
+}
+}
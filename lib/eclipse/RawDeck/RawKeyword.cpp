@@ -20,6 +20,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+#include <opm/parser/eclipse/RawDeck/Lexer.hpp>
 #include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
@@ -47,6 +48,7 @@ namespace Opm {
         } else {
             m_sizeType = Raw::FIXED;
             m_fixedSize = inputSize;
+            m_records.reserve( m_fixedSize );
             if (m_fixedSize == 0)
                 m_isFinished = true;
             else
@@ -55,6 +57,58 @@ namespace Opm {
     }
 
 
+    /*
+     * The records refer to the token arena of the keyword they belong to, so
+     * a copy has to point them to its own.
+     */
+    RawKeyword::RawKeyword( const RawKeyword& other ) :
+        m_sizeType( other.m_sizeType ),
+        m_isFinished( other.m_isFinished ),
+        m_fixedSize( other.m_fixedSize ),
+        m_numTables( other.m_numTables ),
+        m_currentNumTables( other.m_currentNumTables ),
+        m_name( other.m_name ),
+        m_records( other.m_records ),
+        m_partialRecordString( other.m_partialRecordString ),
+        m_tokens( other.m_tokens ),
+        m_split( other.m_split ),
+        m_lineNR( other.m_lineNR ),
+        m_filename( other.m_filename ),
+        m_is_title( other.m_is_title )
+    {
+        const auto* src = other.m_tokens.data();
+        auto* dst = this->m_tokens.data();
+
+        for( auto& record : this->m_records ) {
+            if( !record.m_split || record.ownsItems() ) continue;
+
+            record.m_lower = dst + ( record.m_lower - src );
+            record.m_first = dst + ( record.m_first - src );
+            record.m_last = dst + ( record.m_last - src );
+        }
+    }
+
+    RawKeyword& RawKeyword::operator=( const RawKeyword& other ) {
+        if( this == &other ) return *this;
+
+        RawKeyword tmp( other );
+        std::swap( this->m_sizeType, tmp.m_sizeType );
+        std::swap( this->m_isFinished, tmp.m_isFinished );
+        std::swap( this->m_fixedSize, tmp.m_fixedSize );
+        std::swap( this->m_numTables, tmp.m_numTables );
+        std::swap( this->m_currentNumTables, tmp.m_currentNumTables );
+        std::swap( this->m_name, tmp.m_name );
+        std::swap( this->m_records, tmp.m_records );
+        std::swap( this->m_partialRecordString, tmp.m_partialRecordString );
+        std::swap( this->m_tokens, tmp.m_tokens );
+        std::swap( this->m_split, tmp.m_split );
+        std::swap( this->m_lineNR, tmp.m_lineNR );
+        std::swap( this->m_filename, tmp.m_filename );
+        std::swap( this->m_is_title, tmp.m_is_title );
+
+        return *this;
+    }
+
     void RawKeyword::commonInit(const std::string& name , const std::string& filename, size_t lineNR) {
         setKeywordName( name );
         m_filename = filename;
@@ -128,7 +182,53 @@ namespace Opm {
     }
 
     const RawRecord& RawKeyword::getFirstRecord() const {
-        return *m_records.begin();
+        return *this->begin();
+    }
+
+    /*
+     * Split all the records that are not already split into the token arena,
+     * and point the records to their part of it once it has stopped growing.
+     */
+    void RawKeyword::split() const {
+        if( this->m_split ) return;
+
+        std::vector< size_t > ends;
+        ends.reserve( this->m_records.size() );
+        for( const auto& record : this->m_records ) {
+            if( !record.m_split )
+                lexer::tokenize( record.m_sanitizedRecordString, this->m_tokens );
+            ends.push_back( this->m_tokens.size() );
+        }
+
+        auto* first = this->m_tokens.data();
+        for( size_t i = 0; i < this->m_records.size(); ++i ) {
+            auto* last = this->m_tokens.data() + ends[ i ];
+            if( !this->m_records[ i ].m_split )
+                this->m_records[ i ].bind( first, last );
+            first = last;
+        }
+
+        this->m_split = true;
+    }
+
+    void RawKeyword::setTokenArena( std::vector< string_view >&& arena ) {
+        if( this->m_split )
+            throw std::logic_error( "The token arena of " + m_name.string() + " is already in use" );
+
+        this->m_tokens = std::move( arena );
+        this->m_tokens.clear();
+    }
+
+    /*
+     * The records that were split into the arena refer to it, so they can't be
+     * used once it is released.
+     */
+    std::vector< string_view > RawKeyword::releaseTokenArena() {
+        auto arena = std::move( this->m_tokens );
+        this->m_tokens.clear();
+        this->m_records.clear();
+        this->m_split = false;
+        return arena;
     }
 
     bool RawKeyword::isKeywordPrefix(const string_view& line, std::string& keyword ) {
@@ -145,14 +245,15 @@ namespace Opm {
     }
 
     void RawKeyword::setKeywordName(const std::string& name) {
-        m_name = boost::algorithm::trim_right_copy(name);
-        if (!isValidKeyword(m_name)) {
+        const auto trimmed = boost::algorithm::trim_right_copy(name);
+        if (!isValidKeyword(trimmed)) {
             throw std::invalid_argument("Not a valid keyword:" + name);
-        } else if (m_name.size() > Opm::RawConsts::maxKeywordLength) {
+        } else if (trimmed.size() > Opm::RawConsts::maxKeywordLength) {
             throw std::invalid_argument("Too long keyword:" + name);
-        } else if (boost::algorithm::trim_left_copy(m_name) != m_name) {
+        } else if (boost::algorithm::trim_left_copy(trimmed) != trimmed) {
             throw std::invalid_argument("Illegal whitespace start of keyword:" + name);
         }
+        m_name = trimmed;
     }
 
     bool RawKeyword::isPartialRecordStringEmpty() const {
@@ -164,7 +265,7 @@ namespace Opm {
         if (m_sizeType == Raw::UNKNOWN)
             m_isFinished = true;
         else
-            throw std::invalid_argument("Fatal error finalizing keyword:" + m_name + " Only RawKeywords with UNKNOWN size can be explicitly finalized.");
+            throw std::invalid_argument("Fatal error finalizing keyword:" + m_name.string() + " Only RawKeywords with UNKNOWN size can be explicitly finalized.");
     }
 
 
@@ -180,7 +281,16 @@ namespace Opm {
         return m_lineNR;
     }
 
+    size_t RawKeyword::getByteSize() const {
+        size_t bytes = 0;
+        for( const auto& record : this->m_records )
+            bytes += record.m_sanitizedRecordString.size();
+
+        return bytes;
+    }
+
     RawKeyword::const_iterator RawKeyword::begin() const {
+        this->split();
         return this->m_records.begin();
     }
 
@@ -189,6 +299,7 @@ namespace Opm {
     }
 
     RawKeyword::iterator RawKeyword::begin() {
+        this->split();
         return this->m_records.begin();
     }
 
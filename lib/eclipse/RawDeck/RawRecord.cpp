@@ -21,8 +21,8 @@
 #include <iostream>
 #include <stdexcept>
 #include <vector>
-#include <deque>
 
+#include <opm/parser/eclipse/RawDeck/Lexer.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 
@@ -35,30 +35,6 @@ namespace Opm {
 
 namespace {
 
-std::deque< string_view > splitSingleRecordString( const string_view& record ) {
-    auto first_nonspace = []( string_view::const_iterator begin,
-                              string_view::const_iterator end ) {
-        return std::find_if_not( begin, end, RawConsts::is_separator() );
-    };
-
-    std::deque< string_view > dst;
-    auto current = record.begin();
-    while( (current = first_nonspace( current, record.end() )) != record.end() )
-    {
-        if( *current == RawConsts::quote ) {
-            auto quote_end = std::find( current + 1, record.end(), RawConsts::quote ) + 1;
-            dst.push_back( { current, quote_end } );
-            current = quote_end;
-        } else {
-            auto token_end = std::find_if( current, record.end(), RawConsts::is_separator() );
-            dst.push_back( { current, token_end } );
-            current = token_end;
-        }
-    }
-
-    return dst;
-}
-
 /*
     * It is assumed that after a record is terminated, there is no quote marks
     * in the subsequent comment. This is in accordance with the Eclipse user
@@ -76,13 +52,18 @@ inline bool even_quotes( const T& str ) {
 
 }
 
+    static const std::string emptystr = "";
+
+    RawRecord::RawRecord(const string_view& singleRecordString) :
+        RawRecord( singleRecordString, emptystr, emptystr )
+    {}
+
     RawRecord::RawRecord(const string_view& singleRecordString,
                          const std::string& fileName,
                          const std::string& keywordName) :
         m_sanitizedRecordString( singleRecordString ),
-        m_recordItems( splitSingleRecordString( m_sanitizedRecordString ) ),
-        m_fileName(fileName),
-        m_keywordName(keywordName)
+        m_fileName( &fileName ),
+        m_keywordName( &keywordName )
     {
 
         if( !even_quotes( singleRecordString ) )
@@ -92,23 +73,94 @@ inline bool even_quotes( const T& str ) {
             );
     }
 
+    /*
+     * A copy of a record with its own items gets its own copy of them. Items
+     * in the arena of a keyword are shared, and rebound by the keyword when
+     * the keyword itself is copied.
+     */
+    RawRecord::RawRecord( const RawRecord& other ) :
+        m_sanitizedRecordString( other.m_sanitizedRecordString ),
+        m_lower( other.m_lower ),
+        m_first( other.m_first ),
+        m_last( other.m_last ),
+        m_split( other.m_split ),
+        m_fileName( other.m_fileName ),
+        m_keywordName( other.m_keywordName )
+    {
+        if( !other.ownsItems() ) return;
+
+        this->m_items = other.m_items;
+        auto* base = this->m_items.data();
+        this->m_lower = base;
+        this->m_first = base + ( other.m_first - other.m_lower );
+        this->m_last = base + ( other.m_last - other.m_lower );
+    }
+
+    RawRecord& RawRecord::operator=( const RawRecord& other ) {
+        RawRecord tmp( other );
+        return *this = std::move( tmp );
+    }
+
     const std::string& RawRecord::getFileName() const {
-        return m_fileName;
+        return *m_fileName;
     }
 
     const std::string& RawRecord::getKeywordName() const {
-        return m_keywordName;
+        return *m_keywordName;
+    }
+
+    void RawRecord::splitRecordString() const {
+        lexer::tokenize( this->m_sanitizedRecordString, this->m_items );
+        auto* base = this->m_items.data();
+        this->bind( base, base + this->m_items.size() );
+    }
+
+    void RawRecord::bind( string_view* first, string_view* last ) const {
+        this->m_lower = first;
+        this->m_first = first;
+        this->m_last = last;
+        this->m_split = true;
     }
 
+    bool RawRecord::ownsItems() const {
+        return this->m_split && this->m_lower == this->m_items.data();
+    }
+
+    /*
+     * Move the remaining items into m_items, with room for headroom items in
+     * front of them.
+     */
+    void RawRecord::own( size_t headroom ) {
+        std::vector< string_view > items( headroom + this->size() );
+        std::copy( this->m_first, this->m_last, items.begin() + headroom );
+        this->m_items.swap( items );
+
+        auto* base = this->m_items.data();
+        this->bind( base, base + this->m_items.size() );
+        this->m_first += headroom;
+    }
+
+    /*
+     * The items that have been popped are never looked at again, so prepend
+     * reuses their slots, and only has to move the items when there are more
+     * new ones.
+     */
     void RawRecord::prepend( size_t count, string_view tok ) {
-        this->m_recordItems.insert( this->m_recordItems.begin(), count, tok );
+        this->split();
+
+        if( size_t( this->m_first - this->m_lower ) < count )
+            this->own( count );
+
+        this->m_first -= count;
+        std::fill( this->m_first, this->m_first + count, tok );
     }
 
     void RawRecord::dump() const {
         std::cout << "RecordDump: ";
-        for (size_t i = 0; i < m_recordItems.size(); i++) {
+        this->split();
+        for (size_t i = 0; i < this->size(); i++) {
             std::cout
-                << this->m_recordItems[i] << "/"
+                << this->m_first[i] << "/"
                 << getItem( i ) << " ";
         }
         std::cout << std::endl;
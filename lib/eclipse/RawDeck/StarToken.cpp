@@ -22,15 +22,14 @@
 #include <cctype>
 #include <string>
 #include <stdexcept>
+#include <cstdint>
 #include <cstdlib>
-
-#include <boost/spirit/include/qi.hpp>
+#include <cstring>
+#include <limits>
 
 #include <opm/parser/eclipse/RawDeck/StarToken.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
-namespace qi = boost::spirit::qi;
-
 namespace Opm {
 
     bool isStarToken(const string_view& token,
@@ -69,39 +68,211 @@ namespace Opm {
         return true;
     }
 
-    template<>
-    int readValueToken< int >( string_view view ) {
-        int n = 0;
-        auto cursor = view.begin();
-        const bool ok = qi::parse( cursor, view.end(), qi::int_, n );
+    namespace {
 
-        if( ok && cursor == view.end() ) return n;
-        throw std::invalid_argument( "Malformed integer '" + view + "'" );
+    inline bool is_digit( char ch ) {
+        return ch >= '0' && ch <= '9';
+    }
+
+    inline bool is_exponent( char ch ) {
+        // Eclipse supports Fortran syntax for specifying exponents of floating
+        // point numbers ('D' and 'E', e.g., 1.234d5)
+        return ch == 'e' || ch == 'E' || ch == 'd' || ch == 'D';
+    }
+
+    inline bool iequal( const char* begin, const char* end, const char* str ) {
+        const auto len = std::strlen( str );
+        if( size_t( end - begin ) != len ) return false;
+
+        for( ; begin != end; ++begin, ++str )
+            if( std::tolower( static_cast< unsigned char >( *begin ) ) != *str )
+                return false;
+
+        return true;
+    }
+
+    /*
+     * All powers of ten up to 10^22 are exactly representable as doubles. When
+     * both the mantissa and the power of ten are exact, a single
+     * multiplication or division is correctly rounded (Clinger's fast path).
+     */
+    const double exact_powers[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+        1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+
+    const std::uint64_t max_exact_mantissa = std::uint64_t( 1 ) << 53;
+
+    /*
+     * The slow path for numbers with too many significant digits or too large
+     * exponents for the fast path. The number is rewritten as an integer
+     * mantissa and exponent, which is independent of the decimal point of the
+     * current locale, and handed to strtod which is correctly rounded.
+     */
+    double slow_double( const char* begin, const char* end, long exponent ) {
+        std::string buffer;
+        buffer.reserve( std::distance( begin, end ) + 24 );
+
+        long fraction_digits = 0;
+        bool fraction = false;
+        for( ; begin != end && !is_exponent( *begin ); ++begin ) {
+            if( *begin == '.' ) {
+                fraction = true;
+                continue;
+            }
+
+            buffer.push_back( *begin );
+            if( fraction && is_digit( *begin ) ) ++fraction_digits;
+        }
+
+        buffer += "e" + std::to_string( exponent - fraction_digits );
+        return std::strtod( buffer.c_str(), nullptr );
     }
 
-    template< typename T >
-    struct fortran_double : qi::real_policies< T > {
-        // Eclipse supports Fortran syntax for specifying exponents of floating point
-        // numbers ('D' and 'E', e.g., 1.234d5)
-        template< typename It >
-        static bool parse_exp( It& first, const It& last ) {
-            if( first == last ||
-                (*first != 'e' && *first != 'E' &&
-                *first != 'd' && *first != 'D' ) )
+    }
+
+    /*
+     * Parse a number in the same format as boost::spirit's real parser with
+     * Fortran exponents did: an optional sign, digits with an optional decimal
+     * point (".5" and "5." are both fine) and an optional exponent, or
+     * nan/inf/infinity. The whole token must be a number.
+     */
+    bool tryReadValueToken( string_view view, double& value ) {
+        const auto* begin = view.begin();
+        const auto* end = view.end();
+        const auto* p = begin;
+
+        if( p == end ) return false;
+
+        const bool negative = *p == '-';
+        if( *p == '+' || *p == '-' ) ++p;
+        if( p == end ) return false;
+
+        if( !is_digit( *p ) && *p != '.' ) {
+            if( iequal( p, end, "nan" ) )
+                value = std::numeric_limits< double >::quiet_NaN();
+            else if( iequal( p, end, "inf" ) || iequal( p, end, "infinity" ) )
+                value = std::numeric_limits< double >::infinity();
+            else
                 return false;
-            ++first;
+
+            if( negative ) value = -value;
             return true;
         }
-    };
+
+        /*
+         * Accumulate up to 19 significant digits, which always fits in 64
+         * bits. Further digits only move the decimal exponent, and mark the
+         * mantissa as inexact.
+         */
+        std::uint64_t mantissa = 0;
+        int significant = 0;
+        long exponent = 0;
+        bool truncated = false;
+        bool digits = false;
+
+        const auto accumulate = [&]( char ch ) {
+            if( significant < 19 ) {
+                mantissa = mantissa * 10 + ( ch - '0' );
+                if( mantissa != 0 ) ++significant;
+                return true;
+            }
+
+            if( ch != '0' ) truncated = true;
+            return false;
+        };
+
+        for( ; p != end && is_digit( *p ); ++p ) {
+            digits = true;
+            if( !accumulate( *p ) ) ++exponent;
+        }
+
+        if( p != end && *p == '.' ) {
+            for( ++p; p != end && is_digit( *p ); ++p ) {
+                digits = true;
+                if( accumulate( *p ) ) --exponent;
+            }
+        }
+
+        if( !digits ) return false;
+
+        long explicit_exponent = 0;
+        if( p != end && is_exponent( *p ) ) {
+            ++p;
+            const bool negative_exponent = p != end && *p == '-';
+            if( p != end && ( *p == '+' || *p == '-' ) ) ++p;
+            if( p == end || !is_digit( *p ) ) return false;
+
+            for( ; p != end && is_digit( *p ); ++p ) {
+                /* saturate - anything this large is inf or zero anyway */
+                if( explicit_exponent < 100000 )
+                    explicit_exponent = explicit_exponent * 10 + ( *p - '0' );
+            }
+
+            if( negative_exponent ) explicit_exponent = -explicit_exponent;
+        }
+
+        if( p != end ) return false;
+
+        exponent += explicit_exponent;
+
+        if( mantissa == 0 ) {
+            value = negative ? -0.0 : 0.0;
+            return true;
+        }
+
+        if( !truncated && mantissa <= max_exact_mantissa
+            && exponent >= -22 && exponent <= 22 ) {
+            value = double( mantissa );
+            if( exponent < 0 ) value /= exact_powers[ -exponent ];
+            else               value *= exact_powers[ exponent ];
+
+            if( negative ) value = -value;
+            return true;
+        }
+
+        value = slow_double( begin, end, explicit_exponent );
+        return true;
+    }
+
+    bool tryReadValueToken( string_view view, int& value ) {
+        const auto* p = view.begin();
+        const auto* end = view.end();
+
+        if( p == end ) return false;
+
+        const bool negative = *p == '-';
+        if( *p == '+' || *p == '-' ) ++p;
+        if( p == end ) return false;
+
+        const std::int64_t limit = negative
+                                 ? -std::int64_t( std::numeric_limits< int >::min() )
+                                 : std::numeric_limits< int >::max();
+
+        std::int64_t n = 0;
+        for( ; p != end; ++p ) {
+            if( !is_digit( *p ) ) return false;
+
+            n = n * 10 + ( *p - '0' );
+            if( n > limit ) return false;
+        }
+
+        value = int( negative ? -n : n );
+        return true;
+    }
+
+    template<>
+    int readValueToken< int >( string_view view ) {
+        int n = 0;
+        if( tryReadValueToken( view, n ) ) return n;
+        throw std::invalid_argument( "Malformed integer '" + view + "'" );
+    }
 
     template<>
     double readValueToken< double >( string_view view ) {
         double n = 0;
-        qi::real_parser< double, fortran_double< double > > double_;
-        auto cursor = view.begin();
-        const auto ok = qi::parse( cursor, view.end(), double_, n );
-
-        if( ok && cursor == view.end() ) return n;
+        if( tryReadValueToken( view, n ) ) return n;
         throw std::invalid_argument( "Malformed floating point number '" + view + "'" );
     }
 
@@ -71,6 +71,10 @@ namespace Opm {
     bool Dimension::isCompositable() const
     { return m_SIoffset == 0.0; }
 
+    bool Dimension::isContextDependent() const {
+        return !std::isfinite(m_SIfactor);
+    }
+
     Dimension Dimension::newComposite(const std::string& dim , double SIfactor, double SIoffset) {
         Dimension dimension;
         dimension.m_name = dim;
@@ -0,0 +1,105 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+#include <opm/parser/eclipse/Utility/InternedString.hpp>
+
+namespace Opm {
+
+namespace {
+
+struct view_hash {
+    size_t operator()( const string_view& view ) const {
+        /* FNV-1a */
+        size_t h = 14695981039346656037ULL;
+        for( const auto c : view ) {
+            h ^= static_cast< unsigned char >( c );
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+};
+
+/*
+ * The strings are stored in a deque, which never moves its elements, and
+ * looked up by views into them, so that a lookup doesn't need a copy of the
+ * string it looks for.
+ */
+class string_pool {
+    public:
+        string_pool() {
+            this->empty = &this->get( string_view{ "" } );
+        }
+
+        const std::string& get( string_view view ) {
+            std::lock_guard< std::mutex > lock( this->mutex );
+
+            const auto itr = this->index.find( view );
+            if( itr != this->index.end() ) return *itr->second;
+
+            this->strings.emplace_back( view.begin(), view.end() );
+            const auto& str = this->strings.back();
+            this->index.emplace( string_view{ str }, &str );
+            return str;
+        }
+
+        const std::string* empty;
+
+    private:
+        std::mutex mutex;
+        std::deque< std::string > strings;
+        std::unordered_map< string_view, const std::string*, view_hash > index;
+};
+
+/*
+ * Constructed on first use, so that static names can be interned safely, and
+ * never destroyed, so that interned names outlive other static objects.
+ */
+string_pool& pool() {
+    static string_pool* p = new string_pool();
+    return *p;
+}
+
+}
+
+InternedString::InternedString() :
+    str( pool().empty )
+{}
+
+InternedString::InternedString( const std::string& s ) :
+    str( &pool().get( string_view{ s } ) )
+{}
+
+InternedString::InternedString( const char* s ) :
+    str( &pool().get( string_view{ s } ) )
+{}
+
+InternedString::InternedString( string_view s ) :
+    str( &pool().get( s ) )
+{}
+
+std::ostream& operator<<( std::ostream& stream, const InternedString& s ) {
+    return stream << s.string();
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <opm/parser/eclipse/Utility/MappedFile.hpp>
+
+namespace Opm {
+
+#ifndef _WIN32
+
+MappedFile::MappedFile( const std::string& path ) {
+    const int fd = ::open( path.c_str(), O_RDONLY );
+    if( fd < 0 ) return;
+
+    struct stat st;
+    if( ::fstat( fd, &st ) != 0 || !S_ISREG( st.st_mode ) || st.st_size == 0 ) {
+        ::close( fd );
+        return;
+    }
+
+    void* addr = ::mmap( nullptr, st.st_size,
+                         PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                         fd, 0 );
+    ::close( fd );
+
+    if( addr == MAP_FAILED ) return;
+
+    ::madvise( addr, st.st_size, MADV_SEQUENTIAL );
+    this->ptr = static_cast< char* >( addr );
+    this->len = st.st_size;
+}
+
+MappedFile::~MappedFile() {
+    if( this->ptr ) ::munmap( this->ptr, this->len );
+}
+
+size_t MappedFile::discard( size_t first, size_t last ) {
+    static const size_t page = ::sysconf( _SC_PAGESIZE );
+    first = ( first + page - 1 ) / page * page;
+    last = last / page * page;
+
+    if( first >= last ) return first;
+
+    ::madvise( this->ptr + first, last - first, MADV_DONTNEED );
+    return last;
+}
+
+#else
+
+MappedFile::MappedFile( const std::string& ) {}
+MappedFile::~MappedFile() {}
+size_t MappedFile::discard( size_t first, size_t ) { return first; }
+
+#endif
+
+MappedFile::MappedFile( MappedFile&& other ) :
+    ptr( other.ptr ),
+    len( other.len )
+{
+    other.ptr = nullptr;
+    other.len = 0;
+}
+
+MappedFile& MappedFile::operator=( MappedFile&& other ) {
+    std::swap( this->ptr, other.ptr );
+    std::swap( this->len, other.len );
+    return *this;
+}
+
+}
@@ -0,0 +1,157 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <opm/parser/eclipse/Utility/ThreadPool.hpp>
+
+namespace Opm {
+
+namespace {
+
+/*
+ * The pool this thread is running a task for, if any, and the index of its
+ * queue. Threads that are not workers of the pool get an index past the end.
+ */
+thread_local ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+}
+
+ThreadPool::ThreadPool( size_t num_workers ) :
+    pending( 0 ),
+    next( 0 )
+{
+    /*
+     * a pool without workers is allowed, and will only run tasks through
+     * run_one(), but it still needs somewhere to put them
+     */
+    const auto num_queues = std::max( num_workers, size_t( 1 ) );
+    for( size_t i = 0; i < num_queues; ++i )
+        this->queues.emplace_back( new queue() );
+
+    for( size_t i = 0; i < num_workers; ++i )
+        this->workers.emplace_back( &ThreadPool::work, this, i );
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard< std::mutex > lock( this->sleep_mutex );
+        this->stop = true;
+    }
+
+    this->wakeup.notify_all();
+    for( auto& worker : this->workers ) worker.join();
+
+    /* run whatever is left if there were no workers */
+    while( this->run_one() ) {}
+}
+
+size_t ThreadPool::size() const {
+    return this->workers.size();
+}
+
+ThreadPool* ThreadPool::current() {
+    return current_pool;
+}
+
+bool ThreadPool::run_one() {
+    task t;
+    const auto self = current_pool == this ? current_worker : this->queues.size();
+    if( !this->pop( self, t ) ) return false;
+
+    auto* prev_pool = current_pool;
+    auto prev_worker = current_worker;
+    current_pool = this;
+    current_worker = self;
+
+    t();
+
+    current_pool = prev_pool;
+    current_worker = prev_worker;
+    return true;
+}
+
+void ThreadPool::push( task&& t ) {
+    const auto index = current_pool == this && current_worker < this->queues.size()
+                     ? current_worker
+                     : this->next++ % this->queues.size();
+
+    /*
+     * count the task before it's visible in the queue, so that pending never
+     * underflows when the task is taken right away
+     */
+    {
+        std::lock_guard< std::mutex > lock( this->sleep_mutex );
+        ++this->pending;
+    }
+
+    {
+        auto& q = *this->queues[ index ];
+        std::lock_guard< std::mutex > lock( q.mutex );
+        q.tasks.push_back( std::move( t ) );
+    }
+
+    this->wakeup.notify_one();
+}
+
+bool ThreadPool::pop( size_t self, task& t ) {
+    const auto n = this->queues.size();
+
+    /*
+     * Try the own queue first (if the caller is a worker), then steal from
+     * the others. An outside caller (self == n) visits all of them.
+     */
+    const auto first = self < n ? 0 : 1;
+    for( size_t i = first; i <= n; ++i ) {
+        auto& q = *this->queues[ ( self + i ) % n ];
+        std::lock_guard< std::mutex > lock( q.mutex );
+        if( q.tasks.empty() ) continue;
+
+        t = std::move( q.tasks.front() );
+        q.tasks.pop_front();
+        --this->pending;
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::work( size_t self ) {
+    current_pool = this;
+    current_worker = self;
+
+    task t;
+    while( true ) {
+        if( this->pop( self, t ) ) {
+            t();
+            t = nullptr;
+            continue;
+        }
+
+        std::unique_lock< std::mutex > lock( this->sleep_mutex );
+        this->wakeup.wait( lock, [this] {
+            return this->stop || this->pending > 0;
+        } );
+
+        if( this->stop && this->pending == 0 ) return;
+    }
+}
+
+}
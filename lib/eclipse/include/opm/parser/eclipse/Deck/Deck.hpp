@@ -22,6 +22,7 @@
 
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -93,19 +94,43 @@ namespace Opm {
 
         protected:
             void add( const DeckKeyword*, const_iterator, const_iterator );
-
-            const std::vector< size_t >& offsets( const std::string& ) const;
+            /* view these keywords, with an index of its own */
+            void reset( const_iterator, const_iterator );
 
             DeckView( const_iterator first, const_iterator last );
-            explicit DeckView( std::pair< const_iterator, const_iterator > );
+            /*
+             * The section of parent that starts with the section keyword,
+             * which shares the index of parent. The section is empty if
+             * parent does not have the keyword.
+             */
+            DeckView( const DeckView& parent, const std::string& section );
 
         private:
+            /*
+             * The positions of the keywords, by name, and of the section
+             * keywords, in the deck. The deck adds to it as keywords are
+             * added, and the views of the deck share it, so the positions
+             * are relative to the deck rather than the view.
+             */
+            struct keyword_index {
+                std::unordered_map< std::string, std::vector< size_t > > positions;
+                std::vector< size_t > sections;
+            };
+
+            using index_range = std::pair< const size_t*, const size_t* >;
+            /* the positions of the keyword in this view */
+            index_range offsets( const std::string& ) const;
+
             const_iterator first;
             const_iterator last;
-            std::map< std::string, std::vector< size_t > > keywordMap;
+            std::shared_ptr< keyword_index > keywords;
+            /* the position of the first keyword of the view in the deck */
+            size_t offset = 0;
 
     };
 
+    class ParseProfile;
+
     class Deck : private DeckView {
         public:
             using DeckView::const_iterator;
@@ -124,6 +149,11 @@ namespace Opm {
             Deck( std::initializer_list< DeckKeyword > );
             // cppcheck-suppress noExplicitConstructor
             Deck( std::initializer_list< std::string > );
+            Deck( const Deck& );
+            Deck( Deck&& ) = default;
+            Deck& operator=( const Deck& );
+            Deck& operator=( Deck&& ) = default;
+
             void addKeyword( DeckKeyword&& keyword );
             void addKeyword( const DeckKeyword& keyword );
 
@@ -138,11 +168,16 @@ namespace Opm {
             const std::string getDataFile() const;
             void setDataFile(const std::string& dataFile);
 
+            /* the profile of the parse, or nullptr if it was not profiled */
+            const ParseProfile* getParseProfile() const;
+            void setParseProfile( std::shared_ptr< const ParseProfile > );
+
             iterator begin();
             iterator end();
 
         private:
             Deck( std::vector< DeckKeyword >&& );
+            friend class Section;
 
             std::vector< DeckKeyword > keywordList;
             mutable MessageContainer m_messageContainer;
@@ -150,6 +185,7 @@ namespace Opm {
             UnitSystem activeUnits;
 
             std::string m_dataFile;
+            std::shared_ptr< const ParseProfile > profile;
     };
 }
 #endif  /* DECK_HPP */
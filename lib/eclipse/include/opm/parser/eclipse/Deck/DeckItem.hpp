@@ -20,23 +20,71 @@
 #ifndef DECKITEM_HPP
 #define DECKITEM_HPP
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
 
 #include <opm/parser/eclipse/Units/Dimension.hpp>
+#include <opm/parser/eclipse/Utility/InternedString.hpp>
+#include <opm/parser/eclipse/Utility/SmallVector.hpp>
 #include <opm/parser/eclipse/Utility/Typetools.hpp>
 
 namespace Opm {
 
+    /*
+     * The values of an item are stored run-length encoded. A run is either a
+     * sequence of literal values, or a single value repeated, as written
+     * N*value or N* in the deck. Repeated values stay compressed until the
+     * dense data is asked for with getData or getSIDoubleData; get, defaultApplied
+     * and getSIDouble look the value up in its run.
+     *
+     * The const methods are safe to call concurrently: the dense and SI
+     * values are computed only once, by whichever thread asks first.
+     *
+     * An item converted with convertToSI stores its doubles in SI instead,
+     * and it is the raw values that are computed when they are asked for.
+     *
+     * Most items hold a single value, so the runs, the values and the
+     * dimensions are kept in place in the item when there are few of them,
+     * and only the values of the item's type are stored. The dimensions are
+     * interned, and the name is an interned string, so neither is copied
+     * into every item.
+     */
     class DeckItem {
     public:
-        DeckItem() = default;
-        explicit DeckItem( const std::string& );
-
-        DeckItem( const std::string&, int, size_t size_hint = 8 );
-        DeckItem( const std::string&, double, size_t size_hint = 8 );
-        DeckItem( const std::string&, std::string, size_t size_hint = 8 );
+        /*
+         * The values [begin, end) of a run are stored from offset in
+         * getRunValues(), except that a repeated run stores its value only
+         * once. All the values of a run are either defaulted or not.
+         */
+        struct run {
+            size_t begin;
+            size_t end;
+            size_t offset;
+            bool repeated;
+            bool defaulted;
+        };
+
+        using run_list = small_vector< run, 1 >;
+        /* as many values as fit in 32 bytes, a little more than a std::vector */
+        template< typename T >
+        using value_list = small_vector< T, ( sizeof( T ) < 32 ? 32 / sizeof( T ) : 1 ) >;
+        using dimension_list = small_vector< const Dimension*, 3 >;
+
+        DeckItem();
+        explicit DeckItem( InternedString );
+
+        /* values beyond what fits in the item are reserved up front */
+        DeckItem( InternedString, int, size_t size_hint = 0 );
+        DeckItem( InternedString, double, size_t size_hint = 0 );
+        DeckItem( InternedString, std::string, size_t size_hint = 0 );
+
+        DeckItem( const DeckItem& );
+        DeckItem( DeckItem&& ) noexcept;
+        DeckItem& operator=( const DeckItem& );
+        DeckItem& operator=( DeckItem&& ) noexcept;
+        ~DeckItem();
 
         const std::string& name() const;
 
@@ -62,40 +110,120 @@ namespace Opm {
         template< typename T > const std::vector< T >& getData() const;
         const std::vector< double >& getSIDoubleData() const;
 
+        /*
+         * Write the values that were not defaulted to out[ i ], or to
+         * out[ index[ i ] ] if an index is given, with doubles converted to
+         * SI. This is the bulk path for grid data: a run is converted as a
+         * whole, and nothing is cached in the item.
+         */
+        void writeData( int* out, const size_t* index = nullptr ) const;
+        void writeSIData( double* out, const size_t* index = nullptr ) const;
+        void writeSIData( float* out, const size_t* index = nullptr ) const;
+
+        const run_list& getRuns() const;
+        template< typename T > const value_list< T >& getRunValues() const;
+        // the value of the run at the given index in the run
+        template< typename T > const T& getRunValue( const run&, size_t ) const;
+
         void push_back( int );
         void push_back( double );
         void push_back( std::string );
         void push_back( int, size_t );
         void push_back( double, size_t );
         void push_back( std::string, size_t );
+        // append all the values, none of which are defaulted
+        void push_back( std::vector< int >&& );
+        void push_back( std::vector< double >&& );
+        // append all the values, with a defaulted flag for every value
+        void push_back( std::vector< int >&&, std::vector< bool >&& );
+        void push_back( std::vector< double >&&, std::vector< bool >&& );
+        void push_back( std::vector< std::string >&&, std::vector< bool >&& );
+        // append the values, made up of the runs, whose offsets are into values
+        void push_back( std::vector< int >&&, std::vector< run >&& );
+        void push_back( std::vector< double >&&, std::vector< run >&& );
+        void push_back( std::vector< std::string >&&, std::vector< run >&& );
         void push_backDefault( int );
         void push_backDefault( double );
         void push_backDefault( std::string );
+        void push_backDefault( int, size_t );
+        void push_backDefault( double, size_t );
+        void push_backDefault( std::string, size_t );
         // trying to access the data of a "dummy default item" will raise an exception
         void push_backDummyDefault();
 
         void push_backDimension( const Dimension& /* activeDimension */,
                                  const Dimension& /* defaultDimension */);
+        const dimension_list& getDimensions() const;
+
+        /*
+         * Convert the values to SI in place, with the dimensions that are
+         * set, so that getSIDoubleData returns the stored values rather than
+         * a converted copy. get, getData and getRunValues still return the
+         * raw values, which are converted back from SI, and may differ from
+         * the input in the last bits. Items with a context dependent
+         * dimension are left as they are. No values can be added to an item
+         * once it is converted.
+         */
+        void convertToSI();
+        bool storesSI() const;
+        // the item is a pseudo default, with no values
+        bool isDummyDefault() const;
 
         type_tag getType() const;
 
     private:
-        std::vector< double > dval;
-        std::vector< int > ival;
-        std::vector< std::string > sval;
+        /* only the values of the item's type, or ival if it has none, are alive */
+        union {
+            value_list< int > ival;
+            value_list< double > dval;
+            value_list< std::string > sval;
+        };
 
         type_tag type = type_tag::unknown;
-
-        std::string item_name;
-        std::vector< bool > defaulted;
-        std::vector< Dimension > dimensions;
-        mutable std::vector< double > SIdata;
-
-        template< typename T > std::vector< T >& value_ref();
-        template< typename T > const std::vector< T >& value_ref() const;
+        // a pseudo default, an item that is defaulted but has no value
+        bool dummy_default = false;
+        // the double values are stored in SI
+        bool si_stored = false;
+
+        InternedString item_name;
+        run_list runs;
+        dimension_list dimensions;
+
+        /*
+         * The SI values, and the dense values when they are not already
+         * stored as a std::vector, or the raw run values if the item stores
+         * SI. They are computed under a lock and published by setting the
+         * flag, after which they never change. Few items ever need them, so
+         * they are allocated on demand, and a copy computes them again.
+         */
+        struct lazy_values {
+            std::atomic< bool > si_done{ false };
+            std::atomic< bool > dense_done{ false };
+            std::atomic< bool > raw_done{ false };
+            std::vector< double > si;
+            value_list< double > raw;
+            std::shared_ptr< void > dense;
+        };
+
+        mutable std::atomic< lazy_values* > lazy{ nullptr };
+        lazy_values& lazy_block() const;
+        void reset_lazy();
+
+        void construct_values( type_tag );
+        void destroy_values();
+        template< typename T > value_list< T >& value_ref();
+        template< typename T > const value_list< T >& value_ref() const;
+        /* the stored values, except that doubles stored in SI are raw */
+        template< typename T > const value_list< T >& raw_ref() const;
+        const run& find_run( size_t ) const;
+        template< typename T > void write_si( T*, const size_t*, bool ) const;
         template< typename T > void push( T );
         template< typename T > void push( T, size_t );
-        template< typename T > void push_default( T );
+        template< typename T > void push( std::vector< T >&& );
+        template< typename T > void push( std::vector< T >&&, std::vector< bool >&& );
+        template< typename T > void push( std::vector< T >&&, std::vector< run >&& );
+        template< typename T > void push_default( T, size_t );
+        void push_run( size_t count, size_t offset, bool repeated, bool defaulted );
     };
 }
 #endif  /* DECKITEM_HPP */
@@ -20,11 +20,14 @@
 #ifndef DECKKEYWORD_HPP
 #define DECKKEYWORD_HPP
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Utility/InternedString.hpp>
 
 namespace Opm {
     class ParserKeyword;
@@ -33,11 +36,25 @@ namespace Opm {
     public:
         typedef std::vector< DeckRecord >::const_iterator const_iterator;
 
-        explicit DeckKeyword(const std::string& keywordName);
-        DeckKeyword(const std::string& keywordName, bool knownKeyword);
+        /*
+         * The records of a lazy keyword are parsed from its source when they
+         * are first accessed. This happens only once, and is thread safe.
+         * Copies of a lazy keyword that has not been parsed yet share the
+         * source, but are parsed separately.
+         */
+        class Source {
+            public:
+                virtual ~Source() = default;
+                virtual size_t size() const = 0;
+                virtual DeckKeyword parse() const = 0;
+        };
+
+        explicit DeckKeyword(InternedString keywordName);
+        DeckKeyword(InternedString keywordName, bool knownKeyword);
+        DeckKeyword(InternedString keywordName, std::shared_ptr< const Source > source);
 
         const std::string& name() const;
-        void setLocation(const std::string& fileName, int lineNumber);
+        void setLocation(InternedString fileName, int lineNumber);
         const std::string& getFileName() const;
         int getLineNumber() const;
 
@@ -49,6 +66,8 @@ namespace Opm {
         void setDataKeyword(bool isDataKeyword = true);
         bool isKnown() const;
         bool isDataKeyword() const;
+        /// The records have not been parsed yet.
+        bool isLazy() const;
 
         const std::vector<int>& getIntData() const;
         const std::vector<double>& getRawDoubleData() const;
@@ -58,23 +77,37 @@ namespace Opm {
 
         template <class Keyword>
         bool isKeyword() const {
-            if (Keyword::keywordName == m_keywordName)
-                return true;
-            else
-                return false;
+            static const InternedString name( Keyword::keywordName );
+            return name == m_keywordName;
         }
 
         const_iterator begin() const;
         const_iterator end() const;
 
     private:
-        std::string m_keywordName;
-        std::string m_fileName;
+        InternedString m_keywordName;
+        InternedString m_fileName;
         int m_lineNumber;
 
-        std::vector< DeckRecord > m_recordList;
+        mutable std::vector< DeckRecord > m_recordList;
         bool m_knownKeyword;
         bool m_isDataKeyword;
+
+        struct lazy_state {
+            lazy_state() = default;
+            lazy_state( const lazy_state& );
+            lazy_state( lazy_state&& ) noexcept;
+            lazy_state& operator=( const lazy_state& );
+            lazy_state& operator=( lazy_state&& ) noexcept;
+
+            std::unique_ptr< std::once_flag > once;
+            std::atomic< bool > done{ true };
+        };
+
+        std::shared_ptr< const Source > m_source;
+        mutable lazy_state m_lazy;
+
+        void materialize() const;
     };
 }
 
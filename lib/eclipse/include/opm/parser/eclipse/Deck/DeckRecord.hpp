@@ -25,6 +25,7 @@
 #include <memory>
 
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Utility/InternedString.hpp>
 
 namespace Opm {
 
@@ -48,14 +49,23 @@ namespace Opm {
 
         bool hasItem(const std::string& name) const;
 
+        /*
+         * The item names are interned, so the typed lookups intern the name
+         * they look for once, and compare names by identity. The item is
+         * first looked for at its index in the keyword definition, which is
+         * where it is unless the record was built some other way, so the
+         * lookup is usually a single comparison.
+         */
         template <class Item>
         DeckItem& getItem() {
-            return getItem( Item::itemName );
+            static const InternedString name( Item::itemName );
+            return getInternedItem( name, Item::itemIndex );
         }
 
         template <class Item>
         const DeckItem& getItem() const {
-            return getItem( Item::itemName );
+            static const InternedString name( Item::itemName );
+            return getInternedItem( name, Item::itemIndex );
         }
 
         const_iterator begin() const;
@@ -64,8 +74,20 @@ namespace Opm {
     private:
         std::vector< DeckItem > m_items;
 
+        DeckItem& getInternedItem( const InternedString& name, size_t index );
+        inline const DeckItem& getInternedItem( const InternedString& name, size_t index ) const;
+        const DeckItem& findInternedItem( const InternedString& name ) const;
+
     };
 
+    const DeckItem& DeckRecord::getInternedItem( const InternedString& name, size_t index ) const {
+        if( index < this->m_items.size()
+            && &this->m_items[ index ].name() == &name.string() )
+            return this->m_items[ index ];
+
+        return this->findInternedItem( name );
+    }
+
 }
 #endif  /* DECKRECORD_HPP */
 
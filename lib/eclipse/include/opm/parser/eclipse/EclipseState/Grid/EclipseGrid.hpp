@@ -210,6 +210,11 @@ namespace Opm {
                                  const std::vector<double>& zcorn ,
                                  const int * actnum,
                                  const double * mapaxes);
+        void initCornerPointGrid(const std::array<int,3>& dims ,
+                                 const std::vector<float>& coord ,
+                                 const std::vector<float>& zcorn ,
+                                 const int * actnum,
+                                 const double * mapaxes);
 
         void initCylindricalGrid(       const std::array<int, 3>&, const Deck&);
         void initCartesianGrid(         const std::array<int, 3>&, const Deck&);
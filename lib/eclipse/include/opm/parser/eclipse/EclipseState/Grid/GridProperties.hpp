@@ -19,6 +19,8 @@
 #ifndef ECLIPSE_GRIDPROPERTIES_HPP_
 #define ECLIPSE_GRIDPROPERTIES_HPP_
 
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -50,6 +52,11 @@
        getKeyword() method it will automatically create a new
        GridProperty object if the container does not have this
        property.
+
+  The const methods are safe to call concurrently; the auto creation
+  and post processing of properties are serialized. Iterating over
+  the properties is not safe while another thread may auto create
+  one.
 */
 
 
@@ -199,6 +206,13 @@ namespace Opm {
         mutable std::unordered_map<std::string, SupportedKeywordInfo> m_supportedKeywords;
         mutable storage m_properties;
         mutable std::set<std::string> m_autoGeneratedProperties;
+
+        /*
+          Guards the mutable members. Eclipse3DProperties makes its int and
+          double properties share the lock, as their post processors look
+          up properties in each other.
+        */
+        std::shared_ptr< std::recursive_mutex > m_mutex = std::make_shared< std::recursive_mutex >();
     };
 
 }
@@ -178,7 +178,7 @@ public:
 
 private:
     const DeckItem& getDeckItem( const DeckKeyword& );
-    void setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem);
+    void loadFromDeckItem(const DeckItem& deckItem, const size_t* indexList);
 
     size_t m_nx, m_ny, m_nz;
     SupportedKeywordInfo m_kwInfo;
@@ -37,6 +37,8 @@ namespace Opm {
         static std::string startTest(const std::string& test_name);
         static std::string headerHeader( const std::string& );
         static bool updateFile(const std::stringstream& newContent, const std::string& filename);
+        static std::string createKeywordHash(const KeywordLoader& loader);
+        static std::string createKeywordRegistry(const KeywordLoader& loader);
 
         bool updateSource(const KeywordLoader& loader, const std::string& sourceFile ) const;
         bool updateHeader(const KeywordLoader& loader, const std::string& headerBuildPath, const std::string& headerFile) const;
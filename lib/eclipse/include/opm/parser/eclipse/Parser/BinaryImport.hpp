@@ -0,0 +1,100 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_BINARYIMPORT_HPP
+#define OPM_BINARYIMPORT_HPP
+
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+#include <opm/parser/eclipse/Utility/MappedFile.hpp>
+#include <opm/parser/eclipse/Utility/Typetools.hpp>
+
+namespace Opm {
+
+    /*
+     * The arrays of a binary file named by the IMPORT keyword. The file is
+     * mapped, and the values are converted from the mapping when asked for,
+     * one array at a time. Two formats are supported:
+     *
+     * UNFORMATTED: the Eclipse binary format, big endian Fortran records
+     * with a 16 byte header record (name, count and type) for every array,
+     * as written by geomodelling tools and by Eclipse itself.
+     *
+     * RAW: a sequence of arrays in native little endian, each a 32 byte
+     * header followed by the values, padded with zeros to a multiple of 8
+     * bytes:
+     *
+     *     char     magic[ 8 ]  "OPMARRAY"
+     *     char     name[ 8 ]   the keyword, padded with spaces
+     *     char     type[ 4 ]   INTE, REAL or DOUB
+     *     uint32   reserved    0
+     *     uint64   count       the number of values
+     *
+     * Malformed files throw std::invalid_argument.
+     */
+    class BinaryImport {
+    public:
+        enum class Format { UNFORMATTED, RAW };
+        static Format formatFromString( const std::string& );
+
+        BinaryImport( const boost::filesystem::path&, Format );
+
+        /* move to the next array, false at the end of the file */
+        bool next();
+
+        const std::string& name() const;
+        size_t size() const;
+        /* integer for INTE and LOGI arrays, fdouble for REAL and DOUB */
+        type_tag type() const;
+
+        /* INTE arrays, and LOGI arrays as 0 and 1 */
+        std::vector< int > getIntData() const;
+        /* REAL, DOUB and INTE arrays */
+        std::vector< double > getDoubleData() const;
+
+    private:
+        struct block {
+            const char* data;
+            size_t count;
+        };
+
+        boost::filesystem::path path;
+        Format format;
+        MappedFile mapping;
+        std::string buffer;
+        const char* pos = nullptr;
+        const char* end = nullptr;
+
+        std::string array_name;
+        std::string array_type;
+        size_t array_size = 0;
+        std::vector< block > blocks;
+
+        bool next_unformatted();
+        bool next_raw();
+        template< typename T > std::vector< T > convert() const;
+        [[noreturn]] void malformed( const std::string& ) const;
+    };
+
+}
+
+#endif
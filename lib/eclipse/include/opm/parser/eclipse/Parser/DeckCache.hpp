@@ -0,0 +1,80 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_DECKCACHE_HPP
+#define OPM_DECKCACHE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+namespace Opm {
+
+    class Deck;
+    class ParseContext;
+    class Parser;
+
+    /*
+     * A directory of parsed decks in a compact binary form. There is one
+     * entry per data file and configuration, where the configuration is the
+     * deck names the parser knows, the definitions of its keywords, and the
+     * actions of the parse context. An entry records the size and content
+     * hash of every file that went into the deck, the data file and its
+     * includes, and is only loaded if all of them are unchanged. Otherwise
+     * the deck is parsed again, and the entry replaced.
+     *
+     * The entries are written to a temporary file that is then renamed, so
+     * concurrent parses of the same deck are safe. Entries that can't be read
+     * are ignored, and failing to write one is not an error.
+     */
+    class DeckCache {
+    public:
+        DeckCache( boost::filesystem::path directory,
+                   const Parser&,
+                   const ParseContext& );
+
+        /*
+         * Load the cached deck of the data file into deck, which must be
+         * empty. Returns false, and leaves the deck empty, if there is no
+         * up to date entry.
+         */
+        bool load( const boost::filesystem::path& dataFile, Deck& deck ) const;
+
+        /*
+         * Store the deck parsed from the data file. The inputs are all the
+         * files the parser tried to open, including the data file itself and
+         * the include files that were missing.
+         */
+        void store( const boost::filesystem::path& dataFile,
+                    const std::vector< boost::filesystem::path >& inputs,
+                    const Deck& deck ) const;
+
+        /* the entry of the data file */
+        boost::filesystem::path entry( const boost::filesystem::path& dataFile ) const;
+
+    private:
+        boost::filesystem::path directory;
+        uint64_t configuration;
+    };
+
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_KEYWORDHASH_HPP
+#define OPM_KEYWORDHASH_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/Utility/Stringview.hpp>
+
+namespace Opm {
+
+    /*
+     * A minimal perfect hash over a fixed set of keyword names: every name
+     * has its own slot in [0, size()), and a lookup is two hashes of the name
+     * and one comparison, without allocating.
+     *
+     * The names are hashed to buckets, and every bucket has a seed that
+     * places all of its names in distinct slots. genkw builds the hash of the
+     * default keywords' deck names, and emits the seeds and the names in slot
+     * order so that the hash is not built at run time.
+     *
+     * The hash only refers to the names, which must outlive it.
+     */
+    class KeywordHash {
+    public:
+        static const size_t npos = size_t( -1 );
+
+        KeywordHash() = default;
+        KeywordHash( std::vector< uint32_t > seeds, std::vector< string_view > names );
+
+        /* build the hash of the names, which must be distinct */
+        static KeywordHash build( const std::vector< std::string >& names );
+        /* the hash would refer to names that are about to be destroyed */
+        static KeywordHash build( std::vector< std::string >&& ) = delete;
+
+        /* the slot of name, or npos if it is not in the hash */
+        size_t find( const string_view& name ) const;
+        size_t size() const;
+
+        const std::vector< uint32_t >& seeds() const;
+        /* the names, in slot order */
+        const std::vector< string_view >& names() const;
+
+    private:
+        std::vector< uint32_t > m_seeds;
+        std::vector< string_view > m_names;
+    };
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_KEYWORDREGISTRY_HPP
+#define OPM_KEYWORDREGISTRY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Opm {
+
+    class KeywordHash;
+    class ParserKeyword;
+
+    /*
+     * The default keywords, from the constant tables genkw emits: a
+     * descriptor for every keyword, and for every slot of the hash of the
+     * deck names the keyword with that deck name.
+     *
+     * A ParserKeyword is only built when it is first looked up, and is then
+     * shared by all the parsers in the process. The keywords that match their
+     * deck names with a regular expression can't be looked up by name, and
+     * are built with the registry. Lookups are thread safe.
+     */
+    class KeywordRegistry {
+    public:
+        struct Descriptor {
+            const char* name;
+            /* the keyword that gives the size of this one, or nullptr */
+            const char* sizeKeyword;
+            /* the deck names are matched with a regular expression */
+            bool matchRegex;
+            ParserKeyword* (*make)();
+        };
+
+        KeywordRegistry( const KeywordHash& hash,
+                         const Descriptor* descriptors,
+                         size_t count,
+                         const uint32_t* slotKeywords,
+                         uint64_t definitions );
+        ~KeywordRegistry();
+
+        KeywordRegistry( const KeywordRegistry& ) = delete;
+        KeywordRegistry& operator=( const KeywordRegistry& ) = delete;
+
+        const KeywordHash& hash() const;
+
+        /* the number of keywords */
+        size_t size() const;
+        const Descriptor& descriptor( size_t index ) const;
+        /* a hash of the definitions of the keywords, computed by genkw */
+        uint64_t definitions() const;
+
+        /* the keyword, which is built on the first lookup */
+        const ParserKeyword& get( size_t index ) const;
+        /* the keyword with the deck name in the slot of the hash */
+        const ParserKeyword& getSlot( size_t slot ) const;
+
+        /* the keywords with a regular expression, in name order */
+        const std::vector< const ParserKeyword* >& wildcards() const;
+
+        /* the number of keywords that have been built */
+        size_t built() const;
+
+    private:
+        const KeywordHash& m_hash;
+        const Descriptor* m_descriptors;
+        size_t m_size;
+        const uint32_t* m_slotKeywords;
+        uint64_t m_definitions;
+
+        std::unique_ptr< std::atomic< const ParserKeyword* >[] > m_keywords;
+        std::vector< const ParserKeyword* > m_wildcards;
+        mutable std::atomic< size_t > m_built;
+        mutable std::mutex m_mutex;
+    };
+
+}
+
+#endif
@@ -24,13 +24,15 @@
 #include <vector>
 #include <memory>
 
+#include <opm/parser/eclipse/Utility/InternedString.hpp>
+
 namespace Opm {
 
     struct Location {
         Location() = default;
-        Location( const std::string&, size_t );
+        Location( InternedString, size_t );
 
-        std::string filename;
+        InternedString filename;
         size_t lineno = 0;
 
         explicit operator bool() const {
@@ -167,6 +167,13 @@ namespace Opm {
         */
         const static std::string PARSE_MISSING_INCLUDE;
 
+        /*
+          A binary file read with IMPORT can hold arrays of keywords
+          that are not data keywords, like MAPUNITS or GRIDUNIT. They
+          are skipped, and by default with a warning.
+        */
+        const static std::string PARSE_IMPORT_NON_DATA;
+
 
         /*
           Some property modfiers can be modified in the Schedule
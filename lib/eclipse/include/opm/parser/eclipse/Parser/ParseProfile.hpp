@@ -0,0 +1,123 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_PARSE_PROFILE_HPP
+#define OPM_PARSE_PROFILE_HPP
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    /*
+     * Where the time of a parse went, per keyword name and per input file.
+     * Filled in by the parser when profiling is enabled with
+     * Parser::setProfiling, and returned with the deck.
+     *
+     * The time of a keyword is the wall time spent parsing it in whichever
+     * thread parsed it, so with several threads the keyword times add up to
+     * more than the total. Lazy keywords are parsed after the parse, and only
+     * count their bytes.
+     *
+     * Allocations are only counted if the program counts them, by calling
+     * countAllocation from its replacement of the global operator new, as
+     * opmi does.
+     */
+    class ParseProfile {
+        public:
+            struct Entry {
+                std::string name;
+                size_t keywords = 0;
+                /* of cleaned input */
+                size_t bytes = 0;
+                size_t records = 0;
+                size_t items = 0;
+                size_t allocations = 0;
+                /* parsing the keywords, of which parsing their records */
+                double seconds = 0;
+                double recordSeconds = 0;
+                /* converting the keywords to SI */
+                double unitSeconds = 0;
+                /* reading and cleaning the input, for files only */
+                double readSeconds = 0;
+
+                double totalSeconds() const;
+                void add( const Entry& );
+            };
+
+            using clock = std::chrono::steady_clock;
+
+            const std::map< std::string, Entry >& getKeywords() const;
+            const std::map< std::string, Entry >& getFiles() const;
+
+            /* the n keywords or files with the most total time, most first */
+            std::vector< Entry > topKeywords( size_t n ) const;
+            std::vector< Entry > topFiles( size_t n ) const;
+
+            /* wall time of the whole parse, and of its stages */
+            double getTotalSeconds() const;
+            double getReadSeconds() const;
+            double getUnitSeconds() const;
+
+            /* the parser records the parse with these */
+            void addKeyword( const std::string& file, const Entry& sample );
+            void addRead( const std::string& file, double seconds );
+            void addUnits( const std::string& keyword, const std::string& file, double seconds );
+            void setTotalSeconds( double );
+
+            static double since( clock::time_point );
+
+            /*
+             * Measure the keyword parsed in this thread. The wall time and
+             * allocations from construction to destruction are added to the
+             * sample, which is current() in between.
+             */
+            class Scope {
+                public:
+                    explicit Scope( Entry& );
+                    ~Scope();
+
+                private:
+                    Entry& sample;
+                    Entry* previous;
+                    size_t allocations;
+                    clock::time_point start;
+            };
+
+            /* the sample of the keyword parsed in this thread, if profiled */
+            static Entry* current();
+
+            /* count an allocation in this thread */
+            static void countAllocation();
+
+        private:
+            mutable std::mutex mutex;
+            std::map< std::string, Entry > keywords;
+            std::map< std::string, Entry > files;
+            double totalSeconds = 0;
+            double readSeconds = 0;
+            double unitSeconds = 0;
+    };
+
+}
+
+#endif
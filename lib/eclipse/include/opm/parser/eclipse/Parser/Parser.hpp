@@ -20,15 +20,18 @@
 #ifndef OPM_PARSER_HPP
 #define OPM_PARSER_HPP
 
+#include <functional>
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include <boost/filesystem.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+#include <opm/parser/eclipse/Parser/WildcardTrie.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
 namespace Json {
@@ -38,12 +41,24 @@ namespace Json {
 namespace Opm {
 
     class Deck;
+    class DeckKeyword;
+    class KeywordHash;
+    class KeywordRegistry;
+    class MessageContainer;
     class ParseContext;
+    class ParseProfile;
     class RawKeyword;
 
     /// The hub of the parsing process.
     /// An input file in the eclipse data format is specified, several steps of parsing is performed
     /// and the semantically parsed result is returned.
+    ///
+    /// The const methods, and in particular the parse methods, are safe to
+    /// call concurrently from many threads on one Parser, so an expensive
+    /// Parser with all the default keywords can be built once and shared.
+    /// A parse only reads the Parser; everything it writes is owned by the
+    /// parse or the deck it returns. The Parser must not be modified, with
+    /// addParserKeyword or the setters, while it is parsing.
 
     class Parser {
     public:
@@ -54,10 +69,75 @@ namespace Opm {
         /// The starting point of the parsing process. The supplied file is parsed, and the resulting Deck is returned.
         Deck parseFile(const std::string &dataFile,
                        const ParseContext& = ParseContext()) const;
+        /// Parse the file without building a Deck: every keyword is handed
+        /// to the visitor, in input order, as soon as it is parsed, and then
+        /// discarded. Only the keywords needed to parse the rest of the input
+        /// (keywords that give the size of other keywords, and the unit system
+        /// keywords) are kept, and the input is read and released
+        /// incrementally, so memory use does not grow with the size of the
+        /// deck. Units are applied from the unit system selected so far before
+        /// a keyword is visited. Returns the messages from the parse.
+        MessageContainer parseFile(const std::string &dataFile,
+                                   const ParseContext&,
+                                   std::function< void( const DeckKeyword& ) > visitor) const;
         Deck parseString(const std::string &data,
                          const ParseContext& = ParseContext()) const;
+        /// Parse a deck from an in-memory buffer. The buffer is only read,
+        /// and must stay alive until the function returns.
+        Deck parseBuffer(string_view data,
+                         const ParseContext& = ParseContext()) const;
         Deck parseStream(std::unique_ptr<std::istream>&& inputStream , const ParseContext& parseContext) const;
 
+        /// Parse the keywords on this many threads. The input is still read
+        /// and split into keywords in the calling thread, and the keywords are
+        /// added to the deck in input order, so the resulting deck is the same
+        /// regardless of the thread count. With more than one thread, included
+        /// files are also read and cleaned ahead of time. The default is 1,
+        /// which parses everything in the calling thread.
+        void setThreadCount( size_t threads );
+        size_t getThreadCount() const;
+
+        /// In lazy mode, keywords are split from the input but not parsed;
+        /// their records are parsed when they are first accessed. The deck
+        /// keeps the input alive for as long as it has keywords that are not
+        /// parsed. Messages from parsing lazy keywords are dropped, and
+        /// errors are handled when the keyword is accessed, so depending on
+        /// the ParseContext accessing a keyword may throw. The default is to
+        /// parse all keywords up front. The lazy keywords share the keywords
+        /// added to the parser, so the deck may outlive the parser.
+        void setLazy( bool lazy );
+        bool isLazy() const;
+
+        /// Cache the decks parsed with parseFile in this directory, which is
+        /// created if needed. A deck is loaded from the cache instead of
+        /// parsed when the data file and all the files it includes are
+        /// unchanged, and the parser has the same keywords and the same
+        /// ParseContext as when it was stored. A lazy parse uses the cache,
+        /// but does not store to it. The default, an empty directory, is no
+        /// caching.
+        void setCacheDirectory( const std::string& directory );
+        const std::string& getCacheDirectory() const;
+
+        /// Profile the parse: the time, bytes, records, items and
+        /// allocations of every keyword name and input file, and the time
+        /// of reading the input and applying units, are recorded and
+        /// returned with the deck by Deck::getParseProfile. Decks loaded from
+        /// the cache are not profiled. The default is no profiling, which
+        /// costs nothing.
+        void setProfiling( bool profiling );
+        bool isProfiling() const;
+
+        /// Store the values of the deck in SI. Every keyword is converted
+        /// when it is parsed, with the unit system selected by the unit
+        /// keywords before it, instead of in a pass over the deck afterwards,
+        /// and the doubles are not held both in raw and SI form. Raw values
+        /// are converted back from SI when they are asked for. The units are
+        /// the same as in the default mode, unless there are keywords with
+        /// units before the unit keyword. The default is to store the values
+        /// as they are written in the input.
+        void setSIStorage( bool si );
+        bool isSIStorage() const;
+
         /// Method to add ParserKeyword instances, these holding type and size information about the keywords and their data.
         void addParserKeyword(const Json::JsonObject& jsonKeyword);
         void addParserKeyword(std::unique_ptr< const ParserKeyword >&& parserKeyword);
@@ -113,16 +193,40 @@ namespace Opm {
                 const ParseContext& context = ParseContext());
 
     private:
-        // associative map of the parser internal name and the corresponding ParserKeyword object
-        std::vector< std::unique_ptr< const ParserKeyword > > keyword_storage;
+        // the cache fingerprints the keyword definitions
+        friend class DeckCache;
+
+        // the added keywords, shared with the lazy keywords that parse with them
+        std::vector< std::shared_ptr< const ParserKeyword > > keyword_storage;
         // associative map of deck names and the corresponding ParserKeyword object
         std::map< string_view, const ParserKeyword* > m_deckParserKeywords;
         // associative map of the parser internal names and the corresponding
         // ParserKeyword object for keywords which match a regular expression
         std::map< string_view, const ParserKeyword* > m_wildCardKeywords;
+        // the default keywords, which are shared by all parsers and only
+        // built when they are first looked up, and the perfect hash of their
+        // deck names
+        const KeywordRegistry* m_defaults = nullptr;
+        const KeywordHash* m_keywordHash = nullptr;
+        // the added keywords with a deck name in the hash, by slot, which
+        // replace the default keyword. Deck names that are not in the hash
+        // are only found in m_deckParserKeywords.
+        std::vector< const ParserKeyword* > m_hashedKeywords;
+        size_t m_unhashedNames = 0;
+        WildcardTrie m_wildCardTrie;
+
+        size_t m_threads = 1;
+        bool m_lazy = false;
+        bool m_profiling = false;
+        bool m_siStorage = false;
+        std::string m_cacheDirectory;
 
         bool hasWildCardKeyword(const std::string& keyword) const;
         const ParserKeyword* matchingKeyword(const string_view& keyword) const;
+        const ParserKeyword* findDeckName(const string_view& deckKeywordName) const;
+        void setDefaultKeywords(const KeywordRegistry& registry);
+        void applyUnitsToDeck(Deck& deck, ParseProfile* profile) const;
+        std::set< std::string > getSizeKeywords() const;
 
         void addDefaultKeywords();
     };
@@ -57,6 +57,7 @@ namespace Opm {
         size_t numDimensions() const;
         const std::string& name() const;
         item_size sizeType() const;
+        type_tag getType() const;
         std::string getDescription() const;
         bool scalar() const;
         void setDescription(std::string helpText);
@@ -71,9 +72,23 @@ namespace Opm {
         bool operator!=( const ParserItem& ) const;
 
         DeckItem scan( RawRecord& rawRecord ) const;
+
+        /*
+         * Scan an item of size SINGLE and type T, without going through the
+         * item definition. These are called by the record parsers genkw
+         * emits for the default keywords, with the names and defaults
+         * compiled in; scan() ends up here for the same items.
+         */
+        template< typename T >
+        static DeckItem scanSingle( InternedString name, RawRecord& rawRecord );
+        template< typename T >
+        static DeckItem scanSingle( InternedString name, RawRecord& rawRecord, const T& defaultValue );
+
         const std::string className() const;
         std::string createCode() const;
-        std::ostream& inlineClass(std::ostream&, const std::string& indent) const;
+        /* the code that scans this item, named name, from record */
+        std::string createScanCode( const std::string& name, const std::string& record ) const;
+        std::ostream& inlineClass(std::ostream&, const std::string& indent, size_t index) const;
         std::string inlineClassInit(const std::string& parentClass,
                                     const std::string* defaultValue = nullptr ) const;
 
@@ -83,13 +98,17 @@ namespace Opm {
         std::string sval;
         std::vector< std::string > dimensions;
 
-        std::string m_name;
+        InternedString m_name;
         item_size m_sizeType;
         std::string m_description;
 
         type_tag type = type_tag::unknown;
         bool m_defaultSet;
 
+        template< typename T >
+        static DeckItem scanSingle( InternedString, RawRecord&, const T* defaultValue );
+        std::string defaultCode() const;
+
         template< typename T > T& value_ref();
         template< typename T > const T& value_ref() const;
         friend std::ostream& operator<<( std::ostream&, const ParserItem& );
@@ -41,6 +41,7 @@ namespace Opm {
     class RawKeyword;
     class string_view;
     class MessageContainer;
+    class UnitSystem;
 
     class ParserKeyword {
     public:
@@ -65,6 +66,7 @@ namespace Opm {
         static bool validInternalName(const std::string& name);
         static bool validDeckName(const string_view& name);
         bool hasMatchRegex() const;
+        const std::string& getMatchRegex() const;
         void setMatchRegex(const std::string& deckNameRegexp);
         bool matches(const string_view& ) const;
         bool hasDimension() const;
@@ -103,6 +105,7 @@ namespace Opm {
         std::string createDecl() const;
         std::string createCode() const;
         void applyUnitsToDeck( Deck& deck, DeckKeyword& deckKeyword) const;
+        void applyUnitsToDeck( UnitSystem& active, UnitSystem& defaults, DeckKeyword& deckKeyword) const;
 
         bool operator==( const ParserKeyword& ) const;
         bool operator!=( const ParserKeyword& ) const;
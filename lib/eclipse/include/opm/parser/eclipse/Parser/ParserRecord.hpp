@@ -34,9 +34,17 @@ namespace Opm {
     class ParserItem;
     class RawRecord;
     class MessageContainer;
+    class UnitSystem;
 
     class ParserRecord {
     public:
+        /*
+         * A parser specialised for the items of one record, which scans the
+         * items in order and returns them. genkw emits these for the records
+         * of the default keywords.
+         */
+        typedef std::vector< DeckItem > (*item_scanner)( RawRecord& );
+
         ParserRecord();
         size_t size() const;
         void addItem( ParserItem );
@@ -44,11 +52,15 @@ namespace Opm {
         const ParserItem& get(size_t index) const;
         const ParserItem& get(const std::string& itemName) const;
         DeckRecord parse( const ParseContext&, MessageContainer&, RawRecord& ) const;
+        /* use the scanner to parse the items; it is dropped when items are added */
+        void setScanner( item_scanner );
+        bool hasScanner() const;
         bool isDataRecord() const;
         bool equal(const ParserRecord& other) const;
         bool hasDimension() const;
         bool hasItem(const std::string& itemName) const;
         void applyUnitsToDeck( Deck& deck, DeckRecord& deckRecord) const;
+        void applyUnitsToDeck( UnitSystem& active, UnitSystem& defaults, DeckRecord& deckRecord) const;
         std::vector< ParserItem >::const_iterator begin() const;
         std::vector< ParserItem >::const_iterator end() const;
 
@@ -58,6 +70,7 @@ namespace Opm {
     private:
         bool m_dataRecord;
         std::vector< ParserItem > m_items;
+        item_scanner m_scanner = nullptr;
     };
 
 std::ostream& operator<<( std::ostream&, const ParserRecord& );
@@ -0,0 +1,66 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_WILDCARDTRIE_HPP
+#define OPM_WILDCARDTRIE_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <opm/parser/eclipse/Utility/Stringview.hpp>
+
+namespace Opm {
+
+    class ParserKeyword;
+
+    /*
+     * The keywords that match their deck names with a regular expression,
+     * like the summary keyword families FU.+ and WU.+, in a trie of the
+     * literal prefixes of their expressions. A name is only matched against
+     * the expressions of the keywords whose prefixes it starts with, so most
+     * names are rejected by walking a few nodes of the trie.
+     */
+    class WildcardTrie {
+    public:
+        WildcardTrie();
+
+        /*
+         * Keywords that match the same name are tried in the order they were
+         * inserted, and the first one is returned.
+         */
+        void insert( const ParserKeyword* keyword );
+        const ParserKeyword* match( const string_view& name ) const;
+
+        /* the literal prefixes that every match of the expression starts with */
+        static std::vector< std::string > prefixes( const std::string& regex );
+
+    private:
+        struct node {
+            std::vector< std::pair< char, size_t > > children;
+            std::vector< std::pair< size_t, const ParserKeyword* > > keywords;
+        };
+
+        std::vector< node > nodes;
+        size_t count = 0;
+    };
+
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_LEXER_HPP
+#define OPM_LEXER_HPP
+
+#include <algorithm>
+
+#include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
+#include <opm/parser/eclipse/Utility/Stringview.hpp>
+
+namespace Opm {
+
+    /*
+     * The byte scanning kernels of the raw parser. The functions classify the
+     * input in blocks of 32 bytes using SSE2 or AVX2 when the target supports
+     * it, and fall back to the RawConsts lookup tables for the remaining tail
+     * and on other targets. The classification is identical to the one in
+     * RawConsts, including the 7-bit masking of non-ascii characters.
+     */
+    namespace lexer {
+
+        /*
+         * Returns a pointer to the first character in [begin, end) which is
+         * a newline, '-', '/' or a quote, or end if there is no such
+         * character.
+         */
+        const char* find_special( const char* begin, const char* end );
+
+        /*
+         * Returns a pointer to the first separator, respectively
+         * non-separator, in [begin, end) (see RawConsts::is_separator).
+         */
+        const char* find_separator( const char* begin, const char* end );
+        const char* skip_separators( const char* begin, const char* end );
+
+        /*
+         * Remove everything that isn't interesting data from the input:
+         * comments, leading and trailing whitespace and everything after
+         * (terminating) slashes. Lines are only newline-terminated in the
+         * output if they were in the input. Every line is processed in a single
+         * pass over its characters.
+         *
+         * The cleaned text is written to dst and the end of the written range
+         * is returned. The cleaned text is never longer than the input, and a
+         * line is never written past the point where it was read, so dst is
+         * allowed to alias the input.
+         */
+        char* clean( string_view input, char* dst );
+
+        /*
+         * Split a record string into its items, separated by
+         * RawConsts::is_separator. Single-quoted strings are a single item,
+         * even if they contain separators.
+         */
+        template< typename Container >
+        void tokenize( string_view record, Container& dst ) {
+            const auto* current = record.begin();
+            const auto* end = record.end();
+
+            while( (current = skip_separators( current, end )) != end ) {
+                const char* token_end;
+
+                if( *current == RawConsts::quote ) {
+                    token_end = std::find( current + 1, end, RawConsts::quote );
+                    if( token_end != end ) ++token_end;
+                } else {
+                    token_end = find_separator( current, end );
+                }
+
+                dst.emplace_back( current, token_end );
+                current = token_end;
+            }
+        }
+
+    }
+}
+
+#endif //OPM_LEXER_HPP
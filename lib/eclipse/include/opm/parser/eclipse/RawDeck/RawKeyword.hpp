@@ -23,25 +23,31 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <list>
 
 #include <opm/parser/eclipse/RawDeck/RawEnums.hpp>
+#include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
+#include <opm/parser/eclipse/Utility/InternedString.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
 namespace Opm {
 
-    class RawRecord;
-    class string_view;
-
     /// Class representing a RawKeyword, meaning both the actual keyword phrase, and the records,
-    /// represented as a list of RawRecord objects.
+    /// represented as a vector of RawRecord objects.
     /// The class also contains static functions to aid the parsing of the input file.
     /// The creating of an instance is performed by calling the addRawRecordString method repeatedly.
+    ///
+    /// When the records are iterated over, they are all split at once into
+    /// a single token arena owned by the keyword. The arena can be handed
+    /// over from one keyword to the next with releaseTokenArena and
+    /// setTokenArena, so that a parser which is done with a keyword can
+    /// reuse its memory.
 
     class RawKeyword {
     public:
         RawKeyword(const string_view& name , Raw::KeywordSizeEnum sizeType , const std::string& filename, size_t lineNR);
         RawKeyword(const string_view& name , const std::string& filename, size_t lineNR , size_t inputSize , bool isTableCollection = false);
+        RawKeyword( const RawKeyword& );
+        RawKeyword& operator=( const RawKeyword& );
 
         const std::string& getKeywordName() const;
         void addRawRecordString( const string_view& );
@@ -60,11 +66,16 @@ namespace Opm {
         bool unKnownSize() const;
         void finalizeUnknownSize();
 
+        void setTokenArena( std::vector< string_view >&& );
+        std::vector< string_view > releaseTokenArena();
+
         const std::string& getFilename() const;
         size_t getLineNR() const;
+        /* the size of the cleaned input of the records */
+        size_t getByteSize() const;
 
-        using const_iterator = std::list< RawRecord >::const_iterator;
-        using iterator = std::list< RawRecord >::iterator;
+        using const_iterator = std::vector< RawRecord >::const_iterator;
+        using iterator = std::vector< RawRecord >::iterator;
 
         const_iterator begin() const;
         const_iterator end() const;
@@ -79,16 +90,19 @@ namespace Opm {
         size_t m_fixedSize;
         size_t m_numTables;
         size_t m_currentNumTables = 0;
-        std::string m_name;
-        std::list< RawRecord > m_records;
+        InternedString m_name;
+        std::vector< RawRecord > m_records;
         string_view m_partialRecordString;
+        mutable std::vector< string_view > m_tokens;
+        mutable bool m_split = false;
 
         size_t m_lineNR;
-        std::string m_filename;
+        InternedString m_filename;
         bool m_is_title = false;
 
         void commonInit(const std::string& name,const std::string& filename, size_t lineNR);
         void setKeywordName(const std::string& keyword);
+        void split() const;
         static bool isValidKeyword(const std::string& keywordCandidate);
     };
 }
@@ -20,30 +20,52 @@
 #ifndef RECORD_HPP
 #define RECORD_HPP
 
-#include <deque>
 #include <memory>
+#include <stdexcept>
 #include <string>
-#include <list>
+#include <vector>
 
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
 namespace Opm {
 
+    class RawKeyword;
+
     /// Class representing the lowest level of the Raw datatypes, a record. A record is simply
     /// a vector containing the record elements, represented as strings. Some logic is present
     /// to handle special elements in a record string, particularly with quote characters.
+    ///
+    /// The record string is only split into elements when they are first
+    /// accessed, so that records which are never looked at, or which are
+    /// looked at in another thread, don't cost the parser thread anything. A
+    /// record must not be used by several threads until it has been split.
+    ///
+    /// The elements of a record that belongs to a RawKeyword are stored in
+    /// the token arena of the keyword, together with the elements of the
+    /// other records. Elements are consumed by advancing past them. The file
+    /// and keyword names are references, to the interned names of the keyword
+    /// or to strings that must outlive the record.
 
     class RawRecord {
     public:
-        RawRecord( const string_view&, const std::string& fileName = "", const std::string& keywordName = "");
+        using const_iterator = const string_view*;
+
+        RawRecord( const string_view& );
+        RawRecord( const string_view&, const std::string& fileName, const std::string& keywordName );
+        RawRecord( const RawRecord& );
+        RawRecord( RawRecord&& ) = default;
+        RawRecord& operator=( const RawRecord& );
+        RawRecord& operator=( RawRecord&& ) = default;
 
         inline string_view pop_front();
-        void push_front( string_view token );
+        inline void pop_front( size_t count );
         void prepend( size_t count, string_view token );
         inline size_t size() const;
 
         std::string getRecordString() const;
         inline string_view getItem(size_t index) const;
+        inline const_iterator begin() const;
+        inline const_iterator end() const;
         const std::string& getFileName() const;
         const std::string& getKeywordName() const;
 
@@ -52,30 +74,69 @@ namespace Opm {
        void dump() const;
 
     private:
+        friend class RawKeyword;
+
         string_view m_sanitizedRecordString;
-        std::deque< string_view > m_recordItems;
-        const std::string m_fileName;
-        const std::string m_keywordName;
 
-        void setRecordString(const std::string& singleRecordString);
+        /*
+         * The remaining elements are [m_first, m_last). The elements between
+         * m_lower and m_first are consumed, and can be overwritten by prepend.
+         * The elements are either in the arena of the keyword, or in
+         * m_items if the record has been split on its own.
+         */
+        mutable string_view* m_lower = nullptr;
+        mutable string_view* m_first = nullptr;
+        mutable string_view* m_last = nullptr;
+        mutable std::vector< string_view > m_items;
+        mutable bool m_split = false;
+        const std::string* m_fileName;
+        const std::string* m_keywordName;
+
+        inline void split() const;
+        void splitRecordString() const;
+        void bind( string_view* first, string_view* last ) const;
+        bool ownsItems() const;
+        void own( size_t headroom );
     };
 
     /*
      * These are frequently called, but fairly trivial in implementation, and
      * inlining the calls gives a decent low-effort performance benefit.
      */
+    void RawRecord::split() const {
+        if( !this->m_split ) this->splitRecordString();
+    }
+
     string_view RawRecord::pop_front() {
-        auto front = m_recordItems.front();
-        this->m_recordItems.pop_front();
-        return front;
+        this->split();
+        return *this->m_first++;
+    }
+
+    void RawRecord::pop_front( size_t count ) {
+        this->split();
+        this->m_first += count;
     }
 
     size_t RawRecord::size() const {
-        return m_recordItems.size();
+        this->split();
+        return this->m_last - this->m_first;
     }
 
     string_view RawRecord::getItem(size_t index) const {
-        return this->m_recordItems.at( index );
+        if( index >= this->size() )
+            throw std::out_of_range( "RawRecord::getItem: index out of range" );
+
+        return this->m_first[ index ];
+    }
+
+    RawRecord::const_iterator RawRecord::begin() const {
+        this->split();
+        return this->m_first;
+    }
+
+    RawRecord::const_iterator RawRecord::end() const {
+        this->split();
+        return this->m_last;
     }
 }
 
@@ -20,7 +20,10 @@
 #ifndef STAR_TOKEN_HPP
 #define STAR_TOKEN_HPP
 
+#include <algorithm>
+#include <iterator>
 #include <string>
+#include <vector>
 
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 #include <ert/util/ssize_t.h>
@@ -33,6 +36,39 @@ namespace Opm {
     template <class T>
     T readValueToken( string_view );
 
+    /*
+     * Non-throwing versions of readValueToken for the numeric types. Returns
+     * false, and leaves value untouched, if the token is not a well-formed
+     * number.
+     */
+    bool tryReadValueToken( string_view, int& value );
+    bool tryReadValueToken( string_view, double& value );
+
+    /*
+     * Convert the tokens in [first, last) and append the values to dst. The
+     * conversion stops at the first token that is not a plain number, e.g. a
+     * star token or a malformed number, and the position of that token is
+     * returned.
+     */
+    template< typename T, typename Itr >
+    Itr readValueTokens( Itr first, Itr last, std::vector< T >& dst ) {
+        /*
+         * this is called repeatedly for the same vector when the run of plain
+         * numbers is broken by star tokens, so grow geometrically
+         */
+        const size_t needed = dst.size() + std::distance( first, last );
+        if( needed > dst.capacity() )
+            dst.reserve( std::max( needed, 2 * dst.capacity() ) );
+
+        T value;
+        for( ; first != last; ++first ) {
+            if( !tryReadValueToken( *first, value ) ) break;
+            dst.push_back( value );
+        }
+
+        return first;
+    }
+
 class StarToken {
 public:
     StarToken(const string_view& token)
@@ -38,6 +38,8 @@ namespace Opm {
         bool equal(const Dimension& other) const;
         const std::string& getName() const;
         bool isCompositable() const;
+        /* the scaling is only known from the context, and can't be converted */
+        bool isContextDependent() const;
         static Dimension newComposite(const std::string& dim, double SIfactor, double SIoffset = 0.0);
 
         bool operator==( const Dimension& ) const;
@@ -0,0 +1,140 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_INTERNEDSTRING_HPP
+#define OPM_INTERNEDSTRING_HPP
+
+#include <iosfwd>
+#include <string>
+
+#include <opm/parser/eclipse/Utility/Stringview.hpp>
+
+namespace Opm {
+
+    /*
+     * The names of keywords, items and files are repeated all over a deck,
+     * so they are interned in a process-wide pool instead of being copied
+     * into every object that carries them. An InternedString is a pointer
+     * into the pool, and two interned strings are equal exactly when they
+     * point to the same pool entry.
+     *
+     * Interning takes a lock, so code that creates many objects with the same
+     * name should intern it once and pass the InternedString around. The
+     * pool is never shrunk, and references to interned strings are valid for
+     * the lifetime of the process.
+     */
+    class InternedString {
+        public:
+            InternedString();
+            //cppcheck-suppress noExplicitConstructor
+            InternedString( const std::string& );
+            //cppcheck-suppress noExplicitConstructor
+            InternedString( const char* );
+            explicit InternedString( string_view );
+
+            inline const std::string& string() const;
+            inline operator const std::string&() const;
+            inline const char* c_str() const;
+            inline size_t size() const;
+            inline bool empty() const;
+
+            inline bool operator==( const InternedString& ) const;
+            inline bool operator!=( const InternedString& ) const;
+
+        private:
+            const std::string* str;
+    };
+
+    inline bool operator==( const InternedString&, const std::string& );
+    inline bool operator==( const std::string&, const InternedString& );
+    inline bool operator==( const InternedString&, const char* );
+    inline bool operator==( const char*, const InternedString& );
+    inline bool operator!=( const InternedString&, const std::string& );
+    inline bool operator!=( const std::string&, const InternedString& );
+    inline bool operator!=( const InternedString&, const char* );
+    inline bool operator!=( const char*, const InternedString& );
+
+    std::ostream& operator<<( std::ostream&, const InternedString& );
+
+    /*
+     * Implementation
+     */
+
+    const std::string& InternedString::string() const {
+        return *this->str;
+    }
+
+    InternedString::operator const std::string&() const {
+        return *this->str;
+    }
+
+    const char* InternedString::c_str() const {
+        return this->str->c_str();
+    }
+
+    size_t InternedString::size() const {
+        return this->str->size();
+    }
+
+    bool InternedString::empty() const {
+        return this->str->empty();
+    }
+
+    bool InternedString::operator==( const InternedString& rhs ) const {
+        return this->str == rhs.str;
+    }
+
+    bool InternedString::operator!=( const InternedString& rhs ) const {
+        return !( *this == rhs );
+    }
+
+    bool operator==( const InternedString& lhs, const std::string& rhs ) {
+        return &lhs.string() == &rhs || lhs.string() == rhs;
+    }
+
+    bool operator==( const std::string& lhs, const InternedString& rhs ) {
+        return rhs == lhs;
+    }
+
+    bool operator==( const InternedString& lhs, const char* rhs ) {
+        return lhs.string() == rhs;
+    }
+
+    bool operator==( const char* lhs, const InternedString& rhs ) {
+        return rhs == lhs;
+    }
+
+    bool operator!=( const InternedString& lhs, const std::string& rhs ) {
+        return !( lhs == rhs );
+    }
+
+    bool operator!=( const std::string& lhs, const InternedString& rhs ) {
+        return !( lhs == rhs );
+    }
+
+    bool operator!=( const InternedString& lhs, const char* rhs ) {
+        return !( lhs == rhs );
+    }
+
+    bool operator!=( const char* lhs, const InternedString& rhs ) {
+        return !( lhs == rhs );
+    }
+}
+
+#endif //OPM_INTERNEDSTRING_HPP
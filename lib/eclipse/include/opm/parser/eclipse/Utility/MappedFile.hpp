@@ -0,0 +1,67 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_MAPPEDFILE_HPP
+#define OPM_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace Opm {
+
+    /*
+     * A private, writable memory mapping of an input file. Writes to the
+     * mapping are copy-on-write and never reach the file on disk, which means
+     * the parser can clean the input in place and avoid keeping a second copy
+     * of the file around. Only the pages that are written become anonymous
+     * memory, the rest can be dropped by the kernel at any time.
+     *
+     * On platforms without mmap, or if the file can't be mapped for some
+     * reason (empty files, pipes and special files), the mapping is empty and
+     * the caller should fall back to reading the file.
+     */
+    class MappedFile {
+        public:
+            MappedFile() = default;
+            explicit MappedFile( const std::string& path );
+            MappedFile( MappedFile&& );
+            MappedFile& operator=( MappedFile&& );
+            MappedFile( const MappedFile& ) = delete;
+            MappedFile& operator=( const MappedFile& ) = delete;
+            ~MappedFile();
+
+            explicit operator bool() const { return this->ptr != nullptr; }
+            char* data() const { return this->ptr; }
+            size_t size() const { return this->len; }
+
+            /*
+             * Drop the pages that are entirely within [first, last), and
+             * return the end of the dropped range. The pages read as the file
+             * contents again afterwards.
+             */
+            size_t discard( size_t first, size_t last );
+
+        private:
+            char* ptr = nullptr;
+            size_t len = 0;
+    };
+
+}
+
+#endif
@@ -0,0 +1,245 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_UTILITY_SMALLVECTOR_HPP
+#define OPM_UTILITY_SMALLVECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+    /*
+     * A vector that keeps up to N elements in place, and moves them to a
+     * std::vector when it grows past that. The std::vector shares the space
+     * of the elements kept in place, so a small_vector is no larger than a
+     * std::vector for N up to about three pointers worth of elements.
+     *
+     * Most deck items hold one or a few values, and are spared an
+     * allocation. Large ones are a plain std::vector, which heap() hands out
+     * as it is.
+     */
+    template< typename T, size_t N >
+    class small_vector {
+        static_assert( N > 0 && N < 256, "small_vector keeps 1 to 255 elements in place" );
+
+        public:
+            using value_type = T;
+            using iterator = T*;
+            using const_iterator = const T*;
+
+            small_vector() noexcept {}
+            inline small_vector( const small_vector& );
+            inline small_vector( small_vector&& ) noexcept;
+            inline small_vector& operator=( const small_vector& );
+            inline small_vector& operator=( small_vector&& ) noexcept;
+            inline ~small_vector();
+
+            size_t size() const { return this->on_heap ? this->vec.size() : this->count; }
+            bool empty() const { return this->size() == 0; }
+
+            T* data() { return this->on_heap ? this->vec.data() : this->local(); }
+            const T* data() const { return this->on_heap ? this->vec.data() : this->local(); }
+
+            T& operator[]( size_t i ) { return this->data()[ i ]; }
+            const T& operator[]( size_t i ) const { return this->data()[ i ]; }
+            T& back() { return this->data()[ this->size() - 1 ]; }
+            const T& back() const { return this->data()[ this->size() - 1 ]; }
+
+            iterator begin() { return this->data(); }
+            iterator end() { return this->data() + this->size(); }
+            const_iterator begin() const { return this->data(); }
+            const_iterator end() const { return this->data() + this->size(); }
+
+            /* the elements, if they have outgrown the space in place */
+            const std::vector< T >* heap() const { return this->on_heap ? &this->vec : nullptr; }
+
+            inline void reserve( size_t );
+            inline void push_back( T );
+            template< typename It > inline void append( It first, It last );
+            /* replace the elements, taking over xs if they don't fit in place */
+            inline void assign( std::vector< T >&& xs );
+            inline void clear();
+
+        private:
+            union {
+                typename std::aligned_storage< sizeof( T ), alignof( T ) >::type storage[ N ];
+                std::vector< T > vec;
+            };
+            unsigned char count = 0;
+            bool on_heap = false;
+
+            T* local() { return reinterpret_cast< T* >( this->storage ); }
+            const T* local() const { return reinterpret_cast< const T* >( this->storage ); }
+
+            inline void to_heap( size_t capacity );
+            inline void destroy();
+    };
+
+    template< typename T, size_t N >
+    bool operator==( const small_vector< T, N >& lhs, const small_vector< T, N >& rhs ) {
+        return lhs.size() == rhs.size()
+            && std::equal( lhs.begin(), lhs.end(), rhs.begin() );
+    }
+
+    template< typename T, size_t N >
+    bool operator!=( const small_vector< T, N >& lhs, const small_vector< T, N >& rhs ) {
+        return !( lhs == rhs );
+    }
+
+    /*
+     * Implementation
+     */
+
+    /* a copy is kept in place if it fits, even if the original is not */
+    template< typename T, size_t N >
+    small_vector< T, N >::small_vector( const small_vector& other ) {
+        if( other.size() > N ) {
+            new (&this->vec) std::vector< T >( other.vec );
+            this->on_heap = true;
+            return;
+        }
+
+        for( const auto& x : other ) new (this->local() + this->count++) T( x );
+    }
+
+    template< typename T, size_t N >
+    small_vector< T, N >::small_vector( small_vector&& other ) noexcept {
+        if( other.on_heap ) {
+            new (&this->vec) std::vector< T >( std::move( other.vec ) );
+            this->on_heap = true;
+            return;
+        }
+
+        for( auto& x : other ) new (this->local() + this->count++) T( std::move( x ) );
+    }
+
+    template< typename T, size_t N >
+    small_vector< T, N >& small_vector< T, N >::operator=( const small_vector& other ) {
+        if( this == &other ) return *this;
+
+        small_vector copy( other );
+        return *this = std::move( copy );
+    }
+
+    template< typename T, size_t N >
+    small_vector< T, N >& small_vector< T, N >::operator=( small_vector&& other ) noexcept {
+        if( this == &other ) return *this;
+
+        this->destroy();
+        if( other.on_heap ) {
+            new (&this->vec) std::vector< T >( std::move( other.vec ) );
+            this->on_heap = true;
+            return *this;
+        }
+
+        for( auto& x : other ) new (this->local() + this->count++) T( std::move( x ) );
+        return *this;
+    }
+
+    template< typename T, size_t N >
+    small_vector< T, N >::~small_vector() {
+        this->destroy();
+    }
+
+    /* destroy the elements, and leave an empty vector in place */
+    template< typename T, size_t N >
+    void small_vector< T, N >::destroy() {
+        if( this->on_heap )
+            this->vec.~vector();
+        else
+            for( auto& x : *this ) x.~T();
+
+        this->count = 0;
+        this->on_heap = false;
+    }
+
+    template< typename T, size_t N >
+    void small_vector< T, N >::to_heap( size_t capacity ) {
+        if( this->on_heap ) {
+            this->vec.reserve( capacity );
+            return;
+        }
+
+        std::vector< T > xs;
+        xs.reserve( std::max( capacity, 2 * N ) );
+        xs.insert( xs.end(), std::make_move_iterator( this->begin() ),
+                             std::make_move_iterator( this->end() ) );
+
+        this->destroy();
+        new (&this->vec) std::vector< T >( std::move( xs ) );
+        this->on_heap = true;
+    }
+
+    template< typename T, size_t N >
+    void small_vector< T, N >::reserve( size_t capacity ) {
+        if( capacity > N || this->on_heap ) this->to_heap( capacity );
+    }
+
+    template< typename T, size_t N >
+    void small_vector< T, N >::push_back( T x ) {
+        if( !this->on_heap && this->count < N ) {
+            new (this->local() + this->count++) T( std::move( x ) );
+            return;
+        }
+
+        if( !this->on_heap ) this->to_heap( this->size() + 1 );
+        this->vec.push_back( std::move( x ) );
+    }
+
+    template< typename T, size_t N >
+    template< typename It >
+    void small_vector< T, N >::append( It first, It last ) {
+        const size_t n = std::distance( first, last );
+
+        if( !this->on_heap && this->count + n <= N ) {
+            for( ; first != last; ++first )
+                new (this->local() + this->count++) T( *first );
+            return;
+        }
+
+        this->to_heap( this->size() + n );
+        this->vec.insert( this->vec.end(), first, last );
+    }
+
+    template< typename T, size_t N >
+    void small_vector< T, N >::assign( std::vector< T >&& xs ) {
+        this->destroy();
+
+        if( xs.size() > N ) {
+            new (&this->vec) std::vector< T >( std::move( xs ) );
+            this->on_heap = true;
+            return;
+        }
+
+        for( auto& x : xs ) new (this->local() + this->count++) T( std::move( x ) );
+    }
+
+    template< typename T, size_t N >
+    void small_vector< T, N >::clear() {
+        this->destroy();
+    }
+}
+
+#endif
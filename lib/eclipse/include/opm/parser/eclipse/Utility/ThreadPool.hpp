@@ -0,0 +1,129 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_THREADPOOL_HPP
+#define OPM_THREADPOOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Opm {
+
+    /*
+     * A small work-stealing thread pool. Every worker has its own task queue,
+     * and when that is empty it steals from the other workers' queues. Tasks
+     * submitted from a worker go to that worker's queue, other tasks are
+     * distributed round robin. Tasks are always taken oldest first, since
+     * the results are usually consumed in the order they were submitted.
+     *
+     * Threads waiting for a result should help out with run_one() rather than
+     * block, which also makes it safe for tasks to wait on other tasks:
+     *
+     * auto f = pool.submit( task );
+     * pool.wait( f );
+     *
+     * The destructor runs all remaining tasks before joining the workers.
+     */
+    class ThreadPool {
+        public:
+            explicit ThreadPool( size_t workers );
+            ~ThreadPool();
+
+            ThreadPool( const ThreadPool& ) = delete;
+            ThreadPool& operator=( const ThreadPool& ) = delete;
+
+            size_t size() const;
+
+            template< typename F >
+            std::future< typename std::result_of< F() >::type > submit( F&& );
+
+            /*
+             * Run one queued task in the calling thread. Returns false if
+             * there were no queued tasks.
+             */
+            bool run_one();
+
+            /*
+             * The pool the calling thread is running a task for, or nullptr.
+             * This allows tasks to split their work into further tasks.
+             */
+            static ThreadPool* current();
+
+            /* help out with queued tasks until fut is ready */
+            template< typename T >
+            void wait( const std::future< T >& fut );
+
+        private:
+            using task = std::function< void() >;
+
+            struct queue {
+                std::mutex mutex;
+                std::deque< task > tasks;
+            };
+
+            std::vector< std::unique_ptr< queue > > queues;
+            std::vector< std::thread > workers;
+
+            std::mutex sleep_mutex;
+            std::condition_variable wakeup;
+            std::atomic< size_t > pending;
+            std::atomic< size_t > next;
+            bool stop = false;
+
+            void push( task&& );
+            bool pop( size_t, task& );
+            void work( size_t );
+    };
+
+    template< typename F >
+    std::future< typename std::result_of< F() >::type >
+    ThreadPool::submit( F&& f ) {
+        using R = typename std::result_of< F() >::type;
+
+        /*
+         * packaged_task is move-only, but std::function must be copyable, so
+         * hand it over in a shared_ptr.
+         */
+        auto pt = std::make_shared< std::packaged_task< R() > >( std::forward< F >( f ) );
+        auto fut = pt->get_future();
+        this->push( [pt] { (*pt)(); } );
+        return fut;
+    }
+
+    template< typename T >
+    void ThreadPool::wait( const std::future< T >& fut ) {
+        while( fut.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+            if( !this->run_one() ) {
+                fut.wait();
+                return;
+            }
+        }
+    }
+}
+
+#endif //OPM_THREADPOOL_HPP
@@ -105,6 +105,7 @@ set( keywords
      000_Eclipse100/I/IMBNUM
      000_Eclipse100/I/IMKRVD
      000_Eclipse100/I/IMPES
+     000_Eclipse100/I/IMPORT
      000_Eclipse100/I/IMPTVD
      000_Eclipse100/I/INCLUDE
      000_Eclipse100/I/INIT
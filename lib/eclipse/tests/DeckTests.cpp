@@ -18,7 +18,12 @@
  */
 
 
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 #define BOOST_TEST_MODULE DeckTests
 
@@ -30,6 +35,7 @@
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
+#include <opm/parser/eclipse/Utility/SmallVector.hpp>
 
 using namespace Opm;
 
@@ -356,6 +362,295 @@ BOOST_AUTO_TEST_CASE(GetSIMultipleDim) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(RepeatedValuesStayCompressed) {
+    DeckItem item( "HEI", double() );
+    Dimension dim{ "Length" , 10 };
+
+    item.push_back( 1.0 );
+    item.push_back( 2.0 );
+    item.push_back( 0.25, 1000000 );
+    item.push_backDefault( 3.0, 10 );
+    item.push_back( 4.0 );
+    item.push_backDimension( dim , dim );
+
+    BOOST_CHECK_EQUAL( 1000013U , item.size() );
+    BOOST_CHECK_EQUAL( 4U , item.getRuns().size() );
+    BOOST_CHECK_EQUAL( 5U , item.getRunValues< double >().size() );
+
+    BOOST_CHECK_EQUAL( 2.0 , item.get< double >( 1 ) );
+    BOOST_CHECK_EQUAL( 0.25 , item.get< double >( 2 ) );
+    BOOST_CHECK_EQUAL( 0.25 , item.get< double >( 1000001 ) );
+    BOOST_CHECK_EQUAL( 3.0 , item.get< double >( 1000002 ) );
+    BOOST_CHECK_EQUAL( 4.0 , item.get< double >( 1000012 ) );
+    BOOST_CHECK_EQUAL( 2.5 , item.getSIDouble( 1000001 ) );
+    BOOST_CHECK( !item.defaultApplied( 1000001 ) );
+    BOOST_CHECK( item.defaultApplied( 1000002 ) );
+    BOOST_CHECK( !item.defaultApplied( 1000012 ) );
+    BOOST_CHECK_THROW( item.get< double >( 1000013 ), std::out_of_range );
+
+    const auto& data = item.getData< double >();
+    BOOST_CHECK_EQUAL( 1000013U , data.size() );
+    BOOST_CHECK_EQUAL( 0.25 , data[ 500000 ] );
+    BOOST_CHECK_EQUAL( 3.0 , data[ 1000011 ] );
+    BOOST_CHECK_EQUAL( 40.0 , item.getSIDoubleData().back() );
+}
+
+BOOST_AUTO_TEST_CASE(ConvertToSI) {
+    DeckItem item( "HEI", double() );
+    Dimension dim1{ "Length" , 2 };
+    Dimension dim2{ "Length" , 4 };
+    Dimension defaultDim{ "Length" , 100 };
+
+    item.push_back( 1.0 );
+    item.push_back( 0.5, 4 );
+    item.push_backDefault( 3.0, 3 );
+    item.push_back( 2.0 );
+    item.push_backDimension( dim1 , defaultDim );
+    item.push_backDimension( dim2 , defaultDim );
+
+    const auto si = item.getSIDoubleData();
+    BOOST_CHECK( !item.storesSI() );
+    item.convertToSI();
+    BOOST_CHECK( item.storesSI() );
+
+    /* the repeated runs are expanded, since they span both dimensions */
+    BOOST_CHECK( si == item.getSIDoubleData() );
+    BOOST_CHECK_EQUAL( 2.0 , item.getSIDouble( 0 ) );
+    BOOST_CHECK_EQUAL( 2.0 , item.getSIDouble( 3 ) );
+    BOOST_CHECK_EQUAL( 1.0 , item.getSIDouble( 4 ) );
+    BOOST_CHECK_EQUAL( 12.0 , item.getSIDouble( 7 ) );
+
+    BOOST_CHECK_EQUAL( 1.0 , item.get< double >( 0 ) );
+    BOOST_CHECK_EQUAL( 0.5 , item.get< double >( 3 ) );
+    BOOST_CHECK_EQUAL( 0.5 , item.get< double >( 4 ) );
+    BOOST_CHECK_EQUAL( 3.0 , item.getData< double >()[ 7 ] );
+    BOOST_CHECK( item.defaultApplied( 5 ) );
+    BOOST_CHECK( !item.defaultApplied( 4 ) );
+
+    std::vector< double > out( item.size(), -1 );
+    item.writeSIData( out.data() );
+    BOOST_CHECK_EQUAL( 1.0 , out[ 4 ] );
+    BOOST_CHECK_EQUAL( -1 , out[ 5 ] );
+
+    const DeckItem copy( item );
+    BOOST_CHECK( copy.storesSI() );
+    BOOST_CHECK( copy.getData< double >() == item.getData< double >() );
+
+    BOOST_CHECK_THROW( item.push_back( 1.0 ), std::logic_error );
+    BOOST_CHECK_THROW( item.push_backDimension( dim1, dim1 ), std::logic_error );
+}
+
+BOOST_AUTO_TEST_CASE(ConvertToSIKeepsRepeatedRuns) {
+    DeckItem item( "HEI", double() );
+    Dimension dim{ "Length" , 10 };
+
+    item.push_back( 0.25, 1000000 );
+    item.push_back( 4.0 );
+    item.push_backDimension( dim , dim );
+    item.convertToSI();
+
+    BOOST_CHECK_EQUAL( 2U , item.getRuns().size() );
+    BOOST_CHECK_EQUAL( 2U , item.getRunValues< double >().size() );
+    BOOST_CHECK_EQUAL( 2.5 , item.getSIDouble( 999999 ) );
+    BOOST_CHECK_EQUAL( 0.25 , item.get< double >( 999999 ) );
+    BOOST_CHECK_EQUAL( 40.0 , item.getSIDoubleData().back() );
+}
+
+BOOST_AUTO_TEST_CASE(ConvertToSIContextDependent) {
+    DeckItem item( "HEI", double() );
+    const auto dim = Dimension::newComposite( "ContextDependent",
+                                              std::numeric_limits< double >::quiet_NaN() );
+
+    item.push_back( 1.5 );
+    item.push_backDimension( dim , dim );
+    item.convertToSI();
+
+    BOOST_CHECK( !item.storesSI() );
+    BOOST_CHECK_EQUAL( 1.5 , item.get< double >( 0 ) );
+    BOOST_CHECK_THROW( item.getSIDouble( 0 ), std::logic_error );
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorGrowsOutOfPlace) {
+    small_vector< std::string, 2 > xs;
+    xs.push_back( "a" );
+    xs.push_back( "b" );
+    BOOST_CHECK( !xs.heap() );
+
+    xs.push_back( "c" );
+    BOOST_REQUIRE( xs.heap() );
+    BOOST_CHECK_EQUAL( 3U, xs.size() );
+    BOOST_CHECK_EQUAL( "a", xs[ 0 ] );
+    BOOST_CHECK_EQUAL( "c", xs.back() );
+
+    const std::vector< std::string > ys = { "d", "e" };
+    xs.append( ys.begin(), ys.end() );
+    BOOST_CHECK_EQUAL( 5U, xs.size() );
+    BOOST_CHECK_EQUAL( "e", xs.back() );
+
+    xs.clear();
+    BOOST_CHECK( xs.empty() );
+    BOOST_CHECK( !xs.heap() );
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorCopyMoveAssign) {
+    small_vector< int, 2 > small;
+    small.push_back( 1 );
+
+    small_vector< int, 2 > large;
+    large.assign( std::vector< int >{ 1, 2, 3 } );
+    BOOST_REQUIRE( large.heap() );
+    const auto* data = large.data();
+
+    auto copy = large;
+    BOOST_CHECK( copy == large );
+    BOOST_CHECK( copy.data() != data );
+
+    auto moved = std::move( large );
+    BOOST_CHECK( moved == copy );
+    BOOST_CHECK_EQUAL( data, moved.data() );
+
+    copy = small;
+    BOOST_CHECK( !copy.heap() );
+    BOOST_CHECK( copy == small );
+    BOOST_CHECK( copy != moved );
+
+    small = std::move( moved );
+    BOOST_CHECK_EQUAL( 3U, small.size() );
+    BOOST_CHECK_EQUAL( data, small.data() );
+
+    small_vector< int, 2 > inplace;
+    inplace.assign( std::vector< int >{ 4, 5 } );
+    BOOST_CHECK( !inplace.heap() );
+    BOOST_CHECK_EQUAL( 5, inplace.back() );
+}
+
+BOOST_AUTO_TEST_CASE(SmallItemsKeepValuesInPlace) {
+    DeckItem item( "HEI", double() );
+    Dimension dim{ "Length" , 10 };
+
+    item.push_back( 1.5 );
+    item.push_backDimension( dim , dim );
+    BOOST_CHECK( !item.getRunValues< double >().heap() );
+    BOOST_CHECK_EQUAL( 1.5, item.getData< double >().front() );
+    BOOST_CHECK_EQUAL( 15.0, item.getSIDouble( 0 ) );
+
+    /* the dimensions are shared by all items */
+    DeckItem other( "HEI", double() );
+    other.push_back( 2.5 );
+    other.push_backDimension( dim , dim );
+    BOOST_CHECK_EQUAL( item.getDimensions()[ 0 ], other.getDimensions()[ 0 ] );
+
+    const auto copy = item;
+    BOOST_CHECK_EQUAL( 1.5, copy.get< double >( 0 ) );
+    BOOST_CHECK_EQUAL( 15.0, copy.getSIDouble( 0 ) );
+}
+
+BOOST_AUTO_TEST_CASE(LazyValuesConcurrently) {
+    DeckItem item( "HEI", double() );
+    Dimension dim{ "Length" , 10 };
+
+    item.push_back( 1.0 );
+    item.push_back( 0.5, 100000 );
+    item.push_backDimension( dim , dim );
+
+    const DeckItem& shared = item;
+    std::atomic< int > wrong( 0 );
+    std::vector< std::thread > threads;
+    for( int t = 0; t < 8; ++t ) {
+        threads.emplace_back( [&] {
+            const auto& data = shared.getData< double >();
+            const auto& si = shared.getSIDoubleData();
+            if( data.size() != 100001 || data.back() != 0.5 ) ++wrong;
+            if( si.size() != 100001 || si.back() != 5.0 || si.front() != 10.0 ) ++wrong;
+            if( &si != &shared.getSIDoubleData() ) ++wrong;
+
+            /* a copy takes over the values that are done */
+            const DeckItem copy( shared );
+            if( copy.getSIDoubleData() != si ) ++wrong;
+        } );
+    }
+
+    for( auto& thread : threads ) thread.join();
+    BOOST_CHECK_EQUAL( 0, wrong.load() );
+
+    /* appending drops the values computed so far */
+    item.push_back( 2.0 );
+    BOOST_CHECK_EQUAL( 100002U, item.getSIDoubleData().size() );
+    BOOST_CHECK_EQUAL( 20.0, item.getSIDoubleData().back() );
+}
+
+BOOST_AUTO_TEST_CASE(PushBackRuns) {
+    DeckItem item( "HEI", int() );
+    item.push_back( 7 );
+
+    std::vector< DeckItem::run > runs = {
+        { 0, 2, 0, false, false },
+        { 2, 5, 2, true, true },
+        { 5, 6, 3, false, false },
+    };
+    item.push_back( std::vector< int >{ 1, 2, 3, 4 }, std::move( runs ) );
+
+    BOOST_CHECK_EQUAL( 7U , item.size() );
+    /* the first literal run is merged with the value before it */
+    BOOST_CHECK_EQUAL( 3U , item.getRuns().size() );
+
+    const std::vector< int > expected = { 7, 1, 2, 3, 3, 3, 4 };
+    const auto& data = item.getData< int >();
+    BOOST_CHECK_EQUAL_COLLECTIONS( expected.begin(), expected.end(),
+                                   data.begin(), data.end() );
+    BOOST_CHECK( item.defaultApplied( 4 ) );
+    BOOST_CHECK( !item.defaultApplied( 6 ) );
+}
+
+BOOST_AUTO_TEST_CASE(WriteDataSkipsDefaults) {
+    DeckItem item( "HEI", double() );
+    Dimension dim{ "Length" , 10 };
+
+    item.push_back( std::vector< double >{ 1.0, 2.0 } );
+    item.push_backDefault( 3.0, 2 );
+    item.push_back( 0.5, 3 );
+    item.push_backDimension( dim , dim );
+
+    std::vector< double > si( 7, -1 );
+    item.writeSIData( si.data() );
+    const std::vector< double > expected = { 10, 20, -1, -1, 5, 5, 5 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( expected.begin(), expected.end(),
+                                   si.begin(), si.end() );
+
+    std::vector< float > reversed( 7, -1 );
+    const std::vector< size_t > index = { 6, 5, 4, 3, 2, 1, 0 };
+    item.writeSIData( reversed.data(), index.data() );
+    const std::vector< float > expected_reversed = { 5, 5, 5, -1, -1, 20, 10 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( expected_reversed.begin(), expected_reversed.end(),
+                                   reversed.begin(), reversed.end() );
+
+    /* the bulk path does not leave SI data cached in the item */
+    BOOST_CHECK_EQUAL( 30.0 , item.getSIDoubleData()[ 2 ] );
+
+    DeckItem ints( "INTS", int() );
+    ints.push_back( 2, 2 );
+    ints.push_backDefault( 1 );
+    std::vector< int > out( 3, 0 );
+    ints.writeData( out.data() );
+    BOOST_CHECK_EQUAL( 2 , out[ 1 ] );
+    BOOST_CHECK_EQUAL( 0 , out[ 2 ] );
+
+    BOOST_CHECK_THROW( ints.writeSIData( si.data() ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(ScanRepeatedValues) {
+    ParserItem itemDouble( "ITEM", ParserItem::item_size::ALL );
+    itemDouble.setType( double() );
+    RawRecord rawRecord( "1.0 1000000*0.25 3* 2.0" );
+    const auto item = itemDouble.scan( rawRecord );
+
+    BOOST_CHECK_EQUAL( 1000005U , item.size() );
+    BOOST_CHECK_EQUAL( 4U , item.getRuns().size() );
+    BOOST_CHECK_EQUAL( 0.25 , item.get< double >( 1000000 ) );
+    BOOST_CHECK( item.defaultApplied( 1000003 ) );
+    BOOST_CHECK_EQUAL( 2.0 , item.get< double >( 1000004 ) );
+}
+
 BOOST_AUTO_TEST_CASE(HasValue) {
     DeckItem deckIntItem( "TEST", int() );
     BOOST_CHECK_EQUAL( false , deckIntItem.hasValue(0) );
@@ -559,3 +854,61 @@ BOOST_AUTO_TEST_CASE(setUnknown_wasknown_nowunknown) {
     DeckKeyword deckKeyword( "KW", false );
     BOOST_CHECK(!deckKeyword.isKnown());
 }
+
+namespace {
+
+struct counting_source : public DeckKeyword::Source {
+    mutable std::atomic< int > parsed{ 0 };
+
+    size_t size() const override { return 2; }
+
+    DeckKeyword parse() const override {
+        ++this->parsed;
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+
+        DeckKeyword keyword( "KW" );
+        keyword.addRecord( DeckRecord() );
+        keyword.addRecord( DeckRecord() );
+        return keyword;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(LazyKeyword_parsedOnce) {
+    auto source = std::make_shared< counting_source >();
+    DeckKeyword deckKeyword( "KW", source );
+
+    BOOST_CHECK( deckKeyword.isLazy() );
+    BOOST_CHECK_EQUAL( 2U, deckKeyword.size() );
+    BOOST_CHECK_EQUAL( 0, source->parsed.load() );
+
+    std::vector< std::thread > threads;
+    for( int i = 0; i < 4; ++i )
+        threads.emplace_back( [&deckKeyword] { deckKeyword.getRecord( 1 ); } );
+    for( auto& t : threads ) t.join();
+
+    BOOST_CHECK( !deckKeyword.isLazy() );
+    BOOST_CHECK_EQUAL( 1, source->parsed.load() );
+    BOOST_CHECK_EQUAL( 2U, deckKeyword.size() );
+}
+
+BOOST_AUTO_TEST_CASE(LazyKeyword_copies) {
+    auto source = std::make_shared< counting_source >();
+    DeckKeyword deckKeyword( "KW", source );
+
+    DeckKeyword copy = deckKeyword;
+    BOOST_CHECK( copy.isLazy() );
+    BOOST_CHECK_EQUAL( 2U, std::distance( copy.begin(), copy.end() ) );
+    BOOST_CHECK_EQUAL( 1, source->parsed.load() );
+    BOOST_CHECK( deckKeyword.isLazy() );
+
+    deckKeyword.addRecord( DeckRecord() );
+    BOOST_CHECK_EQUAL( 2, source->parsed.load() );
+    BOOST_CHECK_EQUAL( 3U, deckKeyword.size() );
+
+    copy = deckKeyword;
+    BOOST_CHECK( !copy.isLazy() );
+    BOOST_CHECK_EQUAL( 3U, copy.size() );
+    BOOST_CHECK_EQUAL( 2, source->parsed.load() );
+}
@@ -95,6 +95,23 @@ BOOST_AUTO_TEST_CASE(ParserKeyword_includeValid) {
 
 
 
+#ifdef HAVE_ZLIB
+BOOST_AUTO_TEST_CASE(ParserKeyword_includeCompressed) {
+    boost::filesystem::path inputFilePath(prefix() + "includeCompressed.data");
+
+    Opm::Parser parser;
+    auto deck = parser.parseFile(inputFilePath.string() , Opm::ParseContext());
+
+    BOOST_CHECK_EQUAL(4U , deck.size());
+    BOOST_CHECK_EQUAL(true , deck.hasKeyword("OIL"));
+    BOOST_CHECK_EQUAL(true , deck.hasKeyword("WATER"));
+    BOOST_CHECK_EQUAL(true , deck.hasKeyword("GAS"));
+    /* gzip_padded.inc has zeros after the gzip member */
+    BOOST_CHECK_EQUAL(true , deck.hasKeyword("DISGAS"));
+    BOOST_CHECK_EQUAL(4U , deck.getKeyword("WATER").getLineNumber());
+}
+#endif
+
 BOOST_AUTO_TEST_CASE(ParserKeyword_includeWrongCase) {
     boost::filesystem::path inputFile1Path(prefix() + "includeWrongCase1.data");
     boost::filesystem::path inputFile2Path(prefix() + "includeWrongCase2.data");
@@ -18,17 +18,32 @@
  */
 
 #define BOOST_TEST_MODULE ParserTests
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <opm/json/JsonObject.hpp>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Parser/KeywordHash.hpp>
+#include <opm/parser/eclipse/Parser/KeywordRegistry.hpp>
+#include <opm/parser/eclipse/Parser/MessageContainer.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/ParseProfile.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/A.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/C.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
+#include <opm/parser/eclipse/Parser/WildcardTrie.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 
@@ -40,6 +55,33 @@ std::string prefix() {
     return boost::unit_test::framework::master_test_suite().argv[1];
 }
 
+/* every keyword and value of the deck, with the doubles in SI if they can be */
+std::string dump( const Deck& deck ) {
+    std::ostringstream out;
+    for( const auto& keyword : deck ) {
+        out << keyword.name() << ' ' << keyword.size() << '\n';
+        for( const auto& record : keyword ) {
+            for( const auto& item : record ) {
+                if( item.getType() == type_tag::unknown || item.isDummyDefault() ) continue;
+
+                out << item.name() << ':';
+                if( item.getType() == type_tag::integer ) {
+                    for( auto x : item.getData< int >() ) out << ' ' << x;
+                } else if( item.getType() == type_tag::string ) {
+                    for( const auto& x : item.getData< std::string >() ) out << ' ' << x;
+                } else if( item.getDimensions().empty() ) {
+                    for( auto x : item.getData< double >() ) out << ' ' << x;
+                } else {
+                    for( auto x : item.getSIDoubleData() ) out << ' ' << x;
+                }
+                out << '\n';
+            }
+        }
+    }
+
+    return out.str();
+}
+
 std::unique_ptr< ParserKeyword > createDynamicSized(const std::string& kw) {
     std::unique_ptr< ParserKeyword > pkw( new ParserKeyword( kw ) );
     pkw->setSizeType(SLASH_TERMINATED);
@@ -292,6 +334,123 @@ BOOST_AUTO_TEST_CASE(WildCardTest) {
 }
 
 
+BOOST_AUTO_TEST_CASE(KeywordHashFindsAllNames) {
+    const std::vector< std::string > names = { "EQUIL", "EQLDIMS", "GRID", "PORO", "PERMX", "A" };
+    const auto hash = KeywordHash::build( names );
+
+    BOOST_CHECK_EQUAL( names.size(), hash.size() );
+
+    std::set< size_t > slots;
+    for( const auto& name : names ) {
+        const auto slot = hash.find( name );
+        BOOST_CHECK( slot < hash.size() );
+        BOOST_CHECK_EQUAL( hash.names()[ slot ], name );
+        slots.insert( slot );
+    }
+
+    BOOST_CHECK_EQUAL( names.size(), slots.size() );
+    BOOST_CHECK_EQUAL( KeywordHash::npos, hash.find( "PERM" ) );
+    BOOST_CHECK_EQUAL( KeywordHash::npos, hash.find( "PERMXY" ) );
+    BOOST_CHECK_EQUAL( KeywordHash::npos, KeywordHash().find( "PORO" ) );
+
+    const std::vector< std::string > duplicates = { "PORO", "PORO" };
+    BOOST_CHECK_THROW( KeywordHash::build( duplicates ), std::invalid_argument );
+}
+
+namespace {
+    size_t registryBuilds = 0;
+
+    template< size_t N >
+    ParserKeyword* makeNumbered() {
+        ++registryBuilds;
+        return new ParserKeyword( std::string( "KW" ) + char( '0' + N ) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(KeywordRegistryBuildsOnLookup) {
+    /* the hash refers to the names, which must outlive it */
+    const std::vector< std::string > names = { "KW0", "KW1", "KW2" };
+    const auto hash = KeywordHash::build( names );
+    const KeywordRegistry::Descriptor descriptors[] = {
+        { "KW0", nullptr, false, &makeNumbered< 0 > },
+        { "KW1", nullptr, false, &makeNumbered< 1 > },
+        { "KW2", nullptr, false, &makeNumbered< 2 > },
+    };
+
+    std::vector< uint32_t > slots( hash.size() );
+    for( uint32_t i = 0; i < 3; ++i )
+        slots[ hash.find( descriptors[ i ].name ) ] = i;
+
+    registryBuilds = 0;
+    KeywordRegistry registry( hash, descriptors, 3, slots.data(), 0 );
+    BOOST_CHECK_EQUAL( 0U, registry.built() );
+    BOOST_CHECK( registry.wildcards().empty() );
+
+    const auto& kw1 = registry.getSlot( hash.find( "KW1" ) );
+    BOOST_CHECK_EQUAL( "KW1", kw1.getName() );
+    BOOST_CHECK_EQUAL( &kw1, &registry.get( 1 ) );
+    BOOST_CHECK_EQUAL( 1U, registry.built() );
+    BOOST_CHECK_EQUAL( 1U, registryBuilds );
+
+    BOOST_CHECK_THROW( registry.get( 3 ), std::out_of_range );
+}
+
+BOOST_AUTO_TEST_CASE(DefaultKeywordsSharedAndOverridable) {
+    Parser parser1;
+    Parser parser2;
+
+    BOOST_CHECK( parser1.isRecognizedKeyword( "OIL" ) );
+    BOOST_CHECK_EQUAL( parser1.getParserKeywordFromDeckName( "OIL" ),
+                       parser2.getParserKeywordFromDeckName( "OIL" ) );
+
+    const auto names = parser1.getAllDeckNames();
+    BOOST_CHECK( parser1.size() <= names.size() );
+    BOOST_CHECK( std::is_sorted( names.begin(), names.begin() + parser1.size() ) );
+    BOOST_CHECK( std::adjacent_find( names.begin(), names.begin() + parser1.size() )
+                 == names.begin() + parser1.size() );
+
+    const auto size = parser1.size();
+    parser1.addParserKeyword( createDynamicSized( "OIL" ) );
+    BOOST_CHECK_EQUAL( size, parser1.size() );
+    BOOST_CHECK( parser1.getParserKeywordFromDeckName( "OIL" )
+                 != parser2.getParserKeywordFromDeckName( "OIL" ) );
+    BOOST_CHECK( !parser1.getParserKeywordFromDeckName( "OIL" )->hasFixedSize() );
+    BOOST_CHECK( parser2.getParserKeywordFromDeckName( "OIL" )->hasFixedSize() );
+
+    parser1.addParserKeyword( createDynamicSized( "NOTAKEYW" ) );
+    BOOST_CHECK_EQUAL( size + 1, parser1.size() );
+    BOOST_CHECK_EQUAL( size, parser2.size() );
+}
+
+BOOST_AUTO_TEST_CASE(WildcardTriePrefixes) {
+    const auto prefixes = []( const std::string& regex ) {
+        const auto p = WildcardTrie::prefixes( regex );
+        return std::set< std::string >( p.begin(), p.end() );
+    };
+
+    BOOST_CHECK( prefixes( "TVDP.+" ) == std::set< std::string >({ "TVDP" }) );
+    BOOST_CHECK( prefixes( "TNUM(F|S).{1,3}" ) == std::set< std::string >({ "TNUMF", "TNUMS" }) );
+    BOOST_CHECK( prefixes( "R[OGW]?[IP][PRT]_.+|RU.+" ) == std::set< std::string >({ "R", "RU" }) );
+    BOOST_CHECK( prefixes( "(AB|CD)?X" ) == std::set< std::string >({ "" }) );
+    BOOST_CHECK( prefixes( "ANQ?" ) == std::set< std::string >({ "AN" }) );
+}
+
+BOOST_AUTO_TEST_CASE(RecognizeHashedAndAddedKeywords) {
+    Parser parser;
+    BOOST_CHECK( parser.isRecognizedKeyword( "EQUIL" ) );
+    BOOST_CHECK( parser.isRecognizedKeyword( "WBHWC1" ) );
+    BOOST_CHECK( parser.isRecognizedKeyword( "FUOPR" ) );
+    BOOST_CHECK( !parser.isRecognizedKeyword( "EQUILX" ) );
+    BOOST_CHECK( !parser.isRecognizedKeyword( "QQQ" ) );
+
+    /* a name that was not in the generated hash */
+    BOOST_CHECK( !parser.isRecognizedKeyword( "FJAS" ) );
+    parser.addParserKeyword( createDynamicSized( "FJAS" ) );
+    BOOST_CHECK( parser.isRecognizedKeyword( "FJAS" ) );
+    BOOST_CHECK( parser.hasKeyword( "FJAS" ) );
+    BOOST_CHECK( parser.isRecognizedKeyword( "EQUIL" ) );
+}
+
 BOOST_AUTO_TEST_CASE( quoted_comments ) {
     BOOST_CHECK_EQUAL( Parser::stripComments( "ABC" ) , "ABC");
     BOOST_CHECK_EQUAL( Parser::stripComments( "--ABC") , "");
@@ -381,6 +540,729 @@ BOOST_AUTO_TEST_CASE(ParseTNUM) {
     BOOST_CHECK( deck.hasKeyword("TNUMFXXX"));
 }
 
+BOOST_AUTO_TEST_CASE(ParseBufferNoTrailingNewline) {
+    const std::string input = "RUNSPEC\n"
+                              "DIMENS -- comment\n"
+                              " 10 20 30 / trailing garbage\n"
+                              "OIL\n"
+                              "WATER";
+
+    Parser parser;
+    /* view only the first lines, WATER must not be seen by the parser */
+    string_view buffer( input.data(), input.find( "\nWATER" ) );
+    auto deck = parser.parseBuffer( buffer, ParseContext() );
+
+    BOOST_CHECK_EQUAL( 3U, deck.size() );
+    BOOST_CHECK( deck.hasKeyword( "OIL" ) );
+    BOOST_CHECK( !deck.hasKeyword( "WATER" ) );
+    BOOST_CHECK_EQUAL( 30, deck.getKeyword( "DIMENS" ).getRecord( 0 ).getItem( 2 ).get< int >( 0 ) );
+
+    auto whole = parser.parseString( input, ParseContext() );
+    BOOST_CHECK( whole.hasKeyword( "WATER" ) );
+}
+
+BOOST_AUTO_TEST_CASE(ParseFileNoTrailingNewline) {
+    Parser parser;
+    auto deck = parser.parseFile( prefix() + "parser/noTrailingNewline.data", ParseContext() );
+
+    BOOST_CHECK_EQUAL( 3U, deck.size() );
+    BOOST_CHECK( deck.hasKeyword( "OIL" ) );
+    BOOST_CHECK_EQUAL( 20, deck.getKeyword( "DIMENS" ).getRecord( 0 ).getItem( 1 ).get< int >( 0 ) );
+}
+
+namespace {
+
+void check_same_deck( const Deck& lhs, const Deck& rhs ) {
+    BOOST_REQUIRE_EQUAL( lhs.size(), rhs.size() );
+    for( size_t k = 0; k < lhs.size(); ++k ) {
+        const auto& kw1 = lhs.getKeyword( k );
+        const auto& kw2 = rhs.getKeyword( k );
+        BOOST_CHECK_EQUAL( kw1.name(), kw2.name() );
+        BOOST_CHECK_EQUAL( kw1.getLineNumber(), kw2.getLineNumber() );
+        BOOST_REQUIRE_EQUAL( kw1.size(), kw2.size() );
+
+        for( size_t r = 0; r < kw1.size(); ++r ) {
+            const auto& rec1 = kw1.getRecord( r );
+            const auto& rec2 = kw2.getRecord( r );
+            BOOST_REQUIRE_EQUAL( rec1.size(), rec2.size() );
+
+            for( size_t i = 0; i < rec1.size(); ++i ) {
+                const auto& it1 = rec1.getItem( i );
+                const auto& it2 = rec2.getItem( i );
+                BOOST_REQUIRE_EQUAL( it1.size(), it2.size() );
+                for( size_t j = 0; j < it1.size(); ++j )
+                    BOOST_CHECK_EQUAL( it1.defaultApplied( j ), it2.defaultApplied( j ) );
+
+                switch( it1.getType() ) {
+                    case type_tag::integer:
+                        BOOST_CHECK( it1.getData< int >() == it2.getData< int >() );
+                        break;
+                    case type_tag::fdouble:
+                        BOOST_CHECK( it1.getData< double >() == it2.getData< double >() );
+                        break;
+                    case type_tag::string:
+                        BOOST_CHECK( it1.getData< std::string >() == it2.getData< std::string >() );
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_EQUAL( lhs.getMessageContainer().size(), rhs.getMessageContainer().size() );
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(ParseThreadedSameAsSerial) {
+    std::string deckString = "RUNSPEC\nDIMENS\n 10 10 2 /\nTABDIMS\n 2 /\nGRID\n";
+    for( int i = 0; i < 50; ++i ) {
+        deckString += "PERMX\n 100*0.25 3*7.5 97*1e2 /\n";
+        deckString += "PORO\n 200*0.3 /\n";
+        deckString += "NOTAKEYWORD\n";
+    }
+
+    deckString += "PROPS\nSWOF\n 0.1 0 1 0\n 0.9 1 0 0 /\n 0.2 0 1 0\n 1.0 1 0 0 /\n";
+    deckString += "SCHEDULE\n";
+    for( int i = 0; i < 100; ++i )
+        deckString += "WELSPECS\n 'W" + std::to_string( i ) + "' 'G' 1 1 1* 'OIL' /\n/\n";
+
+    const ParseContext context( { { ParseContext::PARSE_RANDOM_TEXT, InputError::WARN } } );
+
+    Parser parser;
+    const auto serial = parser.parseString( deckString, context );
+
+    parser.setThreadCount( 4 );
+    BOOST_CHECK_EQUAL( 4U, parser.getThreadCount() );
+    const auto threaded = parser.parseString( deckString, context );
+
+    check_same_deck( serial, threaded );
+}
+
+BOOST_AUTO_TEST_CASE(ParseThreadedRethrows) {
+    Parser parser;
+    parser.setThreadCount( 3 );
+
+    std::string deckString = "RUNSPEC\n";
+    for( int i = 0; i < 20; ++i ) deckString += "DIMENS\n 10 10 1 /\n";
+    deckString += "DIMENS\n 10 10 X /\n";
+    for( int i = 0; i < 20; ++i ) deckString += "DIMENS\n 10 10 1 /\n";
+
+    BOOST_CHECK_THROW( parser.parseString( deckString, ParseContext() ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(ParseThreadedHugeDataKeyword) {
+    std::string poro;
+    for( int i = 0; i < 200000; ++i ) {
+        switch( i % 4 ) {
+            case 0: poro += " 0.25"; break;
+            case 1: poro += " 3*"; break;
+            case 2: poro += " 2*0.5"; break;
+            case 3: poro += " 1e-3\n"; break;
+        }
+    }
+
+    const std::string deckString = "GRID\nPORO\n" + poro + " /\n";
+
+    Parser parser;
+    const auto serial = parser.parseString( deckString, ParseContext() );
+
+    parser.setThreadCount( 4 );
+    const auto threaded = parser.parseString( deckString, ParseContext() );
+
+    check_same_deck( serial, threaded );
+
+    const auto& item = threaded.getKeyword( "PORO" ).getDataRecord().getDataItem();
+    BOOST_CHECK_EQUAL( 350000U, item.size() );
+    BOOST_CHECK( !item.defaultApplied( 0 ) );
+    BOOST_CHECK( item.defaultApplied( 1 ) );
+    BOOST_CHECK( item.defaultApplied( 3 ) );
+    BOOST_CHECK( !item.defaultApplied( 4 ) );
+    BOOST_CHECK_EQUAL( 1e-3, item.get< double >( 349999 ) );
+
+    BOOST_CHECK_THROW( parser.parseString( "GRID\nPORO\n" + poro + " X " + poro + " /\n",
+                                           ParseContext() ),
+                       std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(ParseThreadedIncludes) {
+    ParseContext parseContext;
+    parseContext.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::THROW_EXCEPTION );
+
+    Parser serial;
+    Parser threaded;
+    threaded.setThreadCount( 4 );
+
+    for( const auto* file : { "parser/includeValid.data",
+                              "parser/PATHSInInclude.data",
+                              "parser/PATHSWithBackslashes.data" } ) {
+        const auto expected = serial.parseFile( prefix() + file, parseContext );
+        const auto deck = threaded.parseFile( prefix() + file, parseContext );
+        check_same_deck( expected, deck );
+        BOOST_CHECK_EQUAL( expected.getMessageContainer().size(),
+                           deck.getMessageContainer().size() );
+    }
+
+    BOOST_CHECK_THROW( threaded.parseFile( prefix() + "parser/includeInvalid.data", parseContext ),
+                       std::invalid_argument );
+    BOOST_CHECK_THROW( threaded.parseFile( prefix() + "parser/PATHSInIncludeInvalid.data", ParseContext() ),
+                       std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(ParseThreadedAbandonedIncludes) {
+    ParseContext parseContext;
+    parseContext.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::THROW_EXCEPTION );
+
+    const auto dir = boost::filesystem::temp_directory_path()
+                   / boost::filesystem::unique_path( "opm-prefetch-%%%%-%%%%" );
+    boost::filesystem::create_directories( dir );
+
+    /*
+     * The includes after ENDINC are found ahead of time, but never loaded.
+     * They fill more than the prefetch window, and must not keep the
+     * includes that follow from being read.
+     */
+    {
+        std::ofstream skip( ( dir / "skip.inc" ).string() );
+        skip << "ENDINC\n";
+        for( int i = 0; i < 16; ++i )
+            skip << "INCLUDE\n 'missing" << i << ".inc' /\n";
+
+        std::ofstream data( ( dir / "CASE.DATA" ).string() );
+        data << "RUNSPEC\nDIMENS\n 10 10 1 /\nGRID\nINCLUDE\n 'skip.inc' /\n";
+        for( int i = 0; i < 16; ++i ) {
+            const auto name = "poro" + std::to_string( i ) + ".inc";
+            data << "INCLUDE\n '" << name << "' /\n";
+
+            std::ofstream poro( ( dir / name ).string() );
+            poro << "PORO\n 100*0." << i << " /\n";
+        }
+    }
+
+    Parser serial;
+    Parser threaded;
+    threaded.setThreadCount( 2 );
+
+    const auto file = ( dir / "CASE.DATA" ).string();
+    const auto expected = serial.parseFile( file, parseContext );
+    const auto deck = threaded.parseFile( file, parseContext );
+    check_same_deck( expected, deck );
+    BOOST_CHECK_EQUAL( 16U, deck.count( "PORO" ) );
+
+    boost::filesystem::remove_all( dir );
+}
+
+BOOST_AUTO_TEST_CASE(ParseFileVisitor) {
+    ParseContext parseContext;
+    parseContext.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::THROW_EXCEPTION );
+
+    Parser parser;
+    for( size_t threads : { 1, 4 } ) {
+        parser.setThreadCount( threads );
+
+        for( const auto* file : { "integration_tests/IOConfig/SPE1CASE2.DATA",
+                                  "integration_tests/TABLES/PVTX1.DATA",
+                                  "parser/PATHSInInclude.data" } ) {
+            const auto expected = parser.parseFile( prefix() + file, parseContext );
+
+            Deck visited;
+            const auto messages = parser.parseFile( prefix() + file, parseContext,
+                [&visited]( const DeckKeyword& kw ) { visited.addKeyword( kw ); } );
+
+            check_same_deck( expected, visited );
+            BOOST_CHECK_EQUAL( expected.getMessageContainer().size(), messages.size() );
+        }
+    }
+
+    /* SPE1CASE2 is in field units, which must be applied to the visited keywords */
+    std::vector< double > permx;
+    parser.parseFile( prefix() + "integration_tests/IOConfig/SPE1CASE2.DATA", parseContext,
+        [&permx]( const DeckKeyword& kw ) {
+            if( kw.name() == "PERMX" ) permx = kw.getSIDoubleData();
+        } );
+
+    const auto deck = parser.parseFile( prefix() + "integration_tests/IOConfig/SPE1CASE2.DATA" );
+    BOOST_CHECK( !permx.empty() );
+    BOOST_CHECK( permx == deck.getKeyword( "PERMX" ).getSIDoubleData() );
+
+    BOOST_CHECK_THROW( parser.parseFile( prefix() + "parser/includeInvalid.data", parseContext,
+                                         []( const DeckKeyword& ) {} ),
+                       std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(ParseLazySameAsEager) {
+    ParseContext parseContext;
+    parseContext.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::THROW_EXCEPTION );
+
+    Parser parser;
+    Parser lazy;
+    lazy.setLazy( true );
+    BOOST_CHECK( lazy.isLazy() );
+
+    for( size_t threads : { 1, 4 } ) {
+        lazy.setThreadCount( threads );
+
+        for( const auto* file : { "integration_tests/IOConfig/SPE1CASE2.DATA",
+                                  "integration_tests/TABLES/PVTX1.DATA",
+                                  "parser/PATHSInInclude.data" } ) {
+            const auto expected = parser.parseFile( prefix() + file, parseContext );
+            const auto deck = lazy.parseFile( prefix() + file, parseContext );
+
+            check_same_deck( expected, deck );
+        }
+    }
+
+    /* units are applied when the keyword is parsed */
+    const auto deck = lazy.parseFile( prefix() + "integration_tests/IOConfig/SPE1CASE2.DATA" );
+    BOOST_CHECK( deck.getKeyword( "PERMX" ).isLazy() );
+    BOOST_CHECK( !deck.getKeyword( "TABDIMS" ).isLazy() );
+    BOOST_CHECK( deck.getKeyword( "PERMX" ).getSIDoubleData()
+              == parser.parseFile( prefix() + "integration_tests/IOConfig/SPE1CASE2.DATA" )
+                       .getKeyword( "PERMX" ).getSIDoubleData() );
+
+    /* errors show up when the keyword is accessed */
+    Deck broken;
+    BOOST_CHECK_NO_THROW( broken = lazy.parseString( "GRID\nPORO\n 0.25 X /\n", ParseContext() ) );
+    BOOST_CHECK( broken.getKeyword( "PORO" ).isLazy() );
+    BOOST_CHECK_THROW( broken.getKeyword( "PORO" ).getDataRecord(), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(ParseLazyOutlivesParser) {
+    std::unique_ptr< Parser > parser( new Parser );
+    parser->addParserKeyword( Json::JsonObject( "{\"name\" : \"MYKW\", \"sections\" : [], \"size\" : 1, "
+                                                "\"items\" : [{\"name\" : \"X\", \"value_type\" : \"INT\"}]}" ) );
+    parser->setLazy( true );
+
+    const auto deck = parser->parseString( "MYKW\n 42 /\n", ParseContext() );
+    BOOST_CHECK( deck.getKeyword( "MYKW" ).isLazy() );
+
+    /* the added keyword is still needed to parse the lazy keyword */
+    parser.reset();
+    BOOST_CHECK_EQUAL( 42, deck.getKeyword( "MYKW" ).getRecord( 0 ).getItem( "X" ).get< int >( 0 ) );
+}
+
+namespace {
+
+size_t check_same_si( const Deck& lhs, const Deck& rhs ) {
+    BOOST_CHECK( lhs.getActiveUnitSystem().getType() == rhs.getActiveUnitSystem().getType() );
+    BOOST_REQUIRE_EQUAL( lhs.size(), rhs.size() );
+
+    size_t converted = 0;
+    for( size_t k = 0; k < lhs.size(); ++k ) {
+        const auto& kw1 = lhs.getKeyword( k );
+        const auto& kw2 = rhs.getKeyword( k );
+        BOOST_REQUIRE_EQUAL( kw1.size(), kw2.size() );
+
+        for( size_t r = 0; r < kw1.size(); ++r ) {
+            for( size_t i = 0; i < kw1.getRecord( r ).size(); ++i ) {
+                const auto& it1 = kw1.getRecord( r ).getItem( i );
+                const auto& it2 = kw2.getRecord( r ).getItem( i );
+                if( it1.getType() != type_tag::fdouble ) continue;
+
+                BOOST_REQUIRE_EQUAL( it1.size(), it2.size() );
+                BOOST_CHECK( it1.getDimensions() == it2.getDimensions() );
+                if( !it2.storesSI() ) {
+                    BOOST_CHECK( it1.getData< double >() == it2.getData< double >() );
+                    continue;
+                }
+
+                ++converted;
+                BOOST_CHECK( it1.getSIDoubleData() == it2.getSIDoubleData() );
+                for( size_t j = 0; j < it1.size(); ++j ) {
+                    BOOST_CHECK_EQUAL( it1.defaultApplied( j ), it2.defaultApplied( j ) );
+                    BOOST_CHECK_CLOSE( it1.get< double >( j ), it2.get< double >( j ), 1e-10 );
+                }
+            }
+        }
+    }
+
+    return converted;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(ParseSIStorageSameAsRaw) {
+    ParseContext parseContext;
+    parseContext.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::THROW_EXCEPTION );
+
+    Parser parser;
+    Parser si;
+    BOOST_CHECK( !si.isSIStorage() );
+    si.setSIStorage( true );
+    BOOST_CHECK( si.isSIStorage() );
+
+    for( bool lazy : { false, true } ) {
+        si.setLazy( lazy );
+
+        for( size_t threads : { 1, 4 } ) {
+            si.setThreadCount( threads );
+
+            for( const auto* file : { "integration_tests/IOConfig/SPE1CASE2.DATA",
+                                      "integration_tests/TABLES/PVTX1.DATA" } ) {
+                const auto expected = parser.parseFile( prefix() + file, parseContext );
+                const auto deck = si.parseFile( prefix() + file, parseContext );
+
+                BOOST_CHECK( check_same_si( expected, deck ) > 0 );
+            }
+        }
+    }
+
+    /* SPE1CASE2 is in field units, which are picked up from RUNSPEC */
+    si.setLazy( false );
+    const auto deck = si.parseFile( prefix() + "integration_tests/IOConfig/SPE1CASE2.DATA" );
+    const auto& permx = deck.getKeyword( "PERMX" ).getDataRecord().getDataItem();
+    BOOST_CHECK( permx.storesSI() );
+    BOOST_CHECK_CLOSE( permx.get< double >( 0 ) * 9.869233e-16, permx.getSIDouble( 0 ), 1e-4 );
+
+    /* the visited keywords are in SI as well */
+    std::vector< double > visited;
+    si.parseFile( prefix() + "integration_tests/IOConfig/SPE1CASE2.DATA", parseContext,
+        [&visited]( const DeckKeyword& kw ) {
+            if( kw.name() == "PERMX" ) visited = kw.getSIDoubleData();
+        } );
+    BOOST_CHECK( visited == deck.getKeyword( "PERMX" ).getSIDoubleData() );
+    BOOST_CHECK( visited == parser.parseFile( prefix() + "integration_tests/IOConfig/SPE1CASE2.DATA" )
+                                  .getKeyword( "PERMX" ).getSIDoubleData() );
+}
+
+BOOST_AUTO_TEST_CASE(ParseCachedSameAsParsed) {
+    ParseContext parseContext;
+    parseContext.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::THROW_EXCEPTION );
+
+    const auto cacheDir = boost::filesystem::temp_directory_path()
+                        / boost::filesystem::unique_path( "opm-deck-cache-%%%%-%%%%" );
+
+    Parser parser;
+    Parser cached;
+    cached.setCacheDirectory( cacheDir.string() );
+    BOOST_CHECK_EQUAL( cacheDir.string(), cached.getCacheDirectory() );
+
+    for( const auto* file : { "integration_tests/IOConfig/SPE1CASE2.DATA",
+                              "parser/PATHSInInclude.data" } ) {
+        const auto expected = parser.parseFile( prefix() + file, parseContext );
+        const auto stored = cached.parseFile( prefix() + file, parseContext );
+        const auto loaded = cached.parseFile( prefix() + file, parseContext );
+
+        check_same_deck( expected, stored );
+        check_same_deck( expected, loaded );
+        BOOST_CHECK_EQUAL( expected.getDataFile(), loaded.getDataFile() );
+        BOOST_CHECK( expected.getActiveUnitSystem().getType() == loaded.getActiveUnitSystem().getType() );
+    }
+
+    const auto loaded = cached.parseFile( prefix() + "integration_tests/IOConfig/SPE1CASE2.DATA" );
+    const auto& permx = loaded.getKeyword( "PERMX" );
+    BOOST_CHECK_EQUAL( "PERMX", permx.name() );
+    BOOST_CHECK( permx.getFileName() == parser.parseFile( prefix() + "integration_tests/IOConfig/SPE1CASE2.DATA" )
+                                              .getKeyword( "PERMX" ).getFileName() );
+    BOOST_CHECK( permx.getSIDoubleData()
+              == parser.parseFile( prefix() + "integration_tests/IOConfig/SPE1CASE2.DATA" )
+                       .getKeyword( "PERMX" ).getSIDoubleData() );
+
+    /* a changed include is noticed */
+    const auto dataDir = cacheDir / "deck";
+    boost::filesystem::create_directories( dataDir );
+    {
+        std::ofstream data( ( dataDir / "CASE.DATA" ).string() );
+        data << "RUNSPEC\nDIMENS\n 10 10 1 /\nGRID\nINCLUDE\n 'poro.inc' /\n";
+        std::ofstream poro( ( dataDir / "poro.inc" ).string() );
+        poro << "PORO\n 100*0.25 /\n";
+    }
+
+    const auto dataFile = ( dataDir / "CASE.DATA" ).string();
+    BOOST_CHECK_EQUAL( 0.25, cached.parseFile( dataFile ).getKeyword( "PORO" ).getRecord( 0 ).getItem( 0 ).get< double >( 0 ) );
+    BOOST_CHECK_EQUAL( 0.25, cached.parseFile( dataFile ).getKeyword( "PORO" ).getRecord( 0 ).getItem( 0 ).get< double >( 0 ) );
+    {
+        std::ofstream poro( ( dataDir / "poro.inc" ).string() );
+        poro << "PORO\n 100*0.75 /\n";
+    }
+    BOOST_CHECK_EQUAL( 0.75, cached.parseFile( dataFile ).getKeyword( "PORO" ).getRecord( 0 ).getItem( 0 ).get< double >( 0 ) );
+
+    /* a missing include that shows up is noticed too */
+    ParseContext ignoreMissing;
+    ignoreMissing.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::IGNORE );
+    boost::filesystem::remove( dataDir / "poro.inc" );
+    BOOST_CHECK( !cached.parseFile( dataFile, ignoreMissing ).hasKeyword( "PORO" ) );
+    BOOST_CHECK( !cached.parseFile( dataFile, ignoreMissing ).hasKeyword( "PORO" ) );
+    {
+        std::ofstream poro( ( dataDir / "poro.inc" ).string() );
+        poro << "PORO\n 100*0.5 /\n";
+    }
+    BOOST_CHECK( cached.parseFile( dataFile, ignoreMissing ).hasKeyword( "PORO" ) );
+
+    /* and a corrupt entry is just a miss */
+    {
+        boost::filesystem::directory_iterator end;
+        for( boost::filesystem::directory_iterator itr( cacheDir ); itr != end; ++itr ) {
+            if( itr->path().extension() != ".deck" ) continue;
+            std::ofstream entry( itr->path().string(), std::ios::binary | std::ios::trunc );
+            entry << "OPMDECK";
+        }
+    }
+    BOOST_CHECK_EQUAL( 0.5, cached.parseFile( dataFile ).getKeyword( "PORO" ).getRecord( 0 ).getItem( 0 ).get< double >( 0 ) );
+
+    /* a keyword replaced by one with the same deck name and other items misses */
+    {
+        std::ofstream poro( ( dataDir / "poro.inc" ).string() );
+        poro << "PORO\n 100*2 /\n";
+    }
+    BOOST_CHECK( type_tag::fdouble == cached.parseFile( dataFile ).getKeyword( "PORO" ).getRecord( 0 ).getItem( 0 ).getType() );
+
+    Parser replaced;
+    replaced.setCacheDirectory( cacheDir.string() );
+    replaced.addParserKeyword( Json::JsonObject( "{\"name\" : \"PORO\", \"sections\" : [\"GRID\"], \"data\" : {\"value_type\" : \"INT\"}}" ) );
+    for( int i = 0; i < 2; ++i ) {
+        const auto deck = replaced.parseFile( dataFile );
+        const auto& item = deck.getKeyword( "PORO" ).getRecord( 0 ).getItem( 0 );
+        BOOST_CHECK( type_tag::integer == item.getType() );
+        BOOST_CHECK_EQUAL( 2, item.get< int >( 99 ) );
+    }
+    BOOST_CHECK( type_tag::fdouble == cached.parseFile( dataFile ).getKeyword( "PORO" ).getRecord( 0 ).getItem( 0 ).getType() );
+
+    boost::filesystem::remove_all( cacheDir );
+}
+
+namespace {
+
+void write_be32( std::ostream& out, uint32_t x ) {
+    const char bytes[] = { char( x >> 24 ), char( x >> 16 ), char( x >> 8 ), char( x ) };
+    out.write( bytes, 4 );
+}
+
+/* an Eclipse unformatted array, with the values split over records of two */
+void write_ecl_array( std::ostream& out, const std::string& name, const std::string& type,
+                      const std::vector< uint32_t >& words ) {
+    write_be32( out, 16 );
+    out << std::string( name + "        " ).substr( 0, 8 );
+    write_be32( out, words.size() );
+    out << type;
+    write_be32( out, 16 );
+
+    for( size_t i = 0; i < words.size(); i += 2 ) {
+        const auto n = std::min< size_t >( 2, words.size() - i );
+        write_be32( out, 4 * n );
+        for( size_t j = i; j < i + n; ++j ) write_be32( out, words[ j ] );
+        write_be32( out, 4 * n );
+    }
+}
+
+uint32_t float_bits( float x ) {
+    uint32_t w;
+    std::memcpy( &w, &x, sizeof( w ) );
+    return w;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(ParseProfiled) {
+    const std::string input = "RUNSPEC\nDIMENS\n 2 2 1 /\nGRID\n"
+                              "PORO\n 4*0.25 /\n"
+                              "PERMX\n 1 2 3 4 /\n"
+                              "PERMY\n 4*100 /\n"
+                              "PERMZ\n 4*10 /\n";
+
+    Parser parser;
+    BOOST_CHECK( !parser.isProfiling() );
+    BOOST_CHECK( !parser.parseString( input ).getParseProfile() );
+
+    parser.setProfiling( true );
+    for( size_t threads : { 1, 4 } ) {
+        parser.setThreadCount( threads );
+        const auto deck = parser.parseString( input );
+        const auto* profile = deck.getParseProfile();
+        BOOST_REQUIRE( profile );
+
+        const auto& keywords = profile->getKeywords();
+        BOOST_CHECK_EQUAL( 7U, keywords.size() );
+        BOOST_CHECK_EQUAL( 1U, keywords.at( "DIMENS" ).records );
+        BOOST_CHECK_EQUAL( 3U, keywords.at( "DIMENS" ).items );
+        BOOST_CHECK_EQUAL( 1U, keywords.at( "PERMX" ).keywords );
+        BOOST_CHECK( keywords.at( "PERMX" ).bytes >= std::string( "1 2 3 4" ).size() );
+        BOOST_CHECK( keywords.at( "PERMX" ).seconds >= keywords.at( "PERMX" ).recordSeconds );
+        BOOST_CHECK( keywords.at( "PERMX" ).unitSeconds > 0 );
+        BOOST_CHECK_EQUAL( 0, keywords.at( "DIMENS" ).unitSeconds );
+
+        BOOST_CHECK_EQUAL( 1U, profile->getFiles().size() );
+        BOOST_CHECK_EQUAL( 7U, profile->getFiles().begin()->second.keywords );
+        BOOST_CHECK( profile->getTotalSeconds() >= profile->getUnitSeconds() );
+
+        const auto top = profile->topKeywords( 3 );
+        BOOST_CHECK_EQUAL( 3U, top.size() );
+        BOOST_CHECK( top[ 0 ].totalSeconds() >= top[ 1 ].totalSeconds() );
+        BOOST_CHECK( top[ 1 ].totalSeconds() >= top[ 2 ].totalSeconds() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ParseConcurrentlyWithSharedParser) {
+    std::string input = "RUNSPEC\nDIMENS\n 10 10 2 /\nFIELD\nGRID\n";
+    for( const auto& kw : { "PORO", "PERMX", "PERMY", "PERMZ" } ) {
+        input += std::string( kw ) + "\n";
+        for( int i = 0; i < 200; ++i ) input += std::to_string( i % 7 + 1 ) + " ";
+        input += "/\n";
+    }
+    input += "NTG\n 200*1 /\nSATNUM\n 100*1 100*2 /\n";
+    const auto file = prefix() + "parser/includeValid.data";
+
+    Parser eager;
+    Parser lazy;
+    lazy.setLazy( true );
+    lazy.setProfiling( true );
+    lazy.setThreadCount( 2 );
+
+    const Parser& shared = eager;
+    const auto expected = dump( shared.parseString( input ) );
+    const auto expectedFile = dump( shared.parseFile( file ) );
+
+    /* a deck shared between the threads as well */
+    const auto sharedDeck = lazy.parseString( input );
+
+    std::vector< std::string > failures;
+    std::mutex mutex;
+    std::vector< std::thread > threads;
+    for( int t = 0; t < 8; ++t ) {
+        threads.emplace_back( [&, t] {
+            const Parser& parser = t % 2 ? lazy : eager;
+            for( int i = 0; i < 10; ++i ) {
+                std::string error;
+                if( dump( parser.parseString( input ) ) != expected )
+                    error = "parseString";
+                else if( dump( parser.parseFile( file ) ) != expectedFile )
+                    error = "parseFile";
+                else if( dump( sharedDeck ) != expected )
+                    error = "shared deck";
+
+                if( error.empty() ) continue;
+
+                std::lock_guard< std::mutex > lock( mutex );
+                failures.push_back( error );
+            }
+        } );
+    }
+
+    for( auto& thread : threads ) thread.join();
+
+    BOOST_CHECK( failures.empty() );
+    for( const auto& failure : failures )
+        BOOST_TEST_MESSAGE( "Concurrent parse differs: " << failure );
+}
+
+BOOST_AUTO_TEST_CASE(ParseImport) {
+    const auto dir = boost::filesystem::temp_directory_path()
+                   / boost::filesystem::unique_path( "opm-import-%%%%-%%%%" );
+    boost::filesystem::create_directories( dir );
+
+    {
+        std::ofstream grid( ( dir / "GRID.BIN" ).string(), std::ios::binary );
+        write_ecl_array( grid, "PORO", "REAL", { float_bits( 0.25 ), float_bits( 0.5 ),
+                                                 float_bits( 0.75 ), float_bits( 1 ) } );
+        write_ecl_array( grid, "FILEHEAD", "INTE", { 1, 2 } );
+        /* a keyword that is not a data keyword is skipped */
+        write_be32( grid, 16 );
+        grid << "MAPUNITS";
+        write_be32( grid, 1 );
+        grid << "CHAR";
+        write_be32( grid, 16 );
+        write_be32( grid, 8 );
+        grid << "METRES  ";
+        write_be32( grid, 8 );
+        write_ecl_array( grid, "SATNUM", "INTE", { 1, 2, 3, 4 } );
+
+        /* the native format is little endian, and the test assumes the host is too */
+        std::ofstream raw( ( dir / "PERMX.RAW" ).string(), std::ios::binary );
+        const double permx[] = { 100, 200, 300, 400 };
+        const uint32_t reserved = 0;
+        const uint64_t count = 4;
+        raw << "OPMARRAYPERMX   DOUB";
+        raw.write( reinterpret_cast< const char* >( &reserved ), sizeof( reserved ) );
+        raw.write( reinterpret_cast< const char* >( &count ), sizeof( count ) );
+        raw.write( reinterpret_cast< const char* >( permx ), sizeof( permx ) );
+
+        std::ofstream data( ( dir / "CASE.DATA" ).string() );
+        data << "RUNSPEC\nDIMENS\n 2 2 1 /\nGRID\n"
+             << "IMPORT\n 'GRID.BIN' /\n"
+             << "IMPORT\n 'PERMX.RAW' 'RAW' /\n"
+             << "REGIONS\n";
+
+        std::ofstream broken( ( dir / "BROKEN.DATA" ).string() );
+        broken << "GRID\nIMPORT\n 'CASE.DATA' /\n";
+    }
+
+    ParseContext parseContext;
+    parseContext.update( ParseContext::PARSE_UNKNOWN_KEYWORD, InputError::IGNORE );
+
+    Parser parser;
+    const auto deck = parser.parseFile( ( dir / "CASE.DATA" ).string(), parseContext );
+
+    BOOST_CHECK( !deck.hasKeyword( "IMPORT" ) );
+    BOOST_CHECK( !deck.hasKeyword( "FILEHEAD" ) );
+    BOOST_CHECK( !deck.hasKeyword( "MAPUNITS" ) );
+    BOOST_CHECK_EQUAL( 7U, deck.size() );
+    BOOST_CHECK_EQUAL( "PORO", deck.getKeyword( 3 ).name() );
+    BOOST_CHECK_EQUAL( "SATNUM", deck.getKeyword( 4 ).name() );
+    BOOST_CHECK_EQUAL( "PERMX", deck.getKeyword( 5 ).name() );
+
+    const auto& poro = deck.getKeyword( "PORO" );
+    BOOST_CHECK( poro.isDataKeyword() );
+    BOOST_CHECK_EQUAL( 5U, poro.getLineNumber() );
+    BOOST_CHECK_EQUAL( 0.75, poro.getSIDoubleData()[ 2 ] );
+
+    const std::vector< int > satnum = { 1, 2, 3, 4 };
+    const auto& data = deck.getKeyword( "SATNUM" ).getIntData();
+    BOOST_CHECK_EQUAL_COLLECTIONS( satnum.begin(), satnum.end(), data.begin(), data.end() );
+
+    const auto& permx = deck.getKeyword( "PERMX" );
+    BOOST_CHECK_EQUAL( 400, permx.getRawDoubleData()[ 3 ] );
+    BOOST_CHECK_CLOSE( 400 * 9.869233e-16, permx.getSIDoubleData()[ 3 ], 1e-4 );
+
+    BOOST_CHECK_THROW( parser.parseFile( ( dir / "BROKEN.DATA" ).string(), parseContext ),
+                       std::invalid_argument );
+
+    boost::filesystem::remove_all( dir );
+}
+
+BOOST_AUTO_TEST_CASE(ParseImportSIStorage) {
+    const auto dir = boost::filesystem::temp_directory_path()
+                   / boost::filesystem::unique_path( "opm-import-%%%%-%%%%" );
+    boost::filesystem::create_directories( dir );
+
+    {
+        std::ofstream raw( ( dir / "PERMX.RAW" ).string(), std::ios::binary );
+        const double permx[] = { 100, 200, 300, 400 };
+        const uint32_t reserved = 0;
+        const uint64_t count = 4;
+        raw << "OPMARRAYPERMX   DOUB";
+        raw.write( reinterpret_cast< const char* >( &reserved ), sizeof( reserved ) );
+        raw.write( reinterpret_cast< const char* >( &count ), sizeof( count ) );
+        raw.write( reinterpret_cast< const char* >( permx ), sizeof( permx ) );
+
+        std::ofstream data( ( dir / "CASE.DATA" ).string() );
+        data << "RUNSPEC\nFIELD\nDIMENS\n 2 2 1 /\nGRID\n"
+             << "IMPORT\n 'PERMX.RAW' 'RAW' /\n";
+    }
+
+    const auto file = ( dir / "CASE.DATA" ).string();
+
+    Parser parser;
+    Parser si;
+    si.setSIStorage( true );
+
+    const auto expected = parser.parseFile( file ).getKeyword( "PERMX" ).getSIDoubleData();
+    const auto deck = si.parseFile( file );
+    const auto& permx = deck.getKeyword( "PERMX" ).getDataRecord().getDataItem();
+    BOOST_CHECK( permx.storesSI() );
+    BOOST_CHECK_EQUAL( 400, permx.get< double >( 3 ) );
+    BOOST_CHECK( permx.getSIDoubleData() == expected );
+
+    std::vector< double > visited;
+    si.parseFile( file, ParseContext(),
+        [&visited]( const DeckKeyword& kw ) {
+            if( kw.name() == "PERMX" ) visited = kw.getSIDoubleData();
+        } );
+    BOOST_CHECK( visited == expected );
+
+    boost::filesystem::remove_all( dir );
+}
+
 BOOST_AUTO_TEST_CASE(ScalarCheck) {
     ParserItem item1("ITEM1", ParserItem::item_size::SINGLE );
     ParserItem item2("ITEM1", ParserItem::item_size::ALL );
@@ -1250,6 +2132,67 @@ BOOST_AUTO_TEST_CASE(Parse_RawRecordTooFewItems) {
 }
 
 
+BOOST_AUTO_TEST_CASE(ParseRecordWithGeneratedScanner) {
+    Parser generated;
+    const auto& compdat = *generated.getKeyword( "COMPDAT" );
+    BOOST_CHECK( compdat.getRecord( 0 ).hasScanner() );
+    BOOST_CHECK( !generated.getKeyword( "PORO" )->getRecord( 0 ).hasScanner() );
+
+    auto extended = compdat.getRecord( 0 );
+    extended.addItem( ParserItem( "EXTRA", SINGLE, 0 ) );
+    BOOST_CHECK( !extended.hasScanner() );
+
+    std::unique_ptr< ParserKeyword > plain( new ParserKeyword( compdat ) );
+    plain->getRecord( 0 ).setScanner( nullptr );
+    Parser generic( false );
+    generic.addParserKeyword( std::move( plain ) );
+
+    const auto input = "COMPDAT\n"
+                       " 'W1' 2 2 1 3 'OPEN' 1* 2.5 /\n"
+                       " 'W2' 3* 2 'SHUT' 2* 0.3 3* 'X' /\n"
+                       " 'W3' 1 1 1 1 3*5 /\n"
+                       "/\n";
+
+    const auto deck1 = generated.parseString( input );
+    const auto deck2 = generic.parseString( input );
+    BOOST_CHECK_EQUAL( dump( deck1 ), dump( deck2 ) );
+
+    const auto& kw1 = deck1.getKeyword( "COMPDAT" );
+    const auto& kw2 = deck2.getKeyword( "COMPDAT" );
+    BOOST_CHECK_EQUAL( 3U, kw1.size() );
+    for( size_t r = 0; r < kw1.size(); ++r ) {
+        const auto& rec1 = kw1.getRecord( r );
+        const auto& rec2 = kw2.getRecord( r );
+        BOOST_CHECK_EQUAL( rec1.size(), rec2.size() );
+        for( size_t i = 0; i < rec1.size(); ++i ) {
+            BOOST_CHECK_EQUAL( rec1.getItem( i ).name(), rec2.getItem( i ).name() );
+            BOOST_CHECK_EQUAL( rec1.getItem( i ).defaultApplied( 0 ),
+                               rec2.getItem( i ).defaultApplied( 0 ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TypedItemLookup) {
+    using ParserKeywords::COMPDAT;
+
+    BOOST_CHECK_EQUAL( 0U, COMPDAT::WELL::itemIndex );
+    BOOST_CHECK_EQUAL( 5U, COMPDAT::STATE::itemIndex );
+
+    const auto deck = Parser().parseString( "COMPDAT\n 'W1' 2 2 1 3 'SHUT' /\n/\n" );
+    const auto& record = deck.getKeyword( "COMPDAT" ).getRecord( 0 );
+    BOOST_CHECK_EQUAL( &record.getItem( "STATE" ), &record.getItem< COMPDAT::STATE >() );
+    BOOST_CHECK_EQUAL( "SHUT", record.getItem< COMPDAT::STATE >().get< std::string >( 0 ) );
+    BOOST_CHECK_EQUAL( "Z", record.getItem< COMPDAT::DIR >().get< std::string >( 0 ) );
+
+    /* a record that does not follow the keyword definition is searched */
+    DeckRecord reordered;
+    reordered.addItem( DeckItem( "STATE", std::string() ) );
+    reordered.addItem( DeckItem( "WELL", std::string() ) );
+    BOOST_CHECK_EQUAL( &reordered.getItem( 0 ), &reordered.getItem< COMPDAT::STATE >() );
+    BOOST_CHECK_EQUAL( &reordered.getItem( 1 ), &reordered.getItem< COMPDAT::WELL >() );
+    BOOST_CHECK_THROW( reordered.getItem< COMPDAT::DIR >(), std::invalid_argument );
+}
+
 
 BOOST_AUTO_TEST_CASE(ParseRecordHasDimensionCorrect) {
     ParserRecord parserRecord;
@@ -19,9 +19,14 @@
 
 #define BOOST_TEST_MODULE RawKeywordTests
 #include <cstring>
+#include <random>
+#include <string>
+#include <vector>
 #include <stdexcept>
 #include <boost/test/unit_test.hpp>
 
+#include <opm/parser/eclipse/RawDeck/Lexer.hpp>
+#include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 #include <opm/parser/eclipse/RawDeck/RawEnums.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
@@ -263,3 +268,131 @@ BOOST_AUTO_TEST_CASE(Rawrecord_FileAndKeywordGiven_CorrectStringsReturned) {
     BOOST_CHECK_EQUAL(keywordName, record.getKeywordName());
     BOOST_CHECK_EQUAL(fileName, record.getFileName());
 }
+
+BOOST_AUTO_TEST_CASE(Rawrecord_PrependReusesPoppedItems) {
+    Opm::RawRecord record("3* 1 2");
+    record.pop_front();
+    record.prepend( 1, "1*" );
+    BOOST_CHECK_EQUAL( 3U, record.size() );
+    BOOST_CHECK_EQUAL( "1*", record.getItem( 0 ) );
+
+    record.pop_front();
+    record.prepend( 3, "X" );
+    BOOST_CHECK_EQUAL( 5U, record.size() );
+    BOOST_CHECK_EQUAL( "X", record.getItem( 2 ) );
+    BOOST_CHECK_EQUAL( "1", record.getItem( 3 ) );
+    BOOST_CHECK_EQUAL( "2", record.getItem( 4 ) );
+
+    Opm::RawRecord copy( record );
+    record.pop_front( 4 );
+    BOOST_CHECK_EQUAL( 5U, copy.size() );
+    BOOST_CHECK_EQUAL( "1", copy.getItem( 3 ) );
+}
+
+BOOST_AUTO_TEST_CASE(RawKeyword_RecordsShareArenaAndNames) {
+    RawKeyword keyword("KEYWORD", Raw::SLASH_TERMINATED, "FILE", 10U);
+    keyword.addRawRecordString("1 2 3 /");
+    keyword.addRawRecordString("4 '5 6' /");
+    keyword.addRawRecordString("/");
+
+    const auto& first = *keyword.begin();
+    const auto& second = *( keyword.begin() + 1 );
+    BOOST_CHECK_EQUAL( first.end(), second.begin() );
+    BOOST_CHECK_EQUAL( "'5 6'", second.getItem( 1 ) );
+    BOOST_CHECK_EQUAL( &keyword.getFilename(), &first.getFileName() );
+    BOOST_CHECK_EQUAL( &keyword.getKeywordName(), &second.getKeywordName() );
+
+    RawKeyword copy( keyword );
+    keyword.begin()->pop_front( 3 );
+    BOOST_CHECK_EQUAL( 0U, keyword.begin()->size() );
+    BOOST_CHECK_EQUAL( 3U, copy.begin()->size() );
+    BOOST_CHECK_EQUAL( "FILE", copy.begin()->getFileName() );
+    BOOST_CHECK_EQUAL( &copy.getKeywordName(), &copy.begin()->getKeywordName() );
+    BOOST_CHECK_EQUAL( copy.begin()->end(), ( copy.begin() + 1 )->begin() );
+}
+
+BOOST_AUTO_TEST_CASE(RawKeyword_TokenArenaIsReused) {
+    RawKeyword keyword1("KEYWORD", Raw::SLASH_TERMINATED, "FILE", 10U);
+    keyword1.addRawRecordString("1 2 3 4 5 6 7 8 /");
+    keyword1.addRawRecordString("/");
+    const auto* tokens = keyword1.begin()->begin();
+
+    RawKeyword keyword2("KEYWORD", Raw::SLASH_TERMINATED, "FILE", 20U);
+    keyword2.setTokenArena( keyword1.releaseTokenArena() );
+    BOOST_CHECK_EQUAL( 0U, keyword1.size() );
+
+    keyword2.addRawRecordString("9 10 /");
+    keyword2.addRawRecordString("/");
+    BOOST_CHECK_EQUAL( tokens, keyword2.begin()->begin() );
+    BOOST_CHECK_EQUAL( "10", keyword2.begin()->getItem( 1 ) );
+    BOOST_CHECK_THROW( keyword2.setTokenArena( {} ), std::logic_error );
+}
+
+BOOST_AUTO_TEST_CASE(Lexer_MatchesScalarClassification) {
+    const std::string alphabet = " ,\t\r\n-/'\"ab12.*\xa0\xa7\xad\xaf";
+    std::mt19937 gen( 20 );
+    std::uniform_int_distribution< size_t > pick( 0, alphabet.size() - 1 );
+
+    const auto is_special = []( char ch ) {
+        return ch == '\n' || ch == '-' || ch == '/' || RawConsts::is_quote()( ch );
+    };
+
+    for( size_t len = 0; len < 100; ++len ) {
+        std::string str;
+        for( size_t i = 0; i < len; ++i ) str.push_back( alphabet[ pick( gen ) ] );
+
+        const auto* end = str.data() + str.size();
+        for( const auto* begin = str.data(); begin != end; ++begin ) {
+            BOOST_CHECK( lexer::find_special( begin, end )
+                      == std::find_if( begin, end, is_special ) );
+            BOOST_CHECK( lexer::find_separator( begin, end )
+                      == std::find_if( begin, end, RawConsts::is_separator() ) );
+            BOOST_CHECK( lexer::skip_separators( begin, end )
+                      == std::find_if_not( begin, end, RawConsts::is_separator() ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Lexer_CleanLines) {
+    const auto clean = []( const std::string& str ) {
+        std::string dst( str );
+        dst.resize( lexer::clean( str, &dst[ 0 ] ) - &dst[ 0 ] );
+        return dst;
+    };
+
+    const std::string padding( 40, ' ' );
+
+    BOOST_CHECK_EQUAL( "ABC", clean( "ABC --Comment" ) );
+    BOOST_CHECK_EQUAL( "ABC '--Comment1'", clean( "ABC '--Comment1' --Comment2" ) );
+    BOOST_CHECK_EQUAL( "ABC \"-- Not balanced quote?",
+                       clean( "ABC \"-- Not balanced quote?" ) );
+    BOOST_CHECK_EQUAL( "1 2 3 /", clean( " 1 2 3 / ignored -- comment" ) );
+    BOOST_CHECK_EQUAL( "'a/b' 1-2 /", clean( "'a/b' 1-2 / 'c" ) );
+    BOOST_CHECK_EQUAL( "\nA\n\nB", clean( "--\n  A  \n\t\nB" ) );
+    BOOST_CHECK_EQUAL( "A\n", clean( "A\r\n" ) );
+
+    /* features that straddle the vectorised block boundaries */
+    BOOST_CHECK_EQUAL( "1 /\nX",
+                       clean( padding + "1 / 2\n" + padding + "X" + padding ) );
+    BOOST_CHECK_EQUAL( "'" + padding + "--" + padding + "' 1",
+                       clean( padding + "'" + padding + "--" + padding + "' 1 --c" ) );
+    BOOST_CHECK_EQUAL( "'" + padding + "-\n1",
+                       clean( "'" + padding + "-\n1" + padding + "-- x" ) );
+}
+
+BOOST_AUTO_TEST_CASE(Lexer_TokenizeLongRecord) {
+    std::string record;
+    for( int i = 0; i < 100; ++i )
+        record += std::to_string( i ) + ( i % 3 ? " ," : "\t" );
+    record += " 'A B, C'  3*1.5 ";
+
+    std::vector< string_view > tokens;
+    lexer::tokenize( record, tokens );
+
+    BOOST_CHECK_EQUAL( 102U, tokens.size() );
+    for( int i = 0; i < 100; ++i )
+        BOOST_CHECK_EQUAL( std::to_string( i ), tokens[ i ] );
+
+    BOOST_CHECK_EQUAL( "'A B, C'", tokens[ 100 ] );
+    BOOST_CHECK_EQUAL( "3*1.5", tokens[ 101 ] );
+}
@@ -74,6 +74,63 @@ BOOST_AUTO_TEST_CASE(IteratorTest) {
     BOOST_CHECK_EQUAL(3, numberOfItems);
 }
 
+BOOST_AUTO_TEST_CASE(SectionKeywordLookup) {
+    Deck deck;
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+    deck.addKeyword( DeckKeyword( "RUNSPEC" ) );
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+    deck.addKeyword( DeckKeyword( "GRID" ) );
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+    deck.addKeyword( DeckKeyword( "OTHER" ) );
+
+    Section runspec( deck, "RUNSPEC" );
+    Section grid( deck, "GRID" );
+    Section schedule( deck, "SCHEDULE" );
+
+    BOOST_CHECK_EQUAL( 3U, runspec.size() );
+    BOOST_CHECK_EQUAL( 2U, runspec.count( "TEST" ) );
+    BOOST_CHECK_EQUAL( &deck.getKeyword( 2 ), &runspec.getKeyword( "TEST", 0 ) );
+    BOOST_CHECK_EQUAL( &deck.getKeyword( 3 ), &runspec.getKeyword( "TEST" ) );
+    BOOST_CHECK_THROW( runspec.getKeyword( "TEST", 2 ), std::out_of_range );
+    BOOST_CHECK_THROW( runspec.getKeyword( "OTHER" ), std::invalid_argument );
+    BOOST_CHECK( runspec.hasKeyword( deck.getKeyword( 2 ) ) );
+    BOOST_CHECK( !runspec.hasKeyword( deck.getKeyword( 0 ) ) );
+    BOOST_CHECK_EQUAL( 0U, runspec.getKeywordList( "OTHER" ).size() );
+
+    BOOST_CHECK_EQUAL( 1U, grid.count( "TEST" ) );
+    BOOST_CHECK_EQUAL( &deck.getKeyword( 5 ), &grid.getKeyword( "TEST" ) );
+    BOOST_CHECK_EQUAL( 1U, grid.getKeywordList( "OTHER" ).size() );
+
+    BOOST_CHECK_EQUAL( 0U, schedule.size() );
+    BOOST_CHECK( !schedule.hasKeyword( "TEST" ) );
+    BOOST_CHECK_EQUAL( 0U, schedule.count( "TEST" ) );
+}
+
+BOOST_AUTO_TEST_CASE(SectionOfGrownDeck) {
+    Deck deck;
+    deck.addKeyword( DeckKeyword( "RUNSPEC" ) );
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+
+    BOOST_CHECK_EQUAL( 2U, Section( deck, "RUNSPEC" ).size() );
+
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+    deck.addKeyword( DeckKeyword( "GRID" ) );
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+
+    BOOST_CHECK_EQUAL( 2U, Section( deck, "RUNSPEC" ).count( "TEST" ) );
+    BOOST_CHECK_EQUAL( 1U, Section( deck, "GRID" ).count( "TEST" ) );
+
+    Deck copy( deck );
+    copy.addKeyword( DeckKeyword( "TEST" ) );
+    copy.addKeyword( DeckKeyword( "GRID" ) );
+
+    BOOST_CHECK_EQUAL( 4U, copy.count( "TEST" ) );
+    BOOST_CHECK_EQUAL( 3U, deck.count( "TEST" ) );
+    BOOST_CHECK_NO_THROW( Section( deck, "GRID" ) );
+    BOOST_CHECK_THROW( Section( copy, "GRID" ), std::invalid_argument );
+}
+
 BOOST_AUTO_TEST_CASE(RUNSPECSection_EmptyDeck) {
     Deck deck;
     BOOST_REQUIRE_NO_THROW(RUNSPECSection section(deck));
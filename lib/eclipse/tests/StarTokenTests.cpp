@@ -18,7 +18,12 @@
  */
 
 #define BOOST_TEST_MODULE ParserTests
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
 #include <stdexcept>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <opm/parser/eclipse/RawDeck/StarToken.hpp>
 
@@ -124,3 +129,68 @@ BOOST_AUTO_TEST_CASE( readValueToken_basic_validity_tests ) {
     BOOST_CHECK_EQUAL( "123*456", Opm::readValueToken<std::string>( std::string( "123*456" ) ) );
     BOOST_CHECK_EQUAL( "123*456", Opm::readValueToken<std::string>( std::string( "'123*456'" ) ) );
 }
+
+BOOST_AUTO_TEST_CASE( readValueToken_number_formats ) {
+    BOOST_CHECK_EQUAL( 1.5, Opm::readValueToken<double>( std::string( "1.5" ) ) );
+    BOOST_CHECK_EQUAL( 5, Opm::readValueToken<double>( std::string( "5." ) ) );
+    BOOST_CHECK_EQUAL( -0.25, Opm::readValueToken<double>( std::string( "-.25" ) ) );
+    BOOST_CHECK_EQUAL( 1.234e5, Opm::readValueToken<double>( std::string( "1.234d5" ) ) );
+    BOOST_CHECK_EQUAL( 1.234e-5, Opm::readValueToken<double>( std::string( "1.234D-05" ) ) );
+    BOOST_CHECK_EQUAL( 1e30, Opm::readValueToken<double>( std::string( "1E+30" ) ) );
+    BOOST_CHECK_EQUAL( 0.1234567890123456789,
+                       Opm::readValueToken<double>( std::string( "0.1234567890123456789" ) ) );
+    BOOST_CHECK_EQUAL( 123456789012345678901234.0,
+                       Opm::readValueToken<double>( std::string( "123456789012345678901234" ) ) );
+    BOOST_CHECK_EQUAL( 4.9406564584124654e-324,
+                       Opm::readValueToken<double>( std::string( "4.9406564584124654E-324" ) ) );
+    BOOST_CHECK( std::isinf( Opm::readValueToken<double>( std::string( "-INF" ) ) ) );
+    BOOST_CHECK( std::isnan( Opm::readValueToken<double>( std::string( "nan" ) ) ) );
+
+    BOOST_CHECK_THROW( Opm::readValueToken<double>( std::string( "" ) ), std::invalid_argument );
+    BOOST_CHECK_THROW( Opm::readValueToken<double>( std::string( "." ) ), std::invalid_argument );
+    BOOST_CHECK_THROW( Opm::readValueToken<double>( std::string( "-" ) ), std::invalid_argument );
+    BOOST_CHECK_THROW( Opm::readValueToken<double>( std::string( "1e" ) ), std::invalid_argument );
+    BOOST_CHECK_THROW( Opm::readValueToken<double>( std::string( "1e+" ) ), std::invalid_argument );
+    BOOST_CHECK_THROW( Opm::readValueToken<double>( std::string( "2*3" ) ), std::invalid_argument );
+
+    BOOST_CHECK_EQUAL( std::numeric_limits< int >::max(),
+                       Opm::readValueToken<int>( std::string( "2147483647" ) ) );
+    BOOST_CHECK_EQUAL( std::numeric_limits< int >::min(),
+                       Opm::readValueToken<int>( std::string( "-2147483648" ) ) );
+    BOOST_CHECK_THROW( Opm::readValueToken<int>( std::string( "2147483648" ) ), std::invalid_argument );
+    BOOST_CHECK_THROW( Opm::readValueToken<int>( std::string( "" ) ), std::invalid_argument );
+    BOOST_CHECK_THROW( Opm::readValueToken<int>( std::string( "1e5" ) ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( readValueToken_double_round_trip ) {
+    std::mt19937_64 gen( 42 );
+    std::uniform_real_distribution< double > dist( -1e6, 1e6 );
+    char buffer[ 64 ];
+
+    for( int i = 0; i < 10000; ++i ) {
+        const double x = dist( gen ) * std::pow( 10.0, int( gen() % 40 ) - 20 );
+        std::snprintf( buffer, sizeof( buffer ), "%.17g", x );
+        BOOST_CHECK_EQUAL( x, Opm::readValueToken<double>( std::string( buffer ) ) );
+
+        std::snprintf( buffer, sizeof( buffer ), "%.6g", x );
+        BOOST_CHECK_EQUAL( std::strtod( buffer, nullptr ),
+                           Opm::readValueToken<double>( std::string( buffer ) ) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( readValueTokens_bulk ) {
+    const std::vector< std::string > tokens = { "1", "2.5", "3d1", "4*2", "5" };
+
+    std::vector< double > values = { 0 };
+    auto pos = Opm::readValueTokens( tokens.begin(), tokens.end(), values );
+    BOOST_CHECK( pos == tokens.begin() + 3 );
+    BOOST_CHECK_EQUAL( 4U, values.size() );
+    BOOST_CHECK_EQUAL( 0, values[ 0 ] );
+    BOOST_CHECK_EQUAL( 2.5, values[ 2 ] );
+    BOOST_CHECK_EQUAL( 30, values[ 3 ] );
+
+    std::vector< int > ints;
+    pos = Opm::readValueTokens( tokens.begin(), tokens.end(), ints );
+    BOOST_CHECK( pos == tokens.begin() + 1 );
+    BOOST_CHECK_EQUAL( 1U, ints.size() );
+}
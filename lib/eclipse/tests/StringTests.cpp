@@ -2,6 +2,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <opm/parser/eclipse/Utility/InternedString.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
@@ -156,3 +157,23 @@ BOOST_AUTO_TEST_CASE(plusOperator) {
     BOOST_CHECK_EQUAL( lhs + ws, lhs_view + ws );
     BOOST_CHECK_EQUAL( ws + rhs, ws + rhs_view );
 }
+
+BOOST_AUTO_TEST_CASE( interned_strings_are_shared ) {
+    const std::string src = "WCONHIST";
+    const InternedString first( src );
+    const InternedString second( "WCONHIST" );
+    const char* padded = "WCONHIST  ";
+    const InternedString third( string_view( padded, 8 ) );
+
+    BOOST_CHECK( first == second );
+    BOOST_CHECK( first == third );
+    BOOST_CHECK_EQUAL( &first.string(), &third.string() );
+    BOOST_CHECK_EQUAL( first, src );
+    BOOST_CHECK_EQUAL( "WCONHIST", second );
+
+    const InternedString other( "WCONPROD" );
+    BOOST_CHECK( first != other );
+    BOOST_CHECK( other != src );
+    BOOST_CHECK( InternedString().empty() );
+    BOOST_CHECK( InternedString() == InternedString( "" ) );
+}
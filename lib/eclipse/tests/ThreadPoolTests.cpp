@@ -0,0 +1,88 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define BOOST_TEST_MODULE ThreadPoolTests
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Utility/ThreadPool.hpp>
+
+using namespace Opm;
+
+BOOST_AUTO_TEST_CASE( submit_and_get ) {
+    ThreadPool pool( 3 );
+    BOOST_CHECK_EQUAL( 3U, pool.size() );
+
+    std::vector< std::future< int > > futures;
+    for( int i = 0; i < 1000; ++i )
+        futures.push_back( pool.submit( [i] { return i * i; } ) );
+
+    for( int i = 0; i < 1000; ++i ) {
+        pool.wait( futures[ i ] );
+        BOOST_CHECK_EQUAL( i * i, futures[ i ].get() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( exceptions_propagate ) {
+    ThreadPool pool( 2 );
+    auto fut = pool.submit( []() -> int { throw std::invalid_argument( "bad" ); } );
+    BOOST_CHECK_THROW( fut.get(), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( no_workers ) {
+    ThreadPool pool( 0 );
+    auto fut = pool.submit( [] { return 42; } );
+
+    pool.wait( fut );
+    BOOST_CHECK_EQUAL( 42, fut.get() );
+    BOOST_CHECK( !pool.run_one() );
+}
+
+BOOST_AUTO_TEST_CASE( nested_tasks ) {
+    ThreadPool pool( 2 );
+    std::atomic< int > count( 0 );
+
+    std::vector< std::future< void > > outer;
+    for( int i = 0; i < 16; ++i ) {
+        outer.push_back( pool.submit( [&pool, &count] {
+            std::vector< std::future< void > > inner;
+            for( int j = 0; j < 16; ++j )
+                inner.push_back( pool.submit( [&count] { ++count; } ) );
+
+            for( auto& f : inner ) pool.wait( f );
+        } ) );
+    }
+
+    for( auto& f : outer ) pool.wait( f );
+    BOOST_CHECK_EQUAL( 256, count.load() );
+}
+
+BOOST_AUTO_TEST_CASE( destructor_completes_tasks ) {
+    std::atomic< int > count( 0 );
+    {
+        ThreadPool pool( 2 );
+        for( int i = 0; i < 100; ++i )
+            pool.submit( [&count] { ++count; } );
+    }
+
+    BOOST_CHECK_EQUAL( 100, count.load() );
+}